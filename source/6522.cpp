@@ -225,6 +225,54 @@ void SY6522::Write(BYTE nReg, BYTE nValue)
 
 //-----------------------------------------------------------------------------
 
+void SY6522::UpdateCycles(const UINT64 cumulativeCycle)
+{
+	if (cumulativeCycle <= m_lastCumulativeCycle)
+	{
+		m_lastCumulativeCycle = cumulativeCycle;	// NB. cycles can go backwards (eg. loading a save-state)
+		return;
+	}
+
+	UINT64 clocks1 = cumulativeCycle - m_lastCumulativeCycle;
+	UINT64 clocks2 = clocks1;
+	m_lastCumulativeCycle = cumulativeCycle;
+
+	// After a long time without being accessed (eg. an idle Mockingboard) skip whole timer periods:
+	// . once a counter has underflowed, it just repeats every period - and a counter has always underflowed after 0x10000 cycles
+	const UINT64 kMinClocks = 2 * 0x10000;
+	if (clocks1 > kMinClocks)
+	{
+		const UINT64 skip = clocks1 - kMinClocks;
+		clocks1 -= skip - (skip % GetTimer1Period());
+		clocks2 -= skip - (skip % 0x10000);			// TIMER2 has no latch, so just wraps
+	}
+
+	// Update in small steps, as if done every execution period (NB. OnTimer1Underflow() needs the underflow to be < 0x8000 cycles)
+	const UINT64 kMaxClocksPerUpdate = 0x1000;
+
+	while (clocks1)
+	{
+		const USHORT clocks = (USHORT) std::min<UINT64>(clocks1, kMaxClocksPerUpdate);
+		UpdateTimer1(clocks);
+		clocks1 -= clocks;
+	}
+
+	while (clocks2)
+	{
+		const USHORT clocks = (USHORT) std::min<UINT64>(clocks2, kMaxClocksPerUpdate);
+		UpdateTimer2(clocks);
+		clocks2 -= clocks;
+	}
+}
+
+UINT SY6522::GetTimer1Period() const
+{
+	if (m_isMegaAudio)
+		return (m_regs.TIMER1_LATCH.w ? m_regs.TIMER1_LATCH.w : 0xFFFF) + kExtraMegaAudioTimerCycles;	// MegaAudio && T1.LATCH=0: use 0xFFFF
+
+	return m_regs.TIMER1_LATCH.w + kExtraTimerCycles;
+}
+
 void SY6522::UpdateTimer1(USHORT clocks)
 {
 	if (CheckTimerUnderflow(m_regs.TIMER1_COUNTER.w, m_timer1IrqDelay, clocks))
@@ -633,6 +681,8 @@ UINT SY6522::GetOpcodeCycles(BYTE reg, UINT zpOpcodeCycles, UINT opcodeCycles,
 
 void SY6522::SaveSnapshot(YamlSaveHelper& yamlSaveHelper)
 {
+	UpdateCycles(g_nCumulativeCycles);
+
 	YamlSaveHelper::Label label(yamlSaveHelper, "%s:\n", SS_YAML_KEY_SY6522);
 
 	yamlSaveHelper.SaveHexUint8(SS_YAML_KEY_SY6522_REG_ORB, m_regs.ORB);
@@ -3,7 +3,7 @@
 class SY6522
 {
 public:
-	SY6522(UINT slot, bool isMegaAudio) : m_slot(slot), m_isMegaAudio(isMegaAudio), m_isBusDriven(false), m_bad6522(false)
+	SY6522(UINT slot, bool isMegaAudio) : m_slot(slot), m_isMegaAudio(isMegaAudio), m_isBusDriven(false), m_bad6522(false), m_lastCumulativeCycle(0)
 	{
 		for (UINT i = 0; i < kNumTimersPer6522; i++)
 			m_syncEvent[i] = NULL;
@@ -35,8 +35,9 @@ public:
 
 	void UpdateIFR(BYTE clr_ifr, BYTE set_ifr = 0);
 
-	void UpdateTimer1(USHORT clocks);
-	void UpdateTimer2(USHORT clocks);
+	// The TIMER1/2 counters are only brought up-to-date on demand (ie. when accessed, or on an underflow's sync event)
+	void UpdateCycles(const UINT64 cumulativeCycle);
+	void SetCumulativeCycles(const UINT64 cumulativeCycle) { m_lastCumulativeCycle = cumulativeCycle; }
 
 	enum { rORB = 0, rORA, rDDRB, rDDRA, rT1CL, rT1CH, rT1LL, rT1LH, rT2CL, rT2CH, rSR, rACR, rPCR, rIFR, rIER, rORA_NO_HS, SIZE_6522_REGS };
 
@@ -87,6 +88,10 @@ public:
 private:
 	USHORT SetTimerSyncEvent(BYTE reg, USHORT timerLatch);
 
+	void UpdateTimer1(USHORT clocks);
+	void UpdateTimer2(USHORT clocks);
+	UINT GetTimer1Period() const;
+
 	USHORT GetTimer1Counter(BYTE reg);
 	USHORT GetTimer2Counter(BYTE reg);
 	bool IsTimer1Underflowed(BYTE reg);
@@ -154,6 +159,8 @@ private:
 	bool m_isMegaAudio;
 	bool m_isBusDriven;
 
+	UINT64 m_lastCumulativeCycle;	// TIMER1/2 counters are up-to-date at this cycle
+
 	static const UINT kExtraMegaAudioTimerCycles = kExtraTimerCycles + 1;
 
 	// For mb-audit
@@ -109,6 +109,7 @@ static int rstereopos, rchan1pos, rchan2pos, rchan3pos;
 
 // Statics:
 double AY8913::m_fCurrentCLK_AY8910 = 0.0;
+int AY8913::m_sampleRate_AY8910 = SPKR_SAMPLE_RATE;
 
 
 void AY8913::init()
@@ -212,7 +213,7 @@ void AY8913::sound_init( const char *device )
 
 //  sound_generator_freq =
 //    settings_current.sound_hifi ? HIFI_FREQ : settings_current.sound_freq;
-  sound_generator_freq = SPKR_SAMPLE_RATE;
+  sound_generator_freq = m_sampleRate_AY8910;	// [AppleWin] Set by the card (see MockingboardCard::GetAYSampleRate())
   sound_generator_framesiz = sound_generator_freq / (int)hz;
 
 #if 0
@@ -518,7 +519,7 @@ void AY8913::sound_ay_overlay()
   libspectrum_signed_word* pBuf3 = ppSoundBuffers[2];
 
 //  for( f = 0, ptr = sound_buf; f < sound_generator_framesiz; f++ ) {
-  for( f = 0; f < sound_generator_framesiz; f++ ) {
+  for( f = 0; f < sound_generator_framesiz; ) {
     /* update ay registers. All this sub-frame change stuff
      * is pretty hairy, but how else would you handle the
      * samples in Robocop? :-) It also clears up some other
@@ -569,17 +570,46 @@ void AY8913::sound_ay_overlay()
       }
     }
 
+    /* [AppleWin] The registers are now constant until the next change, so
+     * process the samples up to it as one segment.
+     */
+    int seg_end = sound_generator_framesiz;
+    if( changes_left && change_ptr->ofs < seg_end )
+      seg_end = ( change_ptr->ofs > f ) ? change_ptr->ofs : f + 1;
+
+    /* [AppleWin] Fast path: if no channel's output can change during the segment
+     * (eg. all muted, or volume-register sample playback) then just fill it,
+     * and advance the generators in bulk.
+     */
+    int chan_out[3];
+    if( sound_ay_get_constant_output( chan_out ) ) {
+      const int samples = seg_end - f;
+      std::fill_n( pBuf1, samples, (libspectrum_signed_word) chan_out[0] );
+      std::fill_n( pBuf2, samples, (libspectrum_signed_word) chan_out[1] );
+      std::fill_n( pBuf3, samples, (libspectrum_signed_word) chan_out[2] );
+      pBuf1 += samples;
+      pBuf2 += samples;
+      pBuf3 += samples;
+      sound_ay_skip( samples );
+      f = seg_end;
+      continue;
+    }
+
     /* the tone level if no enveloping is being used */
+    /* [AppleWin] constant for the segment */
+    int fixed_level[3];
     for( g = 0; g < 3; g++ )
-      tone_level[g] = ay_tone_levels[ sound_ay_registers[ 8 + g ] & 15 ];
+      fixed_level[g] = ay_tone_levels[ sound_ay_registers[ 8 + g ] & 15 ];
 
-    /* envelope */
     envshape = sound_ay_registers[13];
+    mixer = sound_ay_registers[7];
+
+    for( ; f < seg_end; f++ ) {
+    /* envelope */
     level = ay_tone_levels[ env_counter ];
 
     for( g = 0; g < 3; g++ )
-      if( sound_ay_registers[ 8 + g ] & 16 )
-	tone_level[g] = level;
+      tone_level[g] = ( sound_ay_registers[ 8 + g ] & 16 ) ? level : fixed_level[g];
 
     /* envelope output counter gets incr'd every 16 AY cycles.
      * Has to be a while, as this is sub-output-sample res.
@@ -593,41 +623,7 @@ void AY8913::sound_ay_overlay()
       while( ay_env_tick >= ay_env_period ) {
 	ay_env_tick -= ay_env_period;
 
-	/* do a 1/16th-of-period incr/decr if needed */
-	if( env_first ||
-	    ( ( envshape & AY_ENV_CONT ) && !( envshape & AY_ENV_HOLD ) ) ) {
-	  if( env_rev )
-	    env_counter -= ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
-	  else
-	    env_counter += ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
-	  if( env_counter < 0 )
-	    env_counter = 0;
-	  if( env_counter > 15 )
-	    env_counter = 15;
-	}
-
-	ay_env_internal_tick++;
-	while( ay_env_internal_tick >= 16 ) {
-	  ay_env_internal_tick -= 16;
-
-	  /* end of cycle */
-	  if( !( envshape & AY_ENV_CONT ) )
-	    env_counter = 0;
-	  else {
-	    if( envshape & AY_ENV_HOLD ) {
-	      if( env_first && ( envshape & AY_ENV_ALT ) )
-		env_counter = ( env_counter ? 0 : 15 );
-	    } else {
-	      /* non-hold */
-	      if( envshape & AY_ENV_ALT )
-		env_rev = !env_rev;
-	      else
-		env_counter = ( envshape & AY_ENV_ATTACK ) ? 0 : 15;
-	    }
-	  }
-
-	  env_first = 0;
-	}
+	sound_ay_env_step( envshape );
 
 	/* don't keep trying if period is zero */
 	if( !ay_env_period )
@@ -643,7 +639,6 @@ void AY8913::sound_ay_overlay()
     chan1 = tone_level[0];
     chan2 = tone_level[1];
     chan3 = tone_level[2];
-    mixer = sound_ay_registers[7];
 
     ay_tone_subcycles += ay_tick_incr;
     tone_count = ay_tone_subcycles >> ( 3 + 16 );
@@ -711,22 +706,177 @@ void AY8913::sound_ay_overlay()
     while( ay_noise_tick >= ay_noise_period ) {
       ay_noise_tick -= ay_noise_period;
 
-      if( ( rng & 1 ) ^ ( ( rng & 2 ) ? 1 : 0 ) )
-	noise_toggle = !noise_toggle;
-
-      /* rng is 17-bit shift reg, bit 0 is output.
-       * input is bit 0 xor bit 2.
-       */
-      rng |= ( ( rng & 1 ) ^ ( ( rng & 4 ) ? 1 : 0 ) ) ? 0x20000 : 0;
-      rng >>= 1;
+      sound_ay_noise_step();
 
       /* don't keep trying if period is zero */
       if( !ay_noise_period )
 	break;
     }
+    }
   }
 }
 
+/* [AppleWin] One envelope step (1/16th of an envelope period).
+ * (Split out of sound_ay_overlay(), to share with sound_ay_skip().)
+ */
+void AY8913::sound_ay_env_step( int envshape )
+{
+  /* do a 1/16th-of-period incr/decr if needed */
+  if( env_first ||
+      ( ( envshape & AY_ENV_CONT ) && !( envshape & AY_ENV_HOLD ) ) ) {
+    if( env_rev )
+      env_counter -= ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
+    else
+      env_counter += ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
+    if( env_counter < 0 )
+      env_counter = 0;
+    if( env_counter > 15 )
+      env_counter = 15;
+  }
+
+  ay_env_internal_tick++;
+  while( ay_env_internal_tick >= 16 ) {
+    ay_env_internal_tick -= 16;
+
+    /* end of cycle */
+    if( !( envshape & AY_ENV_CONT ) )
+      env_counter = 0;
+    else {
+      if( envshape & AY_ENV_HOLD ) {
+	if( env_first && ( envshape & AY_ENV_ALT ) )
+	  env_counter = ( env_counter ? 0 : 15 );
+      } else {
+	/* non-hold */
+	if( envshape & AY_ENV_ALT )
+	  env_rev = !env_rev;
+	else
+	  env_counter = ( envshape & AY_ENV_ATTACK ) ? 0 : 15;
+      }
+    }
+
+    env_first = 0;
+  }
+}
+
+/* [AppleWin] One step of the noise RNG/filter.
+ * (Split out of sound_ay_overlay(), to share with sound_ay_skip().)
+ */
+void AY8913::sound_ay_noise_step()
+{
+  if( ( rng & 1 ) ^ ( ( rng & 2 ) ? 1 : 0 ) )
+    noise_toggle = !noise_toggle;
+
+  /* rng is 17-bit shift reg, bit 0 is output.
+   * input is bit 0 xor bit 2.
+   */
+  rng |= ( ( rng & 1 ) ^ ( ( rng & 4 ) ? 1 : 0 ) ) ? 0x20000 : 0;
+  rng >>= 1;
+}
+
+/* [AppleWin] Is the envelope held, ie. its level won't change until reg 13 is written?
+ * - after the 1st cycle, for shapes that don't continue (level stays at 0) or that hold.
+ */
+bool AY8913::sound_ay_env_is_held()
+{
+  const int envshape = sound_ay_registers[13];
+  return !env_first && ( !( envshape & AY_ENV_CONT ) || ( envshape & AY_ENV_HOLD ) );
+}
+
+/* [AppleWin] If none of the 3 channels' outputs can change until the next register
+ * write, then return true & each channel's (constant) output.
+ * A channel's output is constant when its level is constant (fixed volume, or a held
+ * envelope) and either the level is 0, or both tone & noise are disabled (the chip
+ * outputs the level unmodified - used for volume-register sample playback).
+ */
+bool AY8913::sound_ay_get_constant_output( int chan_out[3] )
+{
+  const int mixer = sound_ay_registers[7];
+
+  for( int g = 0; g < 3; g++ ) {
+    int level;
+    if( sound_ay_registers[ 8 + g ] & 16 ) {
+      if( !sound_ay_env_is_held() )
+        return false;
+      level = ay_tone_levels[ env_counter ];
+    } else {
+      level = ay_tone_levels[ sound_ay_registers[ 8 + g ] & 15 ];
+    }
+
+    if( level && ( ( mixer >> g ) & 0x09 ) != 0x09 )	/* tone or noise enabled */
+      return false;
+
+    chan_out[g] = level;
+  }
+
+  return true;
+}
+
+/* [AppleWin] Advance the tone, envelope & noise generators by 'samples' output samples
+ * (with no register changes), to the same state as sound_ay_overlay()'s per-sample loop.
+ * The tone & envelope-tick counters are advanced arithmetically, and the envelope/noise
+ * steps are only iterated when they can change the state.
+ */
+void AY8913::sound_ay_skip( int samples )
+{
+  if( samples <= 0 )
+    return;
+
+  const int mixer = sound_ay_registers[7];
+  const int envshape = sound_ay_registers[13];
+
+  /* tone: only counts for channels with tone enabled (see AY_DO_TONE) */
+  const UINT64 tone_subcycles = ay_tone_subcycles + (UINT64) ay_tick_incr * samples;
+  const UINT64 tone_count = tone_subcycles >> ( 3 + 16 );
+  ay_tone_subcycles = (unsigned int) ( tone_subcycles & ( ( 8 << 16 ) - 1 ) );
+
+  for( int g = 0; g < 3; g++ ) {
+    if( mixer & ( 1 << g ) )
+      continue;
+
+    const UINT64 tick = ay_tone_tick[g] + tone_count;
+    if( ( tick / ay_tone_period[g] ) & 1 )
+      ay_tone_high[g] = !ay_tone_high[g];
+    ay_tone_tick[g] = (unsigned int) ( tick % ay_tone_period[g] );
+  }
+
+  /* envelope: incr'd every 16 AY cycles (this also clocks the noise) */
+  const UINT64 env_subcycles = ay_env_subcycles + (UINT64) ay_tick_incr * samples;
+  const unsigned int env_count = (unsigned int) ( env_subcycles / ( 16 << 16 ) );
+  ay_env_subcycles = (unsigned int) ( env_subcycles % ( 16 << 16 ) );
+
+  if( env_count ) {
+    unsigned int env_steps;
+    ay_env_tick += env_count;
+    if( ay_env_period ) {
+      env_steps = ay_env_tick / ay_env_period;
+      ay_env_tick %= ay_env_period;
+    } else {
+      env_steps = env_count;	/* one step per tick (see the 'break') */
+    }
+
+    if( sound_ay_env_is_held() ) {
+      /* only the internal tick changes */
+      ay_env_internal_tick = ( ay_env_internal_tick + env_steps ) % 16;
+    } else {
+      while( env_steps-- )
+        sound_ay_env_step( envshape );
+    }
+  }
+
+  /* noise */
+  unsigned int noise_steps;
+  ay_noise_tick += env_count;
+  if( ay_noise_period ) {
+    noise_steps = ay_noise_tick / ay_noise_period;
+    ay_noise_tick %= ay_noise_period;
+  } else {
+    noise_steps = samples;	/* one step per sample (see the 'break') */
+  }
+
+  while( noise_steps-- )
+    sound_ay_noise_step();
+}
+
 BYTE AY8913::sound_ay_read( int reg )
 {
 	reg &= 15;
@@ -31,6 +31,7 @@ public:
 	void SetFramesize(int frameSize) { sound_generator_framesiz = frameSize; }
 	void SetSoundBuffers(INT16** buffers) { ppSoundBuffers = buffers; }
 	static void SetCLK( double CLK ) { m_fCurrentCLK_AY8910 = CLK; }
+	static void SetSampleRate( int sampleRate ) { m_sampleRate_AY8910 = sampleRate; }
 	void SetType(AY891xType type) { m_type = type; }
 	std::string Type2String();
 	AY891xType String2Type(std::string type);
@@ -41,6 +42,11 @@ private:
 	void init();
 	void sound_end();
 	void sound_ay_overlay();
+	void sound_ay_env_step(int envshape);
+	void sound_ay_noise_step();
+	bool sound_ay_env_is_held();
+	bool sound_ay_get_constant_output(int chan_out[3]);
+	void sound_ay_skip(int samples);
 
 private:
 	/* foo_subcycles are fixed-point with low 16 bits as fractional part.
@@ -81,4 +87,5 @@ private:
 
 	// Vars shared between all AY's
 	static double m_fCurrentCLK_AY8910;
+	static int m_sampleRate_AY8910;
 };
@@ -0,0 +1,439 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Lock-free (SPSC) audio ring buffers, and a platform-neutral mixer/backend
+ *
+ * Each ring has monotonic byte positions (so full and empty are never ambiguous):
+ * . m_playPos:      only written by the consumer, as it mixes
+ * . m_writtenStart: only written by the producer, in Unlock()
+ * . m_writtenEnd:   only written by the producer, in Unlock()
+ * Only [m_writtenStart, m_writtenEnd) is valid sample data; the consumer plays silence outside of it, ie. after an underrun,
+ * the gap before where the producer resumed writing is silent (rather than replaying the samples from one ring earlier).
+ *
+ * The list of rings is protected by a critical section, but that's only taken when a voice is
+ * created or destroyed, and by the consumer as it mixes - never by the emulator's Lock()/Unlock().
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include <atomic>
+
+#include "AudioRing.h"
+#include "Log.h"
+#include "Riff.h"
+
+namespace
+{
+	const UINT kPeriodMs = 10;	// Consumer's mixing period (null & wav-file backends)
+
+	class AudioRingBuffer : public SoundBuffer
+	{
+	public:
+		AudioRingBuffer(uint32_t dwBufferSize, uint32_t nSampleRate, int nChannels);
+		virtual ~AudioRingBuffer();
+
+		virtual HRESULT SetCurrentPosition(DWORD dwNewPosition);
+		virtual HRESULT GetCurrentPosition(LPDWORD lpdwCurrentPlayCursor, LPDWORD lpdwCurrentWriteCursor);
+
+		virtual HRESULT Lock(DWORD dwWriteCursor, DWORD dwWriteBytes, LPVOID* lplpvAudioPtr1, DWORD* lpdwAudioBytes1, LPVOID* lplpvAudioPtr2, DWORD* lpdwAudioBytes2, DWORD dwFlags);
+		virtual HRESULT Unlock(LPVOID lpvAudioPtr1, DWORD dwAudioBytes1, LPVOID lpvAudioPtr2, DWORD dwAudioBytes2);
+
+		virtual HRESULT Stop();
+		virtual HRESULT Play(DWORD dwReserved1, DWORD dwReserved2, DWORD dwFlags);
+
+		virtual HRESULT SetVolume(LONG lVolume);
+		virtual HRESULT GetVolume(LONG* lplVolume);
+
+		virtual HRESULT GetStatus(LPDWORD lpdwStatus);
+		virtual HRESULT Restore();
+
+		// Consumer only
+		void MixInto(int* pMix, UINT numFrames);
+
+	private:
+		const uint32_t m_bufferSize;	// In bytes
+		const UINT m_sampleRate;
+		const UINT m_numChannels;
+		const UINT m_frameSize;			// In bytes
+		const uint32_t m_guardSize;		// Write cursor's lead over the play cursor (in bytes)
+		std::vector<short> m_data;
+
+		std::atomic<UINT64> m_playPos;
+		std::atomic<UINT64> m_writtenStart;	// Start of the contiguous written region that ends at m_writtenEnd
+		std::atomic<UINT64> m_writtenEnd;
+		std::atomic<bool> m_playing;
+		std::atomic<LONG> m_volume;
+
+		double m_srcFraction;			// Consumer's fractional position between this ring's frames
+	};
+
+	CRITICAL_SECTION g_csRings;
+	bool g_bCriticalSectionInit = false;
+	std::vector<AudioRingBuffer*> g_rings;
+	std::vector<int> g_mix;
+
+	AudioRingBackend g_backend = AUDIO_RING_NONE;
+	HANDLE g_hBackendThread = NULL;
+	std::atomic<bool> g_bStopBackend(false);
+
+	FILE* g_hWavFile = NULL;
+	UINT64 g_wavFramesWritten = 0;
+}
+
+//===========================================================================
+
+AudioRingBuffer::AudioRingBuffer(uint32_t dwBufferSize, uint32_t nSampleRate, int nChannels)
+	: m_bufferSize(dwBufferSize)
+	, m_sampleRate(nSampleRate)
+	, m_numChannels(nChannels)
+	, m_frameSize(nChannels * sizeof(short))
+	, m_guardSize(std::min<uint32_t>(((nSampleRate * kPeriodMs) / 1000) * nChannels * sizeof(short), dwBufferSize / 4))
+	, m_data(dwBufferSize / sizeof(short), 0)
+	, m_playPos(0)
+	, m_writtenStart(0)
+	, m_writtenEnd(0)
+	, m_playing(false)
+	, m_volume(DSBVOLUME_MAX)
+	, m_srcFraction(0.0)
+{
+	_ASSERT(dwBufferSize % m_frameSize == 0);
+
+	EnterCriticalSection(&g_csRings);
+	g_rings.push_back(this);
+	LeaveCriticalSection(&g_csRings);
+}
+
+AudioRingBuffer::~AudioRingBuffer()
+{
+	// Waits for the consumer to finish any mix that uses this ring
+	EnterCriticalSection(&g_csRings);
+	g_rings.erase(std::remove(g_rings.begin(), g_rings.end(), this), g_rings.end());
+	LeaveCriticalSection(&g_csRings);
+}
+
+// NB. Like DirectSound, only expected to be called when stopped (otherwise it races with the consumer)
+HRESULT AudioRingBuffer::SetCurrentPosition(DWORD dwNewPosition)
+{
+	const UINT64 playPos = m_playPos.load(std::memory_order_acquire);
+	const UINT64 newPlayPos = playPos - (playPos % m_bufferSize) + (dwNewPosition % m_bufferSize);
+	m_playPos.store(newPlayPos, std::memory_order_release);
+	m_writtenStart.store(newPlayPos, std::memory_order_release);
+	m_writtenEnd.store(newPlayPos, std::memory_order_release);
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::GetCurrentPosition(LPDWORD lpdwCurrentPlayCursor, LPDWORD lpdwCurrentWriteCursor)
+{
+	const UINT64 playPos = m_playPos.load(std::memory_order_acquire);
+
+	if (lpdwCurrentPlayCursor)
+		*lpdwCurrentPlayCursor = (DWORD)(playPos % m_bufferSize);
+	if (lpdwCurrentWriteCursor)
+		*lpdwCurrentWriteCursor = (DWORD)((playPos + m_guardSize) % m_bufferSize);
+
+	return DS_OK;
+}
+
+// No copy: the pointers are directly into the ring (split in two if the region wraps)
+HRESULT AudioRingBuffer::Lock(DWORD dwWriteCursor, DWORD dwWriteBytes, LPVOID* lplpvAudioPtr1, DWORD* lpdwAudioBytes1, LPVOID* lplpvAudioPtr2, DWORD* lpdwAudioBytes2, DWORD dwFlags)
+{
+	if (dwFlags & DSBLOCK_ENTIREBUFFER)
+	{
+		dwWriteCursor = 0;
+		dwWriteBytes = m_bufferSize;
+	}
+
+	if (dwWriteCursor >= m_bufferSize || dwWriteBytes > m_bufferSize || !lplpvAudioPtr1 || !lpdwAudioBytes1)
+		return DSERR_INVALIDPARAM;
+
+	BYTE* pData = (BYTE*)&m_data[0];
+	const DWORD dwBytes1 = std::min<DWORD>(dwWriteBytes, m_bufferSize - dwWriteCursor);
+
+	*lplpvAudioPtr1 = pData + dwWriteCursor;
+	*lpdwAudioBytes1 = dwBytes1;
+
+	if (lplpvAudioPtr2)
+		*lplpvAudioPtr2 = (dwWriteBytes > dwBytes1) ? pData : NULL;
+	if (lpdwAudioBytes2)
+		*lpdwAudioBytes2 = dwWriteBytes - dwBytes1;
+
+	return DS_OK;
+}
+
+// Publish the written region to the consumer
+HRESULT AudioRingBuffer::Unlock(LPVOID lpvAudioPtr1, DWORD dwAudioBytes1, LPVOID lpvAudioPtr2, DWORD dwAudioBytes2)
+{
+	if (!lpvAudioPtr1)
+		return DSERR_INVALIDPARAM;
+
+	const DWORD dwOffset = (DWORD)((BYTE*)lpvAudioPtr1 - (BYTE*)&m_data[0]);
+	const DWORD dwBytes = dwAudioBytes1 + (lpvAudioPtr2 ? dwAudioBytes2 : 0);
+
+	// Convert the ring offset to an absolute position, relative to the current play position
+	const UINT64 playPos = m_playPos.load(std::memory_order_acquire);
+	const UINT64 start = playPos + ((dwOffset + m_bufferSize - (DWORD)(playPos % m_bufferSize)) % m_bufferSize);
+
+	// Regions can be unlocked out of order (eg. an earlier Lock() unlocked after a later one), so never move m_writtenEnd backwards
+	// . NB. only the producer writes m_writtenStart & m_writtenEnd, so there's no race between these loads & stores
+	// . m_writtenStart is stored before m_writtenEnd: so a consumer that sees the new end also sees the new start
+	//   (and one that sees the new start with the old end just plays silence for this mix)
+	const UINT64 end = start + dwBytes;
+	const UINT64 writtenStart = m_writtenStart.load(std::memory_order_relaxed);
+	const UINT64 writtenEnd = m_writtenEnd.load(std::memory_order_relaxed);
+
+	if (start > writtenEnd)
+	{
+		m_writtenStart.store(start, std::memory_order_release);		// a gap (eg. after an underrun): it isn't valid data
+		m_writtenEnd.store(end, std::memory_order_release);
+	}
+	else
+	{
+		if (start < writtenStart && end >= writtenStart)
+			m_writtenStart.store(start, std::memory_order_release);	// an earlier region that joins up
+		if (end > writtenEnd)
+			m_writtenEnd.store(end, std::memory_order_release);
+	}
+
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::Stop()
+{
+	m_playing.store(false);
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::Play(DWORD dwReserved1, DWORD dwReserved2, DWORD dwFlags)
+{
+	m_playing.store(true);
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::SetVolume(LONG lVolume)
+{
+	m_volume.store(lVolume);
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::GetVolume(LONG* lplVolume)
+{
+	if (!lplVolume)
+		return DSERR_INVALIDPARAM;
+
+	*lplVolume = m_volume.load();
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::GetStatus(LPDWORD lpdwStatus)
+{
+	if (!lpdwStatus)
+		return DSERR_INVALIDPARAM;
+
+	*lpdwStatus = m_playing.load() ? (DSBSTATUS_PLAYING | DSBSTATUS_LOOPING) : 0;
+	return DS_OK;
+}
+
+HRESULT AudioRingBuffer::Restore()
+{
+	return DS_OK;	// Memory can't be lost
+}
+
+// Add this ring's next numFrames (converted to AUDIO_RING_SAMPLE_RATE stereo) to pMix, and advance the play position
+void AudioRingBuffer::MixInto(int* pMix, UINT numFrames)
+{
+	if (!m_playing.load())
+		return;
+
+	// Volume is in hundredths of a dB of attenuation
+	const LONG volume = m_volume.load();
+	const double gain = (volume <= DSBVOLUME_MIN) ? 0.0 : pow(10.0, (double)volume / 2000.0);
+
+	const UINT64 writtenEnd = m_writtenEnd.load(std::memory_order_acquire);
+	const UINT64 writtenStart = m_writtenStart.load(std::memory_order_acquire);
+	UINT64 playPos = m_playPos.load(std::memory_order_relaxed);
+	const double step = (double)m_sampleRate / (double)AUDIO_RING_SAMPLE_RATE;
+
+	for (UINT i = 0; i < numFrames; i++)
+	{
+		// Silence if this frame hasn't been written yet, was skipped by the producer (ie. it's stale), or was overwritten (ie. it's more than a ring behind)
+		if (playPos >= writtenStart && playPos + m_frameSize <= writtenEnd && writtenEnd - playPos <= m_bufferSize)
+		{
+			const short* pFrame = &m_data[(playPos % m_bufferSize) / sizeof(short)];
+			const short left = pFrame[0];
+			const short right = (m_numChannels > 1) ? pFrame[1] : left;
+			pMix[i * 2 + 0] += (int)(left * gain);
+			pMix[i * 2 + 1] += (int)(right * gain);
+		}
+
+		m_srcFraction += step;
+		while (m_srcFraction >= 1.0)
+		{
+			m_srcFraction -= 1.0;
+			playPos += m_frameSize;
+		}
+	}
+
+	m_playPos.store(playPos, std::memory_order_release);
+}
+
+//===========================================================================
+
+void AudioRing_Mix(short* pOut, UINT numFrames)
+{
+	g_mix.assign(numFrames * AUDIO_RING_NUM_CHANNELS, 0);
+
+	EnterCriticalSection(&g_csRings);
+	for (UINT i = 0; i < g_rings.size(); i++)
+		g_rings[i]->MixInto(&g_mix[0], numFrames);
+	LeaveCriticalSection(&g_csRings);
+
+	for (UINT i = 0; i < numFrames * AUDIO_RING_NUM_CHANNELS; i++)
+	{
+		int sample = g_mix[i];
+		if (sample > SHRT_MAX)
+			sample = SHRT_MAX;
+		else if (sample < SHRT_MIN)
+			sample = SHRT_MIN;
+		pOut[i] = (short)sample;
+	}
+}
+
+//---------------------------------------------------------------------------
+
+// Null & wav-file backends: consume in real-time, paced by the performance counter
+static DWORD WINAPI AudioRing_BackendThread(LPVOID lpParameter)
+{
+	LARGE_INTEGER freq, start, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&start);
+
+	UINT64 framesDone = 0;
+	std::vector<short> buffer;
+
+	while (!g_bStopBackend.load())
+	{
+		Sleep(kPeriodMs);
+
+		QueryPerformanceCounter(&now);
+		const UINT64 framesDue = (UINT64)(now.QuadPart - start.QuadPart) * AUDIO_RING_SAMPLE_RATE / (UINT64)freq.QuadPart;
+
+		// If this thread was starved for over 1s, then just skip the lost time
+		const UINT numFrames = (UINT)std::min<UINT64>(framesDue - framesDone, AUDIO_RING_SAMPLE_RATE);
+		framesDone = framesDue;
+		if (!numFrames)
+			continue;
+
+		buffer.resize(numFrames * AUDIO_RING_NUM_CHANNELS);
+		AudioRing_Mix(&buffer[0], numFrames);
+
+		if (g_hWavFile)
+		{
+			fwrite(&buffer[0], sizeof(short) * AUDIO_RING_NUM_CHANNELS, numFrames, g_hWavFile);
+			g_wavFramesWritten += numFrames;
+		}
+	}
+
+	return 0;
+}
+
+//===========================================================================
+
+bool AudioRing_Init(AudioRingBackend backend, const std::string& strWavFilename)
+{
+	if (backend == AUDIO_RING_NONE || g_backend != AUDIO_RING_NONE)
+		return false;
+
+	// Never deleted, as voices may outlive the backend
+	if (!g_bCriticalSectionInit)
+	{
+		InitializeCriticalSection(&g_csRings);
+		g_bCriticalSectionInit = true;
+	}
+
+	if (backend == AUDIO_RING_WAV_FILE)
+	{
+		g_hWavFile = fopen(strWavFilename.c_str(), "wb");
+		if (!g_hWavFile)
+		{
+			LogFileOutput("AudioRing_Init: Failed to open wav file: %s\n", strWavFilename.c_str());
+			return false;
+		}
+
+		g_wavFramesWritten = 0;
+		RiffWriteHeader(g_hWavFile, AUDIO_RING_SAMPLE_RATE, AUDIO_RING_NUM_CHANNELS, 0);
+	}
+
+	g_backend = backend;
+	g_bStopBackend.store(false);
+
+	DWORD dwThreadId;
+	g_hBackendThread = CreateThread(NULL, 0, AudioRing_BackendThread, NULL, 0, &dwThreadId);
+	if (!g_hBackendThread)
+	{
+		LogFileOutput("AudioRing_Init: Failed to create backend thread\n");
+		AudioRing_Uninit();
+		return false;
+	}
+
+	return true;
+}
+
+void AudioRing_Uninit()
+{
+	if (g_backend == AUDIO_RING_NONE)
+		return;
+
+	if (g_hBackendThread)
+	{
+		g_bStopBackend.store(true);
+		WaitForSingleObject(g_hBackendThread, INFINITE);
+		CloseHandle(g_hBackendThread);
+		g_hBackendThread = NULL;
+	}
+
+	if (g_hWavFile)
+	{
+		RiffWriteHeader(g_hWavFile, AUDIO_RING_SAMPLE_RATE, AUDIO_RING_NUM_CHANNELS, g_wavFramesWritten);
+		fclose(g_hWavFile);
+		g_hWavFile = NULL;
+	}
+
+	g_backend = AUDIO_RING_NONE;
+}
+
+bool AudioRing_IsEnabled()
+{
+	return g_backend != AUDIO_RING_NONE;
+}
+
+std::shared_ptr<SoundBuffer> AudioRing_CreateSoundBuffer(uint32_t dwBufferSize, uint32_t nSampleRate, int nChannels, const char* pszVoiceName)
+{
+	_ASSERT(AudioRing_IsEnabled());
+	if (!AudioRing_IsEnabled() || !dwBufferSize || !nSampleRate || (nChannels != 1 && nChannels != 2))
+		return NULL;
+
+	LogFileOutput("AudioRing_CreateSoundBuffer: %s (%u bytes, %u Hz, %d channel(s))\n", pszVoiceName, dwBufferSize, nSampleRate, nChannels);
+	return std::make_shared<AudioRingBuffer>(dwBufferSize, nSampleRate, nChannels);
+}
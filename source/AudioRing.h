@@ -0,0 +1,28 @@
+#pragma once
+
+#include "SoundBuffer.h"
+
+// Platform-neutral audio output (see command line: -audio-null, -audio-wav <file.wav>)
+// . Each voice (speaker, Mockingboard, SSI263, ...) gets a ring buffer instead of a platform (eg. DirectSound) buffer.
+//   It has the same cursor-based SoundBuffer interface, so the voices' fill-level logic is unchanged.
+// . The emulator is the single producer: Lock()/Unlock()/GetCurrentPosition() are lock-free and never block.
+// . The backend is the single consumer: it mixes all the voices at AUDIO_RING_SAMPLE_RATE, from its own thread
+//   (see AudioRing_Mix()).
+
+enum AudioRingBackend
+{
+	AUDIO_RING_NONE,		// Use the platform's sound buffers
+	AUDIO_RING_NULL,		// Mix in real-time, then discard (eg. for headless runs)
+	AUDIO_RING_WAV_FILE,	// Mix in real-time to a .wav file
+};
+
+const UINT AUDIO_RING_SAMPLE_RATE = 44100;
+const UINT AUDIO_RING_NUM_CHANNELS = 2;
+
+bool AudioRing_Init(AudioRingBackend backend, const std::string& strWavFilename);
+void AudioRing_Uninit();
+bool AudioRing_IsEnabled();
+std::shared_ptr<SoundBuffer> AudioRing_CreateSoundBuffer(uint32_t dwBufferSize, uint32_t nSampleRate, int nChannels, const char* pszVoiceName);
+
+// Mix all the voices into interleaved stereo frames (only call from the consumer)
+void AudioRing_Mix(short* pOut, UINT numFrames);
@@ -134,6 +134,17 @@ static volatile UINT32 g_bmIRQ = 0;
 static volatile UINT32 g_bmNMI = 0;
 static volatile bool g_bNmiFlank = false; // Positive going flank on NMI line
 
+// Anything that the CPU loop must check before fetching the next opcode
+// . so that when there's nothing to do (the usual case), it's just a single test per opcode
+enum
+{
+	CPU_ATTENTION_IRQ = 1<<0,				// g_bmIRQ != 0
+	CPU_ATTENTION_NMI = 1<<1,				// g_bNmiFlank
+	CPU_ATTENTION_Z80 = 1<<2,				// g_ActiveCPU == CPU_Z80
+	CPU_ATTENTION_IRQ_LAST_CYCLE = 1<<3,	// g_irqOnLastOpcodeCycle (IRQ() must see it to clear it)
+};
+static volatile UINT32 g_bmCpuAttention = 0;	// Also guarded by g_CriticalSection (NB. IRQs can be asserted by other threads)
+
 static bool g_irqDefer1Opcode = false;
 static bool g_interruptInLastExecutionBatch = false;	// Last batch of executed cycles included an interrupt (IRQ/NMI)
 
@@ -175,6 +186,16 @@ void SetMainCpuDefault(eApple2Type apple2Type)
 	SetMainCpu( ProbeMainCpuDefault(apple2Type) );
 }
 
+static void SetCpuAttention(UINT32 attention, bool set)
+{
+	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
+	if (set)
+		g_bmCpuAttention |= attention;
+	else
+		g_bmCpuAttention &= ~attention;
+	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
+}
+
 eCpuType GetActiveCpu()
 {
 	return g_ActiveCPU;
@@ -183,6 +204,7 @@ eCpuType GetActiveCpu()
 void SetActiveCpu(eCpuType cpu)
 {
 	g_ActiveCPU = cpu;
+	SetCpuAttention(CPU_ATTENTION_Z80, cpu == CPU_Z80);
 }
 
 bool IsIrqAsserted()
@@ -208,7 +230,10 @@ bool IsInterruptInLastExecution()
 void SetIrqOnLastOpcodeCycle()
 {
 	if (!(regs.ps & AF_INTERRUPT))
+	{
 		g_irqOnLastOpcodeCycle = true;
+		SetCpuAttention(CPU_ATTENTION_IRQ_LAST_CYCLE, true);
+	}
 }
 
 //
@@ -406,6 +431,7 @@ static __forceinline bool NMI(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 
 	// NMI signals are only serviced once
 	g_bNmiFlank = false;
+	SetCpuAttention(CPU_ATTENTION_NMI, false);
 #ifdef _DEBUG
 	g_nCycleIrqStart = g_nCumulativeCycles + uExecutedCycles;
 #endif
@@ -455,6 +481,7 @@ static __forceinline bool IRQ(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 		if (g_irqOnLastOpcodeCycle && !g_irqDefer1Opcode)
 		{
 			g_irqOnLastOpcodeCycle = false;
+			SetCpuAttention(CPU_ATTENTION_IRQ_LAST_CYCLE, false);
 			g_irqDefer1Opcode = true;	// if INT occurs again on next opcode, then do NOT defer
 			return false;
 		}
@@ -502,7 +529,12 @@ static __forceinline bool IRQ(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 		irqTaken = true;
 	}
 
-	g_irqOnLastOpcodeCycle = false;
+	if (g_irqOnLastOpcodeCycle)
+	{
+		g_irqOnLastOpcodeCycle = false;
+		SetCpuAttention(CPU_ATTENTION_IRQ_LAST_CYCLE, false);
+	}
+
 	return irqTaken;
 }
 
@@ -728,19 +760,13 @@ uint32_t CpuExecute(const uint32_t uCycles, const bool bVideoUpdate)
 	g_nCyclesExecuted =	0;
 	g_interruptInLastExecutionBatch = false;
 
-#ifdef _DEBUG
-	GetCardMgr().GetMockingboardCardMgr().CheckCumulativeCycles();
-#endif
-
 	// uCycles:
 	//  =0  : Do single step
 	//  >0  : Do multi-opcode emulation
 	const uint32_t uExecutedCycles = InternalCpuExecute(uCycles, bVideoUpdate);
 
-	// Update 6522s (NB. Do this before updating g_nCumulativeCycles below)
-	// . Ensures that 6522 regs are up-to-date for any potential save-state
+	// NB. 6522s are not updated here: their counters are only brought up-to-date when accessed (including save-state)
 	// . SyncEvent will trigger the 6522 TIMER1/2 underflow on the correct cycle
-	GetCardMgr().GetMockingboardCardMgr().UpdateCycles(uExecutedCycles);
 
 	const UINT nRemainingCycles = uExecutedCycles - g_nCyclesExecuted;
 	g_nCumulativeCycles	+= nRemainingCycles;
@@ -860,6 +886,7 @@ void CpuIrqReset()
 	_ASSERT(g_bCritSectionValid);
 	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
 	g_bmIRQ = 0;
+	g_bmCpuAttention &= ~CPU_ATTENTION_IRQ;
 	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
 }
 
@@ -868,6 +895,7 @@ void CpuIrqAssert(eIRQSRC Device)
 	_ASSERT(g_bCritSectionValid);
 	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
 	g_bmIRQ |= 1<<Device;
+	g_bmCpuAttention |= CPU_ATTENTION_IRQ;
 	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
 }
 
@@ -876,6 +904,8 @@ void CpuIrqDeassert(eIRQSRC Device)
 	_ASSERT(g_bCritSectionValid);
 	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
 	g_bmIRQ &= ~(1<<Device);
+	if (g_bmIRQ == 0)
+		g_bmCpuAttention &= ~CPU_ATTENTION_IRQ;
 	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
 }
 
@@ -887,6 +917,7 @@ void CpuNmiReset()
 	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
 	g_bmNMI = 0;
 	g_bNmiFlank = false;
+	g_bmCpuAttention &= ~CPU_ATTENTION_NMI;
 	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
 }
 
@@ -895,7 +926,12 @@ void CpuNmiAssert(eIRQSRC Device)
 	_ASSERT(g_bCritSectionValid);
 	if (g_bCritSectionValid) EnterCriticalSection(&g_CriticalSection);
 	if (g_bmNMI == 0) // NMI line is just becoming active
+	{
 	    g_bNmiFlank = true;
+#ifdef ENABLE_NMI_SUPPORT
+		g_bmCpuAttention |= CPU_ATTENTION_NMI;	// NB. otherwise NMI() never clears it
+#endif
+	}
 	g_bmNMI |= 1<<Device;
 	if (g_bCritSectionValid) LeaveCriticalSection(&g_CriticalSection);
 }
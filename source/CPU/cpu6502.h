@@ -101,11 +101,13 @@ static uint32_t Cpu6502(uint32_t uTotalCycles, const bool bVideoUpdate)
 		ULONG uPreviousCycles = uExecutedCycles;
 // NTSC_END
 
-		if (GetActiveCpu() == CPU_Z80)
+		const UINT32 attention = g_bmCpuAttention;	// Usually 0: then just fetch & execute the next opcode
+
+		if (attention && GetActiveCpu() == CPU_Z80)
 		{
 			const UINT uZ80Cycles = z80_mainloop(uTotalCycles, uExecutedCycles); CYC(uZ80Cycles)
 		}
-		else if (NMI(uExecutedCycles, flagc, flagn, flagv, flagz) || IRQ(uExecutedCycles, flagc, flagn, flagv, flagz))
+		else if (attention && (NMI(uExecutedCycles, flagc, flagn, flagv, flagz) || IRQ(uExecutedCycles, flagc, flagn, flagv, flagz)))
 		{
 			// Allow AppleWin debugger's single-stepping to just step the pending IRQ
 		}
@@ -0,0 +1,431 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Asynchronous audio/video capture
+ *
+ * Emulation thread:
+ * . Each voice's samples are mixed (at its own position) into a pending audio buffer.
+ * . Per video frame: the framebuffer is copied into a packet, and the audio that all voices have
+ *   reached is flushed into another packet. Both are queued for the writer thread.
+ * Writer thread:
+ * . Compresses the frames, and writes the .frames/.idx/.wav files.
+ *
+ * Packets are recycled, so once running there are no allocations on the emulation thread.
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "Capture.h"
+#include "Common.h"
+#include "Core.h"
+#include "CPU.h"
+#include "Interface.h"
+#include "Log.h"
+#include "Riff.h"
+
+#include "zlib.h"
+
+namespace
+{
+	const UINT kMaxQueuedVideoPackets = 30;		// ~0.5s: beyond this, frames are dropped
+	const UINT kMaxAudioLag = CAPTURE_SAMPLE_RATE;	// A voice that's more than 1s behind the others is treated as silent
+
+	enum PacketType { PACKET_VIDEO, PACKET_AUDIO };
+
+	struct Packet
+	{
+		PacketType type;
+		UINT64 cycle;
+		UINT numDroppedBefore;		// Video: number of frames dropped since the previous packet
+		std::vector<BYTE> data;
+	};
+
+	CRITICAL_SECTION g_csQueue;
+	std::deque<Packet*> g_queue;
+	std::vector<Packet*> g_freePackets;
+	UINT g_numQueuedVideoPackets = 0;
+	UINT g_numDroppedFrames = 0;		// Pending, for the next video packet
+	UINT g_numDroppedFramesTotal = 0;
+	bool g_bStopWriter = false;
+	HANDLE g_hQueueEvent = NULL;
+	HANDLE g_hWriterThread = NULL;
+
+	bool g_bActive = false;
+	UINT g_frameWidth = 0;
+	UINT g_frameHeight = 0;
+
+	// Emulation thread's audio mix
+	std::vector<int> g_audioMix;		// Interleaved stereo, from g_audioFlushedPos onwards
+	UINT64 g_audioFlushedPos = 0;		// In frames
+	UINT64 g_voicePos[NUM_CAPTURE_VOICES];
+	bool g_voiceActive[NUM_CAPTURE_VOICES];
+
+	// Writer thread's files
+	FILE* g_hFramesFile = NULL;
+	FILE* g_hIndexFile = NULL;
+	FILE* g_hWavFile = NULL;
+	UINT64 g_framesFileSize = 0;
+	UINT64 g_wavFramesWritten = 0;
+}
+
+//===========================================================================
+
+static Packet* GetFreePacket(PacketType type)
+{
+	Packet* pPacket;
+
+	EnterCriticalSection(&g_csQueue);
+	if (g_freePackets.empty())
+	{
+		pPacket = new Packet;
+	}
+	else
+	{
+		pPacket = g_freePackets.back();
+		g_freePackets.pop_back();
+	}
+	LeaveCriticalSection(&g_csQueue);
+
+	pPacket->type = type;
+	pPacket->cycle = g_nCumulativeCycles;
+	pPacket->numDroppedBefore = 0;
+	return pPacket;
+}
+
+static void QueuePacket(Packet* pPacket)
+{
+	EnterCriticalSection(&g_csQueue);
+	g_queue.push_back(pPacket);
+	if (pPacket->type == PACKET_VIDEO)
+		g_numQueuedVideoPackets++;
+	LeaveCriticalSection(&g_csQueue);
+
+	SetEvent(g_hQueueEvent);
+}
+
+//---------------------------------------------------------------------------
+
+void Capture_PutSamples(CaptureVoice voice, const short* pSamples, UINT numFrames, UINT numChannels)
+{
+	if (!g_bActive || !numFrames || g_bFullSpeed)	// see Capture_PutVideoFrame()
+		return;
+
+	g_voiceActive[voice] = true;
+
+	// Skip any samples that are behind what's already been flushed (ie. this voice was lagging),
+	// then continue from the flushed position, so that the voice catches up however far behind it was
+	UINT64 pos = g_voicePos[voice];
+	if (pos < g_audioFlushedPos)
+	{
+		const UINT numSkipped = (UINT)std::min<UINT64>(g_audioFlushedPos - pos, numFrames);
+		pSamples += numSkipped * numChannels;
+		numFrames -= numSkipped;
+		pos = g_audioFlushedPos;
+	}
+
+	const size_t end = (size_t)(pos + numFrames - g_audioFlushedPos) * CAPTURE_NUM_CHANNELS;
+	if (g_audioMix.size() < end)
+		g_audioMix.resize(end, 0);
+
+	int* pMix = &g_audioMix[(size_t)(pos - g_audioFlushedPos) * CAPTURE_NUM_CHANNELS];
+	for (UINT i = 0; i < numFrames; i++)
+	{
+		const short left = pSamples[0];
+		const short right = (numChannels > 1) ? pSamples[1] : left;
+		pMix[0] += left;
+		pMix[1] += right;
+		pMix += CAPTURE_NUM_CHANNELS;
+		pSamples += numChannels;
+	}
+
+	g_voicePos[voice] = pos + numFrames;
+}
+
+// Flush the audio that all the active voices have reached (or, at the end, that any voice has reached)
+static void FlushAudio(bool bFlushAll = false)
+{
+	UINT64 minPos = ~(UINT64)0;
+	UINT64 maxPos = 0;
+	for (UINT v = 0; v < NUM_CAPTURE_VOICES; v++)
+	{
+		if (!g_voiceActive[v])
+			continue;
+		minPos = std::min<UINT64>(minPos, g_voicePos[v]);
+		maxPos = std::max<UINT64>(maxPos, g_voicePos[v]);
+	}
+
+	if (maxPos <= g_audioFlushedPos)
+		return;
+
+	// Don't let a voice that's stopped producing samples (eg. speaker at full-speed) hold up the others
+	const UINT64 flushPos = bFlushAll ? maxPos : std::max<UINT64>(minPos, (maxPos > kMaxAudioLag) ? maxPos - kMaxAudioLag : 0);
+	if (flushPos <= g_audioFlushedPos)
+		return;
+
+	const size_t numSamples = (size_t)(flushPos - g_audioFlushedPos) * CAPTURE_NUM_CHANNELS;
+
+	Packet* pPacket = GetFreePacket(PACKET_AUDIO);
+	pPacket->data.resize(numSamples * sizeof(short));
+	short* pDst = (short*)&pPacket->data[0];
+
+	for (size_t i = 0; i < numSamples; i++)
+	{
+		int sample = g_audioMix[i];
+		if (sample > SHRT_MAX)
+			sample = SHRT_MAX;
+		else if (sample < SHRT_MIN)
+			sample = SHRT_MIN;
+		pDst[i] = (short)sample;
+	}
+
+	QueuePacket(pPacket);
+
+	g_audioMix.erase(g_audioMix.begin(), g_audioMix.begin() + numSamples);
+	g_audioFlushedPos = flushPos;
+}
+
+void Capture_PutVideoFrame()
+{
+	// Nothing is captured at full-speed: the speaker's samples are then paced by the sound buffer, not by emulated cycles,
+	// so the audio & video would drift apart. (The Mockingboard doesn't produce samples at full-speed anyway.)
+	if (!g_bActive || g_bFullSpeed)
+		return;
+
+	FlushAudio();
+
+	EnterCriticalSection(&g_csQueue);
+	const bool bQueueFull = g_numQueuedVideoPackets >= kMaxQueuedVideoPackets;
+	LeaveCriticalSection(&g_csQueue);
+
+	// Also drop if the framebuffer's size has changed (as the capture's frame size is fixed)
+	Video& video = GetVideo();
+	if (bQueueFull || video.GetFrameBufferBorderlessWidth() != g_frameWidth || video.GetFrameBufferBorderlessHeight() != g_frameHeight)
+	{
+		g_numDroppedFrames++;
+		g_numDroppedFramesTotal++;
+		return;
+	}
+
+	Packet* pPacket = GetFreePacket(PACKET_VIDEO);
+	pPacket->numDroppedBefore = g_numDroppedFrames;
+	g_numDroppedFrames = 0;
+
+	const UINT rowSize = g_frameWidth * sizeof(uint32_t);
+	pPacket->data.resize(rowSize * g_frameHeight);
+
+	const uint32_t* pSrc = (const uint32_t*)video.GetFrameBuffer();
+	pSrc += video.GetFrameBufferBorderHeight() * video.GetFrameBufferWidth() + video.GetFrameBufferBorderWidth();
+
+	BYTE* pDst = &pPacket->data[0];
+	for (UINT y = 0; y < g_frameHeight; y++)
+	{
+		memcpy(pDst, pSrc, rowSize);
+		pDst += rowSize;
+		pSrc += video.GetFrameBufferWidth();
+	}
+
+	QueuePacket(pPacket);
+}
+
+//===========================================================================
+
+static void WriteVideoPacket(const Packet* pPacket, std::vector<BYTE>& compressed, UINT& frameNum)
+{
+	// Dropped frames don't have their own cycle, so just use this frame's
+	for (UINT i = 0; i < pPacket->numDroppedBefore; i++)
+		fprintf(g_hIndexFile, "%u,%llu,%llu,0\n", frameNum++, (unsigned long long)pPacket->cycle, (unsigned long long)g_framesFileSize);
+
+	uLongf compressedSize = compressBound((uLong)pPacket->data.size());
+	compressed.resize(compressedSize);
+	if (compress2(&compressed[0], &compressedSize, &pPacket->data[0], (uLong)pPacket->data.size(), Z_BEST_SPEED) != Z_OK)
+		compressedSize = 0;		// Index as a repeat
+
+	if (compressedSize)
+		fwrite(&compressed[0], 1, compressedSize, g_hFramesFile);
+
+	fprintf(g_hIndexFile, "%u,%llu,%llu,%u\n", frameNum++, (unsigned long long)pPacket->cycle, (unsigned long long)g_framesFileSize, (UINT)compressedSize);
+	g_framesFileSize += compressedSize;
+}
+
+static DWORD WINAPI Capture_WriterThread(LPVOID lpParameter)
+{
+	std::vector<BYTE> compressed;
+	UINT frameNum = 0;
+
+	while (true)
+	{
+		EnterCriticalSection(&g_csQueue);
+		Packet* pPacket = NULL;
+		if (!g_queue.empty())
+		{
+			pPacket = g_queue.front();
+			g_queue.pop_front();
+		}
+		const bool bStop = g_bStopWriter;
+		LeaveCriticalSection(&g_csQueue);
+
+		if (!pPacket)
+		{
+			if (bStop)
+				break;		// Only once the queue is drained
+
+			WaitForSingleObject(g_hQueueEvent, INFINITE);
+			continue;
+		}
+
+		if (pPacket->type == PACKET_VIDEO)
+		{
+			WriteVideoPacket(pPacket, compressed, frameNum);
+		}
+		else
+		{
+			const UINT numFrames = (UINT)(pPacket->data.size() / (sizeof(short) * CAPTURE_NUM_CHANNELS));
+			fwrite(&pPacket->data[0], sizeof(short) * CAPTURE_NUM_CHANNELS, numFrames, g_hWavFile);
+			g_wavFramesWritten += numFrames;
+		}
+
+		EnterCriticalSection(&g_csQueue);
+		if (pPacket->type == PACKET_VIDEO)
+			g_numQueuedVideoPackets--;
+		g_freePackets.push_back(pPacket);
+		LeaveCriticalSection(&g_csQueue);
+	}
+
+	return 0;
+}
+
+//===========================================================================
+
+static void CloseFiles()
+{
+	if (g_hFramesFile)
+		fclose(g_hFramesFile);
+	if (g_hIndexFile)
+		fclose(g_hIndexFile);
+	if (g_hWavFile)
+	{
+		RiffWriteHeader(g_hWavFile, CAPTURE_SAMPLE_RATE, CAPTURE_NUM_CHANNELS, g_wavFramesWritten);
+		fclose(g_hWavFile);
+	}
+
+	g_hFramesFile = NULL;
+	g_hIndexFile = NULL;
+	g_hWavFile = NULL;
+}
+
+bool Capture_Start(const std::string& strPrefix)
+{
+	_ASSERT(SPKR_SAMPLE_RATE == CAPTURE_SAMPLE_RATE);
+
+	if (g_bActive)
+		return false;
+
+	g_hFramesFile = fopen((strPrefix + ".frames").c_str(), "wb");
+	g_hIndexFile = fopen((strPrefix + ".idx").c_str(), "w");
+	g_hWavFile = fopen((strPrefix + ".wav").c_str(), "wb");
+	if (!g_hFramesFile || !g_hIndexFile || !g_hWavFile)
+	{
+		LogFileOutput("Capture_Start: Failed to create capture files: %s.*\n", strPrefix.c_str());
+		CloseFiles();
+		return false;
+	}
+
+	g_frameWidth = GetVideo().GetFrameBufferBorderlessWidth();
+	g_frameHeight = GetVideo().GetFrameBufferBorderlessHeight();
+
+	fprintf(g_hIndexFile, "# frames: %ux%u, 32bpp BGRA, bottom-up, zlib-compressed. audio: %uHz, %u channels\n", g_frameWidth, g_frameHeight, CAPTURE_SAMPLE_RATE, CAPTURE_NUM_CHANNELS);
+	fprintf(g_hIndexFile, "frame,cycle,offset,size\n");
+	RiffWriteHeader(g_hWavFile, CAPTURE_SAMPLE_RATE, CAPTURE_NUM_CHANNELS, 0);
+	g_framesFileSize = 0;
+	g_wavFramesWritten = 0;
+
+	g_audioMix.clear();
+	g_audioFlushedPos = 0;
+	for (UINT v = 0; v < NUM_CAPTURE_VOICES; v++)
+	{
+		g_voicePos[v] = 0;
+		g_voiceActive[v] = false;
+	}
+
+	InitializeCriticalSection(&g_csQueue);
+	g_numQueuedVideoPackets = 0;
+	g_numDroppedFrames = 0;
+	g_numDroppedFramesTotal = 0;
+	g_bStopWriter = false;
+
+	g_hQueueEvent = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	DWORD dwThreadId;
+	g_hWriterThread = g_hQueueEvent ? CreateThread(NULL, 0, Capture_WriterThread, NULL, 0, &dwThreadId) : NULL;
+	if (!g_hWriterThread)
+	{
+		LogFileOutput("Capture_Start: Failed to create writer thread\n");
+		if (g_hQueueEvent)
+			CloseHandle(g_hQueueEvent);
+		g_hQueueEvent = NULL;
+		DeleteCriticalSection(&g_csQueue);
+		CloseFiles();
+		return false;
+	}
+
+	g_bActive = true;
+	LogFileOutput("Capture_Start: %s.* (%ux%u)\n", strPrefix.c_str(), g_frameWidth, g_frameHeight);
+	return true;
+}
+
+void Capture_Stop()
+{
+	if (!g_bActive)
+		return;
+
+	FlushAudio(true);
+	g_bActive = false;
+
+	// Let the writer drain the queue, then exit
+	EnterCriticalSection(&g_csQueue);
+	g_bStopWriter = true;
+	LeaveCriticalSection(&g_csQueue);
+	SetEvent(g_hQueueEvent);
+
+	WaitForSingleObject(g_hWriterThread, INFINITE);
+	CloseHandle(g_hWriterThread);
+	CloseHandle(g_hQueueEvent);
+	g_hWriterThread = NULL;
+	g_hQueueEvent = NULL;
+
+	for (UINT i = 0; i < g_freePackets.size(); i++)
+		delete g_freePackets[i];
+	g_freePackets.clear();
+	DeleteCriticalSection(&g_csQueue);
+
+	CloseFiles();
+	g_audioMix.clear();
+
+	LogFileOutput("Capture_Stop: %u frames dropped\n", g_numDroppedFramesTotal);
+}
+
+bool Capture_IsActive()
+{
+	return g_bActive;
+}
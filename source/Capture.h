@@ -0,0 +1,27 @@
+#pragma once
+
+// Audio/video capture (see command line: -capture <prefix>)
+// . Every presented frame and all the mixed audio (except while at full-speed) are captured to raw streams plus an index:
+//   <prefix>.frames: each frame zlib-compressed, 32bpp BGRA (bottom-up rows, as a .bmp), borderless
+//   <prefix>.wav:    44.1KHz stereo
+//   <prefix>.idx:    CSV, one line per frame: frame, cycle, offset (in .frames), size (0 = a repeat of the previous frame)
+// . The emulator only copies the data into a bounded queue: compression & disk writes are done by a background thread.
+//   If the queue is full, then the frame is dropped (and indexed as a repeat) rather than stalling the emulator.
+
+enum CaptureVoice
+{
+	CAPTURE_VOICE_SPEAKER,
+	CAPTURE_VOICE_MOCKINGBOARD,
+	NUM_CAPTURE_VOICES
+};
+
+const UINT CAPTURE_SAMPLE_RATE = 44100;
+const UINT CAPTURE_NUM_CHANNELS = 2;
+
+bool Capture_Start(const std::string& strPrefix);
+void Capture_Stop();
+bool Capture_IsActive();
+
+// Emulation thread
+void Capture_PutSamples(CaptureVoice voice, const short* pSamples, UINT numFrames, UINT numChannels);
+void Capture_PutVideoFrame();
@@ -21,6 +21,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "StdAfx.h"
 #include "Card.h"
 
+#include "CPU.h"
 #include "Uthernet1.h"
 #include "Uthernet2.h"
 #include "BreakpointCard.h"
@@ -38,6 +39,38 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <sstream>
 
+void Card::ScheduleUpdateIn(const ULONG cycles)
+{
+	ScheduleUpdate(g_nCumulativeCycles + cycles);
+}
+
+void Card::SetNextUpdateCycle(const UINT64 cycle)
+{
+	if (m_nextUpdateCycle == kUpdateNever)
+		m_lastUpdateCycle = g_nCumulativeCycles;	// Was idle, so there was nothing to do in Update() until now
+
+	m_nextUpdateCycle = cycle;
+}
+
+void Card::ScheduledUpdate(const UINT64 cycle)
+{
+	const UINT64 cycles = cycle - m_lastUpdateCycle;
+	m_lastUpdateCycle = cycle;
+	m_nextUpdateCycle = kUpdateNever;	// Update() re-schedules, if it has more to do
+
+	Update((ULONG)std::min<UINT64>(cycles, ULONG_MAX));
+}
+
+// Cycles have jumped (eg. loaded a save-state), so any scheduled update is due now
+void Card::RebaseUpdateCycles(const UINT64 cycle)
+{
+	m_lastUpdateCycle = cycle;
+	if (m_nextUpdateCycle != kUpdateNever)
+		m_nextUpdateCycle = 0;
+}
+
+//===========================================================================
+
 void Card::ThrowErrorInvalidSlot()
 {
 	ThrowErrorInvalidSlot(m_type, m_slot);
@@ -42,15 +42,18 @@ class YamlLoadHelper;
 class Card
 {
 public:
-	Card(SS_CARDTYPE type, UINT slot) : m_type(type), m_slot(slot) {}
+	Card(SS_CARDTYPE type, UINT slot) : m_type(type), m_slot(slot), m_nextUpdateCycle(kUpdateNever), m_lastUpdateCycle(0) {}
 	virtual ~Card() {}
 
 	virtual void InitializeIO(LPBYTE pCxRomPeripheral) = 0;
 	virtual void Destroy() = 0;		// Called by CardManager::Destroy() on WM_DESTROY
 	virtual void Reset(const bool powerCycle) = 0;
-	virtual void Update(const ULONG nExecutedCycles) = 0;
+	virtual void Update(const ULONG nExecutedCycles) = 0;	// Only called when scheduled (see ScheduleUpdate())
 	virtual void SaveSnapshot(YamlSaveHelper& yamlSaveHelper) = 0;
 	virtual bool LoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT version) = 0;
+	// Called instead of re-inserting the card when a save-state with the same card in this slot is loaded (see Snapshot_LoadState())
+	// . must leave the card as LoadSnapshot() expects a new card to be, eg. no active SyncEvents, but without re-opening any host resources
+	virtual void InitializeForLoadingSnapshot() { Reset(false); }
 
 	SS_CARDTYPE QueryType() { return m_type; }
 
@@ -63,14 +66,37 @@ public:
 	static void ThrowErrorInvalidSlot(SS_CARDTYPE type, UINT slot);
 	static void ThrowErrorInvalidVersion(SS_CARDTYPE type, UINT version);
 
+	// Update scheduler (called by CardManager::Update() at the end of each execution period)
+	UINT64 GetNextUpdateCycle() { return m_nextUpdateCycle; }
+	void ScheduledUpdate(const UINT64 cycle);
+	void RebaseUpdateCycles(const UINT64 cycle);
+
+	static const UINT64 kUpdateNever = (UINT64)-1;
+
 protected:
 	UINT m_slot;
 
 	void ThrowErrorInvalidSlot();
 	void ThrowErrorInvalidVersion(UINT version);
 
+	// A card's Update() is only called once its scheduled cycle has been reached, then it's unscheduled until
+	// the card schedules again (eg. from Update() for periodic work, or from an I/O access that starts some work).
+	// . nExecutedCycles is the cycles since its last Update() (or since it was scheduled, if it was idle)
+	// . so a card with nothing to do costs nothing per execution period
+	void ScheduleUpdate(const UINT64 cycle)
+	{
+		if (cycle < m_nextUpdateCycle)		// NB. an earlier schedule is kept
+			SetNextUpdateCycle(cycle);
+	}
+	void ScheduleUpdateNow() { ScheduleUpdate(0); }	// ie. at the end of this execution period
+	void ScheduleUpdateIn(const ULONG cycles);
+
 private:
+	void SetNextUpdateCycle(const UINT64 cycle);
+
 	SS_CARDTYPE m_type;
+	UINT64 m_nextUpdateCycle;
+	UINT64 m_lastUpdateCycle;
 };
 
 //
@@ -33,6 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Registry.h"
 
 #include "BreakpointCard.h"
+#include "CPU.h"
 #include "Disk.h"
 #include "FourPlay.h"
 #include "Harddisk.h"
@@ -296,19 +297,40 @@ void CardManager::Reset(const bool powerCycle)
 	GetMockingboardCardMgr().Reset(powerCycle);
 }
 
+// Called by ContinueExecution() at the end of every execution period
+// . Only the cards whose scheduled update cycle has been reached are updated (see Card::ScheduleUpdate())
 void CardManager::Update(const ULONG nExecutedCycles)
 {
+	const UINT64 cycle = g_nCumulativeCycles;
+
+	if (cycle < m_lastUpdateCycle)
+		RebaseUpdateCycles();
+	m_lastUpdateCycle = cycle;
+
 	for (UINT i = SLOT0; i < NUM_SLOTS; ++i)
 	{
-		if (m_slot[i])
+		if (m_slot[i] && cycle >= m_slot[i]->GetNextUpdateCycle())
 		{
-			m_slot[i]->Update(nExecutedCycles);
+			m_slot[i]->ScheduledUpdate(cycle);
 		}
 	}
 
 	GetMockingboardCardMgr().Update(nExecutedCycles);
 }
 
+// Called after g_nCumulativeCycles has jumped (eg. loaded a save-state), so that no card sees a bogus cycle delta
+void CardManager::RebaseUpdateCycles()
+{
+	const UINT64 cycle = g_nCumulativeCycles;
+
+	for (UINT i = SLOT0; i < NUM_SLOTS; ++i)
+	{
+		if (m_slot[i])
+			m_slot[i]->RebaseUpdateCycles(cycle);
+	}
+	m_lastUpdateCycle = cycle;
+}
+
 void CardManager::SaveSnapshot(YamlSaveHelper& yamlSaveHelper)
 {
 	for (UINT i = SLOT0; i < NUM_SLOTS; ++i)
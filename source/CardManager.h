@@ -14,7 +14,8 @@ public:
 		m_pSSC(NULL),
 		m_pParallelPrinterCard(NULL),
 		m_pVidHDCard(NULL),
-		m_pZ80Card(NULL)
+		m_pZ80Card(NULL),
+		m_lastUpdateCycle(0)
 	{
 		// LoadConfiguration() now sets up default cards for a new install
 		InsertInternal(SLOT0, CT_Empty);
@@ -73,6 +74,7 @@ public:
 	void Destroy();
 	void Reset(const bool powerCycle);
 	void Update(const ULONG nExecutedCycles);
+	void RebaseUpdateCycles();
 	void SaveSnapshot(YamlSaveHelper& yamlSaveHelper);
 
 private:
@@ -92,4 +94,5 @@ private:
 	class ParallelPrinterCard* m_pParallelPrinterCard;
 	class VidHDCard* m_pVidHDCard;
 	class Z80Card* m_pZ80Card;
+	UINT64 m_lastUpdateCycle;
 };
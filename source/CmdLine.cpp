@@ -122,6 +122,13 @@ bool ProcessCmdLine(LPSTR lpCmdLine)
 		{
 			LogInit();
 		}
+		else if (strcmp(lpCmdLine, "-log-level") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			if (!LogSetLevels(lpCmdLine))
+				LogFileOutput("Unsupported log level: %s\n", lpCmdLine);
+		}
 		else if (strcmp(lpCmdLine, "-noreg") == 0)
 		{
 			g_bRegisterFileTypes = false;
@@ -312,6 +319,10 @@ bool ProcessCmdLine(LPSTR lpCmdLine)
 					if (type == SSI263Unknown)
 						LogFileOutput("Unsupported SSI263 type: %s\n", socketType);
 				}
+				else if (strncmp(lpCmdLine, "interface=", 10) == 0)	// eg. a pcap interface, or "loopback:<switch>"
+				{
+					g_cmdLine.slotInfo[slot].networkInterface = &lpCmdLine[10];
+				}
 				else if (strcmp(lpCmdLine, "sc01") == 0)
 				{
 					g_cmdLine.slotInfo[slot].socketSC01 = SC01;
@@ -585,6 +596,34 @@ bool ProcessCmdLine(LPSTR lpCmdLine)
 		{
 			g_cmdLine.enableDumpToRealPrinter = true;
 		}
+		else if (strcmp(lpCmdLine, "-printer-flush") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			if (strcmp(lpCmdLine, "idle") == 0)
+				g_cmdLine.printerFlush = PRINTER_FLUSH_IDLE;
+			else if (strcmp(lpCmdLine, "line") == 0)
+				g_cmdLine.printerFlush = PRINTER_FLUSH_LINE;
+			else if (strcmp(lpCmdLine, "job") == 0)
+				g_cmdLine.printerFlush = PRINTER_FLUSH_JOB;
+			else
+				LogFileOutput("-printer-flush: unsupported policy: %s\n", lpCmdLine);
+		}
+		else if (strcmp(lpCmdLine, "-printer-per-job") == 0)
+		{
+			g_cmdLine.printerPerJobFiles = true;
+		}
+		else if (strcmp(lpCmdLine, "-printer-convert") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			if (strcmp(lpCmdLine, "escp") == 0)
+				g_cmdLine.printerConvert = PRINTER_CONVERT_ESCP;
+			else if (strcmp(lpCmdLine, "imagewriter") == 0)
+				g_cmdLine.printerConvert = PRINTER_CONVERT_IMAGEWRITER;
+			else
+				LogFileOutput("-printer-convert: unsupported printer: %s\n", lpCmdLine);
+		}
 		else if (strcmp(lpCmdLine, "-speech") == 0)
 		{
 			g_bEnableSpeech = true;
@@ -749,6 +788,45 @@ bool ProcessCmdLine(LPSTR lpCmdLine)
 			lpNextArg = GetNextArg(lpNextArg);
 			g_cmdLine.wavFileMockingboard = lpCmdLine;
 		}
+		else if (strcmp(lpCmdLine, "-audio-null") == 0)
+		{
+			g_cmdLine.audioRingBackend = AUDIO_RING_NULL;
+		}
+		else if (strcmp(lpCmdLine, "-audio-wav") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.audioRingBackend = AUDIO_RING_WAV_FILE;
+			g_cmdLine.audioRingWavFile = lpCmdLine;
+		}
+		else if (strcmp(lpCmdLine, "-capture") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.captureFilePrefix = lpCmdLine;
+		}
+		else if (strcmp(lpCmdLine, "-loopback-pcap") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.loopbackCaptureFilename = lpCmdLine;
+		}
+		else if (strcmp(lpCmdLine, "-tape-in") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.tapeInFilename = lpCmdLine;
+		}
+		else if (strcmp(lpCmdLine, "-tape-out") == 0)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.tapeOutFilename = lpCmdLine;
+		}
+		else if (strcmp(lpCmdLine, "-tape-fast-load") == 0)
+		{
+			g_cmdLine.tapeFastLoad = true;
+		}
 		else if (strcmp(lpCmdLine, "-mb-audit") == 0)	// enable selection of additional sound cards, eg. for mb-audit
 		{
 			g_cmdLine.supportExtraMBCardTypes = true;
@@ -812,6 +890,16 @@ bool ProcessCmdLine(LPSTR lpCmdLine)
 
 			g_cmdLine.debuggerAutoRunScriptFilename = lpCmdLine;
 		}
+		else if (strcmp(lpCmdLine, "-index-images") == 0)	// batch: index all images in <dir> to <file.csv>, then exit
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.indexImagesDir = lpCmdLine;
+
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_cmdLine.indexImagesFilename = lpCmdLine;
+		}
 		else	// unsupported
 		{
 			LogFileOutput("Unsupported arg: %s\n", lpCmdLine);
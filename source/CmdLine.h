@@ -7,6 +7,8 @@
 #include "Card.h"
 #include "MockingboardDefs.h"
 #include "AY8910.h"
+#include "AudioRing.h"
+#include "PrinterOutput.h"
 
 struct CmdLine
 {
@@ -31,6 +33,7 @@ struct CmdLine
 		AY891xType socketAY891x[NUM_AY8913];
 		SSI263Type socketSSI263[NUM_SSI263];
 		SSI263Type socketSC01;
+		std::string networkInterface;	// Uthernet & Uthernet II
 	};
 
 	CmdLine()
@@ -45,6 +48,9 @@ struct CmdLine
 		snesMaxAltControllerType[1] = false;
 		supportDCD = false;
 		enableDumpToRealPrinter = false;
+		printerFlush = PRINTER_FLUSH_IDLE;
+		printerPerJobFiles = false;
+		printerConvert = PRINTER_CONVERT_NONE;
 		supportExtraMBCardTypes = false;
 		noDisk2StepperDefer = false;
 		useHdcFirmwareV1 = false;
@@ -65,6 +71,8 @@ struct CmdLine
 		rgbCardForegroundColor = 15;
 		rgbCardBackgroundColor = 0;
 		bestFullScreenResolution = false;
+		audioRingBackend = AUDIO_RING_NONE;
+		tapeFastLoad = false;
 		userSpecifiedWidth = 0;
 		userSpecifiedHeight = 0;
 		auxSlotCard = CT_Undefined;
@@ -91,6 +99,9 @@ struct CmdLine
 	bool snesMaxAltControllerType[2];
 	bool supportDCD;
 	bool enableDumpToRealPrinter;
+	PrinterFlush printerFlush;
+	bool printerPerJobFiles;
+	PrinterConvert printerConvert;
 	bool supportExtraMBCardTypes;
 	bool noDisk2StepperDefer;	// debug
 	bool useHdcFirmwareV1;	// debug
@@ -121,10 +132,19 @@ struct CmdLine
 	UINT userSpecifiedHeight;
 	std::string wavFileSpeaker;
 	std::string wavFileMockingboard;
+	AudioRingBackend audioRingBackend;
+	std::string audioRingWavFile;
+	std::string captureFilePrefix;
+	std::string loopbackCaptureFilename;
+	std::string tapeInFilename;
+	std::string tapeOutFilename;
+	bool tapeFastLoad;
 	SS_CARDTYPE auxSlotCard;
 	std::string sBootSectorFileName;
 	size_t nBootSectorFileSize;
 	std::string debuggerAutoRunScriptFilename;
+	std::string indexImagesDir;
+	std::string indexImagesFilename;
 };
 
 bool ProcessCmdLine(LPSTR lpCmdLine);
@@ -276,3 +276,15 @@ enum eBUTTON {BUTTON0=0, BUTTON1};
 enum eBUTTONSTATE {BUTTON_UP=0, BUTTON_DOWN};
 
 enum {IDEVENT_TIMER_MOUSE=1, IDEVENT_TIMER_100MSEC};
+
+// For a cache to check whether its source file has changed (the last write time has a 100ns resolution)
+inline bool GetFileSizeAndLastWriteTime(const char* pPathname, UINT64& size, UINT64& lastWriteTime)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attr;
+	if (!GetFileAttributesEx(pPathname, GetFileExInfoStandard, &attr))
+		return false;
+
+	size = ((UINT64)attr.nFileSizeHigh << 32) | attr.nFileSizeLow;
+	lastWriteTime = ((UINT64)attr.ftLastWriteTime.dwHighDateTime << 32) | attr.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
@@ -94,6 +94,14 @@ void BreakpointCard::Reset(const bool powerCycle)
 		CpuIrqDeassert(IS_BREAKPOINTCARD);
 }
 
+void BreakpointCard::InitializeForLoadingSnapshot()
+{
+	Reset(false);
+
+	if (m_syncEvent.m_active)	// a breakpoint that's pending from before the save-state was loaded
+		g_SynchronousEventMgr.Remove(m_syncEvent.m_id);
+}
+
 void BreakpointCard::InitializeIO(LPBYTE pCxRomPeripheral)
 {
 	RegisterIoHandler(m_slot, &BreakpointCard::IORead, &BreakpointCard::IOWrite, IO_Null, IO_Null, this, NULL);
@@ -55,6 +55,7 @@ public:
 
 	virtual void Destroy() {}
 	virtual void Reset(const bool powerCycle);
+	virtual void InitializeForLoadingSnapshot();
 	virtual void Update(const ULONG nExecutedCycles) {}
 	virtual void InitializeIO(LPBYTE pCxRomPeripheral);
 
@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "StdAfx.h"
 
 #include "Debug.h"
+#include "Debugger_MemorySearch.h"
 #include "Debugger_Win32.h"
 
 #include "../Windows/AppleWin.h"
@@ -40,6 +41,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "../CardManager.h"
 #include "../CPU.h"
 #include "../Disk.h"
+#include "../Harddisk.h"
 #include "../Keyboard.h"
 #include "../Memory.h"
 #include "../NTSC.h"
@@ -52,7 +54,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define MAKE_VERSION(a,b,c,d) ((a<<24) | (b<<16) | (c<<8) | (d))
 
 	// See /docs/Debugger_Changelog.txt for full details
-	const int DEBUGGER_VERSION = MAKE_VERSION(2,9,4,3);
+	const int DEBUGGER_VERSION = MAKE_VERSION(2,9,4,7);
 
 
 // Public _________________________________________________________________________________________
@@ -337,6 +339,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #endif
 
 	static char      g_sFileNameTrace      [] = "Trace.txt";
+	static char      g_sFileNameDiskStats  [] = "DiskStats.csv";
 
 	static bool      g_bBenchmarking = false;
 
@@ -398,7 +401,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 // Source Level Debugging
 	static	bool BufferAssemblyListing ( const std::string & pFileName );
-	static	bool ParseAssemblyListing ( bool bBytesToMemory, bool bAddSymbols );
+	static	bool ParseAssemblyListing ( const std::string & sFileName, bool bBytesToMemory, bool bAddSymbols );
 
 
 // Window
@@ -3911,9 +3914,197 @@ Update_t CmdFlag (int nArgs)
 
 // Disk ___________________________________________________________________________________________
 
+//===========================================================================
+static void _DiskStatsPrintLatency ( const char *pName, const DiskLatencyHistogram & latency )
+{
+	ConsoleBufferPushFormat( "  %s n=%llu mean %llu p90 %llu max %llu cy"
+		, pName
+		, (unsigned long long) latency.GetCount()
+		, (unsigned long long) latency.GetMeanCycles()
+		, (unsigned long long) latency.GetPercentileCycles( 90 )
+		, (unsigned long long) latency.GetMaxCycles()
+	);
+}
+
+//===========================================================================
+static void _DiskStatsPrint ( const UINT nSlot, const int iDrive, const Disk2DriveStats & stats )
+{
+	UINT64 nSeeks = 0;
+	for (UINT iTrack = 0; iTrack < TRACKS_MAX; iTrack++)
+		nSeeks += stats.m_seeks[ iTrack ];
+
+	ConsoleBufferPushFormat( "S%u D%d: steps %llu, seeks %llu, track rd %llu wr %llu"
+		, nSlot, iDrive + 1
+		, (unsigned long long) stats.m_quarterTrackSteps
+		, (unsigned long long) nSeeks
+		, (unsigned long long) stats.m_trackReads
+		, (unsigned long long) stats.m_trackWrites
+	);
+
+	const double fReadsPerNibble = stats.m_nibblesRead ? (double) stats.m_latchReads / stats.m_nibblesRead : 0.0;
+	ConsoleBufferPushFormat( "  latch rd %llu, nibbles rd %llu wr %llu, rd/nib %.2f"
+		, (unsigned long long) stats.m_latchReads
+		, (unsigned long long) stats.m_nibblesRead
+		, (unsigned long long) stats.m_nibblesWritten
+		, fReadsPerNibble
+	);
+
+	ConsoleBufferPushFormat( "  motor on %.2fs", (double) stats.m_motorOnCycles / g_fCurrentCLK6502 );
+	_DiskStatsPrintLatency( "motor", stats.m_motorOnLatency );
+}
+
+//===========================================================================
+static void _DiskStatsPrint ( const UINT nSlot, const int iDrive, const HardDiskDriveStats & stats )
+{
+	ConsoleBufferPushFormat( "S%u HDD%d: blocks rd %llu wr %llu, formats %llu, errors %llu"
+		, nSlot, iDrive + 1
+		, (unsigned long long) stats.m_blocksRead
+		, (unsigned long long) stats.m_blocksWritten
+		, (unsigned long long) stats.m_formats
+		, (unsigned long long) stats.m_errors
+	);
+	_DiskStatsPrintLatency( "rd", stats.m_readLatency );
+	_DiskStatsPrintLatency( "wr", stats.m_writeLatency );
+}
+
+// Machine-readable: one "slot,card,drive,stat,value" record per line
+//===========================================================================
+static void _DiskStatsSaveValue ( FILE *hFile, const UINT nSlot, const char *pCard, const int iDrive, const std::string & sStat, const UINT64 nValue )
+{
+	fprintf( hFile, "%u,%s,%d,%s,%llu\n", nSlot, pCard, iDrive + 1, sStat.c_str(), (unsigned long long) nValue );
+}
+
+//===========================================================================
+static void _DiskStatsSaveLatency ( FILE *hFile, const UINT nSlot, const char *pCard, const int iDrive, const std::string & sName, const DiskLatencyHistogram & latency )
+{
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, sName + "_count"       , latency.GetCount() );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, sName + "_total_cycles", latency.GetTotalCycles() );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, sName + "_max_cycles"  , latency.GetMaxCycles() );
+
+	// bucket_<n> = # latencies of [2^n .. 2^(n+1)-1] cycles
+	for (UINT iBucket = 0; iBucket < DiskLatencyHistogram::kNumBuckets; iBucket++)
+		_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, StrFormat( "%s_bucket_%u", sName.c_str(), iBucket ), latency.GetBucket( iBucket ) );
+}
+
+//===========================================================================
+static void _DiskStatsSave ( FILE *hFile, const UINT nSlot, const int iDrive, const Disk2DriveStats & stats )
+{
+	const char *pCard = "Disk2";
+
+	for (UINT iTrack = 0; iTrack < TRACKS_MAX; iTrack++)
+		_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, StrFormat( "seeks_track_%u", iTrack ), stats.m_seeks[ iTrack ] );
+
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "quarter_track_steps", stats.m_quarterTrackSteps );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "motor_on_cycles"    , stats.m_motorOnCycles );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "latch_reads"        , stats.m_latchReads );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "nibbles_read"       , stats.m_nibblesRead );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "nibbles_written"    , stats.m_nibblesWritten );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "track_reads"        , stats.m_trackReads );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "track_writes"       , stats.m_trackWrites );
+	_DiskStatsSaveLatency( hFile, nSlot, pCard, iDrive, "motor_on_latency" , stats.m_motorOnLatency );
+}
+
+//===========================================================================
+static void _DiskStatsSave ( FILE *hFile, const UINT nSlot, const int iDrive, const HardDiskDriveStats & stats )
+{
+	const char *pCard = "HDD";
+
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "blocks_read"   , stats.m_blocksRead );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "blocks_written", stats.m_blocksWritten );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "formats"       , stats.m_formats );
+	_DiskStatsSaveValue( hFile, nSlot, pCard, iDrive, "errors"        , stats.m_errors );
+	_DiskStatsSaveLatency( hFile, nSlot, pCard, iDrive, "read_latency" , stats.m_readLatency );
+	_DiskStatsSaveLatency( hFile, nSlot, pCard, iDrive, "write_latency", stats.m_writeLatency );
+}
+
+// DISK STATS [RESET | SAVE ["<filename>"]]
+// . All Disk II & hard disk cards (not just the current slot)
+//===========================================================================
+static Update_t _CmdDiskStats ( int nArgs )
+{
+	int iParam = 0;
+	if (nArgs >= 2)
+	{
+		if (!FindParam( g_aArgs[2].sArg, MATCH_EXACT, iParam, _PARAM_GENERAL_BEGIN, _PARAM_GENERAL_END ))
+			return HelpLastCommand();
+		if ((iParam != PARAM_RESET && iParam != PARAM_SAVE) || (iParam == PARAM_RESET && nArgs > 2) || nArgs > 3)
+			return HelpLastCommand();
+	}
+
+	FILE *hFile = NULL;
+	std::string sFilePath;
+
+	if (iParam == PARAM_SAVE)
+	{
+		sFilePath = g_sCurrentDir + ((nArgs == 3) ? g_aArgs[3].sArg : g_sFileNameDiskStats);
+
+		hFile = fopen( sFilePath.c_str(), "wt" );
+		if (!hFile)
+			return ConsoleDisplayErrorFormat( "Unable to write: %s", sFilePath.c_str() );
+
+		fprintf( hFile, "slot,card,drive,stat,value\n" );
+	}
+
+	for (UINT nSlot = SLOT1; nSlot <= SLOT7; nSlot++)
+	{
+		if (GetCardMgr().QuerySlot( nSlot ) == CT_Disk2)
+		{
+			Disk2InterfaceCard& diskCard = dynamic_cast<Disk2InterfaceCard&>(GetCardMgr().GetRef( nSlot ));
+
+			if (iParam == PARAM_RESET)
+			{
+				diskCard.ResetStats();
+				continue;
+			}
+
+			for (int iDrive = DRIVE_1; iDrive < NUM_DRIVES; iDrive++)
+			{
+				if (hFile)
+					_DiskStatsSave( hFile, nSlot, iDrive, diskCard.GetStats( iDrive ) );
+				else
+					_DiskStatsPrint( nSlot, iDrive, diskCard.GetStats( iDrive ) );
+			}
+		}
+		else if (GetCardMgr().QuerySlot( nSlot ) == CT_GenericHDD)
+		{
+			HarddiskInterfaceCard& hddCard = dynamic_cast<HarddiskInterfaceCard&>(GetCardMgr().GetRef( nSlot ));
+
+			if (iParam == PARAM_RESET)
+			{
+				hddCard.ResetStats();
+				continue;
+			}
+
+			for (int iDrive = HARDDISK_1; iDrive < NUM_HARDDISKS; iDrive++)
+			{
+				if (hddCard.GetFullName( iDrive ).empty())
+					continue;	// No image
+
+				if (hFile)
+					_DiskStatsSave( hFile, nSlot, iDrive, hddCard.GetStats( iDrive ) );
+				else
+					_DiskStatsPrint( nSlot, iDrive, hddCard.GetStats( iDrive ) );
+			}
+		}
+	}
+
+	if (hFile)
+	{
+		fclose( hFile );
+		ConsoleBufferPushFormat( "Saved: %s", sFilePath.c_str() );
+	}
+	else if (iParam == PARAM_RESET)
+	{
+		ConsoleBufferPush( "Disk stats reset." );
+	}
+
+	return ConsoleUpdate();
+}
+
 // Usage:
 //     DISK SLOT [#]                                 // Show [or set] the current slot of the Disk II I/F card (for all other cmds to act on)
 //     DISK INFO                                     // Info for current drive
+//     DISK STATS [RESET | SAVE ["<filename>"]]      // Activity stats for all Disk II & hard disk drives (times in emulated cycles)
 //     DISK # EJECT                                  // Unmount disk
 //     DISK # PROTECT #                              // Write-protect disk on/off
 //     DISK # "<filename>"                           // Mount filename as floppy disk
@@ -3952,6 +4143,9 @@ Update_t CmdDisk (int nArgs)
 		return ConsoleUpdate();
 	}
 
+	if (iParam == PARAM_DISK_STATS)
+		return _CmdDiskStats(nArgs);
+
 	if (GetCardMgr().QuerySlot(currentSlot) != CT_Disk2)
 		return ConsoleDisplayErrorFormat("No Disk II card in slot-%d", currentSlot);
 
@@ -4813,7 +5007,7 @@ Update_t CmdMemoryLoad (int nArgs)
 
 		if (bBankSpecified)
 		{
-			BYTE* const pMemBankBase = MemGetBankPtr(nBank);
+			BYTE* const pMemBankBase = MemGetBankPtrForWrite(nBank);
 			if (!pMemBankBase)
 			{
 				ConsoleBufferPush("Error: Bank out of range.");
@@ -5123,7 +5317,7 @@ Update_t CmdMemorySave (int nArgs)
 
 			if (bBankSpecified)
 			{
-				const BYTE* const pMemBankBase = MemGetBankPtr(nBank);
+				const BYTE* const pMemBankBase = MemGetBankPtrReadOnly(nBank);
 				if (!pMemBankBase)
 				{
 					ConsoleBufferPush("Error: Bank out of range.");
@@ -6001,101 +6195,107 @@ int CmdTextSave (int nArgs)
 	return ConsoleUpdate();
 }
 
+// Search a physical 64K bank (main, aux or RamWorks): [$C000-CFFF] holds LC bank 1 for $D000-DFFF
+//===========================================================================
+static int _SearchMemoryBank64K (
+	const MemorySearchPattern_t& pattern, const BYTE* pBank, const bool bHasLangCard,
+	const WORD nAddressStart, const WORD nAddressEnd, AddressPrefix_t addrPrefix )
+{
+	int nFound = _SearchMemoryBlock( pattern, pBank, 0x0000, 0xC000, nAddressStart, nAddressEnd, addrPrefix, g_vMemorySearchResults );
+
+	if (bHasLangCard)
+	{
+		addrPrefix.nLangCard = 1;
+		nFound += _SearchMemoryBlock( pattern, pBank + 0xC000, 0xD000, 0x1000, nAddressStart, nAddressEnd, addrPrefix, g_vMemorySearchResults );
+		addrPrefix.nLangCard = 2;
+		nFound += _SearchMemoryBlock( pattern, pBank + 0xD000, 0xD000, 0x3000, nAddressStart, nAddressEnd, addrPrefix, g_vMemorySearchResults );
+	}
+
+	return nFound;
+}
+
+// Search a 16K LC or Saturn bank: [$0000-0FFF] holds LC bank 1, [$1000-3FFF] holds LC bank 2 & $E000-FFFF
+//===========================================================================
+static int _SearchMemoryBank16K (
+	const MemorySearchPattern_t& pattern, const BYTE* pBank,
+	const WORD nAddressStart, const WORD nAddressEnd, AddressPrefix_t addrPrefix )
+{
+	addrPrefix.nLangCard = 1;
+	int nFound = _SearchMemoryBlock( pattern, pBank, 0xD000, 0x1000, nAddressStart, nAddressEnd, addrPrefix, g_vMemorySearchResults );
+	addrPrefix.nLangCard = 2;
+	nFound += _SearchMemoryBlock( pattern, pBank + 0x1000, 0xD000, 0x3000, nAddressStart, nAddressEnd, addrPrefix, g_vMemorySearchResults );
+	return nFound;
+}
+
 //===========================================================================
 int _SearchMemoryFind (
-	MemorySearchValues_t vMemorySearchValues,
+	const MemorySearchValues_t& vMemorySearchValues,
 	WORD nAddressStart,
-	WORD nAddressEnd )
+	WORD nAddressEnd,
+	bool bAllBanks )
 {
-	int nFound = 0;
-
 	g_vMemorySearchResults.clear();
-	g_vMemorySearchResults.push_back( NO_6502_TARGET );
 
-	uint32_t nAddress;	// NB. can't be uint16_t, since need to count up to 0x10000 if nAddressEnd is 0xFFFF
-	for ( nAddress = nAddressStart; nAddress <= nAddressEnd; nAddress++ )
+	// Results are 1-based (for operator @#)
+	MemorySearchResult_t dummy;
+	dummy.m_nAddress = NO_6502_TARGET;
+	g_vMemorySearchResults.push_back( dummy );
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile( vMemorySearchValues, pattern );
+
+	if (!bAllBanks)
 	{
-		bool bMatchAll = true;
+		// Take a copy of the current 64K view, so that the search doesn't need to go via the MMU per byte
+		std::vector<BYTE> vMemory( _6502_MEM_LEN );
+		for (UINT nAddress = 0; nAddress <= _6502_MEM_END; nAddress++)
+			vMemory[ nAddress ] = ReadByteFromMemory( (WORD) nAddress );
 
-		uint32_t nAddress2 = nAddress;
+		return _SearchMemoryBlock( pattern, &vMemory[0], 0x0000, _6502_MEM_LEN, nAddressStart, nAddressEnd, AddressPrefix_t(), g_vMemorySearchResults );
+	}
 
-		int nMemBlocks = (int) vMemorySearchValues.size();
-		for ( int iBlock = 0; iBlock < nMemBlocks; iBlock++, nAddress2++ )
-		{
-			MemorySearch_t ms = vMemorySearchValues.at( iBlock );
-			ms.m_bFound = false;
-		
-			if ((ms.m_iType == MEM_SEARCH_BYTE_EXACT    ) || 
-				(ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT) ||
-				(ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT ))
-			{
-				BYTE nTarget = ReadByteFromMemory(nAddress2);
-	
-				if (ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT)
-					nTarget &= 0x0F;
+	// All physical banks
 
-				if (ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT)
-					nTarget &= 0xF0;
-				
-				if (ms.m_nValue == nTarget)
-				{ // ms.m_nAddress = nAddress2;
-					ms.m_bFound = true;
-					continue;
-				}
-				else
-				{
-					bMatchAll = false;
-					break;
-				}
-			}
-			else
-			if (ms.m_iType == MEM_SEARCH_BYTE_1_WILD)
-			{
-				// match by definition
-			}
-			else
-			{
-				// start 2ndary search
-				// if next block matches, then this block matches (since we are wild)
-				if ((iBlock + 1) == nMemBlocks) // there is no next block, hence we match
-					continue;
+	int nFound = 0;
+	AddressPrefix_t addrPrefix;
 
-				for (uint32_t nAddress3 = nAddress2; nAddress3 < nAddressEnd; nAddress3++ )
-				{
-					if ((ms.m_iType == MEM_SEARCH_BYTE_EXACT    ) || 
-						(ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT) ||
-						(ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT ))
-					{
-						BYTE nTarget = ReadByteFromMemory(nAddress3);
-			
-						if (ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT)
-							nTarget &= 0x0F;
+	// Main, Aux & RamWorks banks
+	// . NB. MemGetBankPtr() flushes the mem cache to the back-buffers (incl. any Saturn bank currently mapped in)
+	// . NB. an unused (ie. not yet allocated) RamWorks III bank is skipped, as the guest has never written to it
+	const bool bIsIIe = IsAppleIIeOrAbove( GetApple2Type() );
+	for (UINT nBank = 0; nBank <= 0x100; nBank++)
+	{
+		const BYTE* const pBank = MemGetBankPtr( nBank );
+		if (!pBank)
+			continue;
 
-						if (ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT)
-							nTarget &= 0xF0;
-						
-						if (ms.m_nValue == nTarget)
-						{
-							nAddress2 = nAddress3;
-							continue;
-						}
-						else
-						{
-							bMatchAll = false;
-							break;
-						}
-					}
+		addrPrefix.nBank = nBank;
+		nFound += _SearchMemoryBank64K( pattern, pBank, (nBank > 0) || bIsIIe, nAddressStart, nAddressEnd, addrPrefix );
 
-				}
-			}
-		}
+		if (!bIsIIe)
+			break;	// No aux slot
+	}
+
+	// Slot-0 LC & Saturn banks
+	for (UINT nSlot = SLOT0; nSlot <= SLOT7; nSlot++)
+	{
+		const SS_CARDTYPE type = GetCardMgr().QuerySlot( nSlot );
+		if (type != CT_LanguageCard && type != CT_Saturn128K)
+			continue;
 
-		if (bMatchAll)
+		addrPrefix.Clear();
+		if (type == CT_Saturn128K)
+			addrPrefix.nSlot = nSlot;
+
+		for (UINT nBank = 0; nBank < Saturn128K::kMaxSaturnBanks; nBank++)
 		{
-			nFound++;
+			const BYTE* const pBank = GetCardMgr().GetLanguageCardMgr().GetBankPtr( nSlot, nBank );
+			if (!pBank)
+				break;
 
-			// Save the search result
-			g_vMemorySearchResults.push_back( nAddress );
+			if (type == CT_Saturn128K)
+				addrPrefix.nBank = nBank;
+			nFound += _SearchMemoryBank16K( pattern, pBank, nAddressStart, nAddressEnd, addrPrefix );
 		}
 	}
 
@@ -6115,7 +6315,8 @@ Update_t _SearchMemoryDisplay (int nArgs)
 		int iFound = 1;
 		while (iFound <= nFound)
 		{
-			WORD const nAddress = g_vMemorySearchResults.at( iFound );
+			const MemorySearchResult_t& result = g_vMemorySearchResults.at( iFound );
+			WORD const nAddress = result.m_nAddress;
 
 			// 2.6.2.17 Search Results: The n'th result now using correct color (was command, now number decimal)
 			// BUGFIX: 2.6.2.32 n'th Search results were being displayed in dec, yet parser takes hex numbers. i.e. SH D000:FFFF A9 00
@@ -6124,8 +6325,20 @@ Update_t _SearchMemoryDisplay (int nArgs)
 			// 2.6.2.15 Fixed: Search Results: Added space between results for better readability
 
 			// FIXME: Color is DEC whereas the format is "%X". What's the real intention?
-			std::string sResult = StrFormat( CHC_NUM_DEC "%02X" CHC_DEFAULT ":" CHC_ARG_SEP "$" CHC_ADDRESS "%04X ",
-											 iFound, nAddress );
+			std::string sResult;
+			if (result.m_addrPrefix.nSlot == AddressPrefix_t::kSlotInvalid
+			 && result.m_addrPrefix.nBank == AddressPrefix_t::kBankInvalid
+			 && result.m_addrPrefix.nLangCard == AddressPrefix_t::kLangCardInvalid)
+			{
+				sResult = StrFormat( CHC_NUM_DEC "%02X" CHC_DEFAULT ":" CHC_ARG_SEP "$" CHC_ADDRESS "%04X ",
+									 iFound, nAddress );
+			}
+			else
+			{
+				// 2.9.4.5 Search Results: bank:address, using the same "sN/bb/lN/" form as the address prefix
+				sResult = StrFormat( CHC_NUM_DEC "%02X" CHC_DEFAULT ":" CHC_ARG_SEP "%s ",
+									 iFound, GetFullPrefixAddrForBreakpoint( result.m_addrPrefix, nAddress, DEVICE_e::DEV_MEMORY, false ).c_str() );
+			}
 
 			// Fit on same line?
 			if ((sMatches.length() + sResult.length()) > (size_t(g_nConsoleDisplayWidth) - 1)) // CONSOLE_WIDTH
@@ -6158,7 +6371,7 @@ Update_t _SearchMemoryDisplay (int nArgs)
 
 
 //===========================================================================
-Update_t _CmdMemorySearch (int nArgs, bool bTextIsAscii = true )
+Update_t _CmdMemorySearch (int nArgs, bool bTextIsAscii = true, bool bAllBanks = false )
 {
 	WORD nAddressStart = 0;
 	WORD nAddress2   = 0;
@@ -6309,7 +6522,7 @@ Update_t _CmdMemorySearch (int nArgs, bool bTextIsAscii = true )
 		tLastType = ms.m_iType;
 	}
 
-	_SearchMemoryFind( vMemorySearchValues, nAddressStart, nAddressEnd );
+	_SearchMemoryFind( vMemorySearchValues, nAddressStart, nAddressEnd, bAllBanks );
 	vMemorySearchValues.clear();
 
 	return _SearchMemoryDisplay();
@@ -6358,6 +6571,16 @@ Update_t CmdMemorySearchHex (int nArgs)
 	return _CmdMemorySearch( nArgs, true );
 }
 
+// Search all physical banks: main, aux, RamWorks, LC & Saturn
+//===========================================================================
+Update_t CmdMemorySearchAll (int nArgs)
+{
+	if (nArgs < 4)
+		return HelpLastCommand();
+
+	return _CmdMemorySearch( nArgs, true, true );
+}
+
 
 // Registers ______________________________________________________________________________________
 
@@ -6872,11 +7095,10 @@ int FindSourceLine ( WORD nAddress )
 	return iSourceLine;
 }
 
+// Parse all the source lines, bytes & symbols into the cache
 //===========================================================================
-bool ParseAssemblyListing ( bool bBytesToMemory, bool bAddSymbols )
+static void _ParseAssemblyListingText ( SymbolCache_t& cache )
 {
-	bool bStatus = false; // true = loaded
-
 	// Assembler source listing file:
 	//
 	// xxxx:_b1_[b2]_[b3]__n_[label]_[opcode]_[param]
@@ -6893,9 +7115,6 @@ bool ParseAssemblyListing ( bool bBytesToMemory, bool bAddSymbols )
 	char  sText[ MAX_LINE ];
 //	char  sLabel[ MAX_LINE ];
 
-	g_nSourceAssembleBytes = 0;
-	g_nSourceAssemblySymbols = 0;
-
 	const uint32_t INVALID_ADDRESS = _6502_MEM_END + 1;
 
 	int nLines = g_AssemblerSourceBuffer.GetNumLines();
@@ -6917,91 +7136,121 @@ bool ParseAssemblyListing ( bool bBytesToMemory, bool bAddSymbols )
 			if (nAddress >= INVALID_ADDRESS) // || (sName[0] == 0) )
 				continue;
 
-			if (bBytesToMemory)
+			char *pEnd = p + 1;				
+			char *pStart;
+			int  iByte;
+			for (iByte = 0; iByte < 4; iByte++ ) // BUG: Some assemblers also put 4 bytes on a line
 			{
-				char *pEnd = p + 1;				
-				char *pStart;
-				int  iByte;
-				for (iByte = 0; iByte < 4; iByte++ ) // BUG: Some assemblers also put 4 bytes on a line
+				// xx xx xx
+				// ^ ^
+				// | |
+				// | end
+				// start
+				pStart = pEnd + 1;
+				pEnd = const_cast<char*>( SkipUntilWhiteSpace( pStart ));
+				int nLen = (int) (pEnd - pStart);
+				if (nLen != 2)
 				{
-					// xx xx xx
-					// ^ ^
-					// | |
-					// | end
-					// start
-					pStart = pEnd + 1;
-					pEnd = const_cast<char*>( SkipUntilWhiteSpace( pStart ));
-					int nLen = (int) (pEnd - pStart);
-					if (nLen != 2)
-					{
-						break;
-					}
-					*pEnd = 0;
-					if (TextIsHexByte( pStart ))
-					{
-						BYTE nByte = TextConvert2CharsToByte( pStart );
-						WriteByteToMemory(((WORD)nAddress) + iByte, nByte);
-					}
+					break;
+				}
+				*pEnd = 0;
+				if (TextIsHexByte( pStart ))
+				{
+					BYTE nByte = TextConvert2CharsToByte( pStart );
+					cache.AddByte( ((WORD)nAddress) + iByte, nByte );
 				}
-				g_nSourceAssembleBytes += iByte;
 			}
 
-			g_aSourceDebug[ (WORD) nAddress ] = iLine; // g_nSourceAssemblyLines;
+			cache.AddLine( (WORD) nAddress, iLine ); // g_nSourceAssemblyLines;
 		}
 
 		strcpy( sLine, sText );
-		if (bAddSymbols)
-		{
-			// Add user symbol:          symbolname EQU $address
-			//  or user symbol: address: symbolname DFB #bytes
- 			char *pEQU = strstr( sLine, "EQU" ); // EQUal / EQUate
-			char *pDFB = strstr( sLine, "DFB" ); // DeFine Byte
-			char *pLabel = NULL;
-
-			if (pEQU)
-				pLabel = pEQU;
-			if (pDFB)
-				pLabel = pDFB;
-
-			if (pLabel)
-			{	
-				char *pLabelEnd = pLabel - 1;
-				pLabelEnd = const_cast<char*>( SkipWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] ));
-				char * pLabelStart = NULL; // SkipWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] );
-				if (pLabelEnd)
+		// Add user symbol:          symbolname EQU $address
+		//  or user symbol: address: symbolname DFB #bytes
+		char *pEQU = strstr( sLine, "EQU" ); // EQUal / EQUate
+		char *pDFB = strstr( sLine, "DFB" ); // DeFine Byte
+		char *pLabel = NULL;
+
+		if (pEQU)
+			pLabel = pEQU;
+		if (pDFB)
+			pLabel = pDFB;
+
+		if (pLabel)
+		{	
+			char *pLabelEnd = pLabel - 1;
+			pLabelEnd = const_cast<char*>( SkipWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] ));
+			char * pLabelStart = NULL; // SkipWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] );
+			if (pLabelEnd)
+			{
+				pLabelStart = const_cast<char*>( SkipUntilWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] ));
+				pLabelEnd++;
+				pLabelStart++;
+				
+				int nLen = (int) (pLabelEnd - pLabelStart);
+				nLen = MIN( nLen, MAX_SYMBOLS_LEN );
+				strncpy( sName, pLabelStart, nLen );
+				sName[ nLen - 1 ] = 0;
+
+				char *pAddressEQU = strstr( pLabel, "$" );
+				char *pAddressDFB = strstr( sLine, ":" ); // Get address from start of line
+				char *pAddress = NULL;
+
+				if (pAddressEQU)
+					pAddress = pAddressEQU + 1;
+				if (pAddressDFB)
 				{
-					pLabelStart = const_cast<char*>( SkipUntilWhiteSpaceReverse( pLabelEnd, &sLine[ 0 ] ));
-					pLabelEnd++;
-					pLabelStart++;
-					
-					int nLen = (int) (pLabelEnd - pLabelStart);
-					nLen = MIN( nLen, MAX_SYMBOLS_LEN );
-					strncpy( sName, pLabelStart, nLen );
-					sName[ nLen - 1 ] = 0;
-
-					char *pAddressEQU = strstr( pLabel, "$" );
-					char *pAddressDFB = strstr( sLine, ":" ); // Get address from start of line
-					char *pAddress = NULL;
-
-					if (pAddressEQU)
-						pAddress = pAddressEQU + 1;
-					if (pAddressDFB)
-					{
-						*pAddressDFB = 0;
-						pAddress = sLine;
-					}
+					*pAddressDFB = 0;
+					pAddress = sLine;
+				}
 
-					if (pAddress)
-					{
-						char *pAddressEnd;
-						nAddress = (uint32_t) strtol( pAddress, &pAddressEnd, 16 );
-						g_aSymbols[ SYMBOLS_SRC_2 ][ (WORD) nAddress] = sName;
-						g_nSourceAssemblySymbols++;
-					}
+				if (pAddress)
+				{
+					char *pAddressEnd;
+					nAddress = (uint32_t) strtol( pAddress, &pAddressEnd, 16 );
+					cache.AddSymbol( (WORD) nAddress, sName );
 				}
 			}
 		}
 	} // for
+}
+
+//===========================================================================
+bool ParseAssemblyListing ( const std::string & sFileName, bool bBytesToMemory, bool bAddSymbols )
+{
+	bool bStatus = false; // true = loaded
+
+	g_nSourceAssembleBytes = 0;
+	g_nSourceAssemblySymbols = 0;
+
+	// Use the binary cache if it's up-to-date, else parse the text & (re)create the cache
+	SymbolCache_t cache;
+	if (! cache.Open( sFileName ))
+	{
+		_ParseAssemblyListingText( cache );
+		cache.Write( sFileName );
+	}
+
+	if (bBytesToMemory)
+	{
+		for (UINT iByte = 0; iByte < cache.GetNumBytes(); iByte++)
+			WriteByteToMemory( cache.GetByteAddress( iByte ), cache.GetByte( iByte ) );
+
+		g_nSourceAssembleBytes = (int) cache.GetNumBytes();
+	}
+
+	for (UINT iLine = 0; iLine < cache.GetNumLines(); iLine++)
+		g_aSourceDebug[ cache.GetLineAddress( iLine ) ] = cache.GetLine( iLine );
+
+	if (bAddSymbols)
+	{
+		// Add user symbol:          symbolname EQU $address
+		//  or user symbol: address: symbolname DFB #bytes
+		for (UINT iSymbol = 0; iSymbol < cache.GetNumSymbols(); iSymbol++)
+			g_aSymbols[ SYMBOLS_SRC_2 ][ (WORD) cache.GetSymbolAddress( iSymbol ) ] = cache.GetSymbolName( iSymbol );
+
+		g_nSourceAssemblySymbols = (int) cache.GetNumSymbols();
+	}
 
 	bStatus = true;
 	
@@ -7047,7 +7296,7 @@ Update_t CmdSource (int nArgs)
 				{
 					g_aSourceFileName = pFileName;
 
-					if (! ParseAssemblyListing( g_bSourceAddMemory, g_bSourceAddSymbols ))
+					if (! ParseAssemblyListing( sFileName, g_bSourceAddMemory, g_bSourceAddSymbols ))
 					{
 						ConsoleBufferPushFormat( "Couldn't load filename: %s", sMiniFileName.c_str() );
 					}
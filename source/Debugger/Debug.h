@@ -14,6 +14,7 @@
 #include "Debugger_Display.h"
 #include "Debugger_Symbols.h"
 #include "Util_MemoryTextFile.h"
+#include "Util_SymbolCache.h"
 #include "BreakpointCard.h"
 
 // Globals __________________________________________________________________
@@ -116,7 +117,7 @@
 	extern MemoryDump_t g_aMemDump[ NUM_MEM_DUMPS ];
 
 //	extern MemorySearchArray_t g_vMemSearchMatches;
-	extern std::vector<int> g_vMemorySearchResults;
+	extern MemorySearchResults_t g_vMemorySearchResults;
 
 // Source Level Debugging
 	extern std::string g_aSourceFileName;
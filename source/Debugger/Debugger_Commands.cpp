@@ -210,6 +210,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //		{"SA"          , CmdMemorySearchAscii,  CMD_MEMORY_SEARCH_ASCII  , "Search ASCII text"            },
 //		{"ST"          , CmdMemorySearchApple , CMD_MEMORY_SEARCH_APPLE  , "Search Apple text (hi-bit)"   },
 		{"SH"          , CmdMemorySearchHex   , CMD_MEMORY_SEARCH_HEX    , "Search memory for hex values" },
+		{"SALL"        , CmdMemorySearchAll   , CMD_MEMORY_SEARCH_ALL    , "Search all memory banks (main, aux, RamWorks, LC, Saturn)" },
 		{"F"           , CmdMemoryFill        , CMD_MEMORY_FILL          , "Memory fill"                  },
 
 		{"NTSC"        , CmdNTSC              , CMD_NTSC                 , "Save/Load the NTSC palette"   },
@@ -461,6 +462,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		{"EJECT"      , NULL, PARAM_DISK_EJECT     },
 		{"PROTECT"    , NULL, PARAM_DISK_PROTECT   },
 		{"READ"       , NULL, PARAM_DISK_READ      },
+		{"STATS"      , NULL, PARAM_DISK_STATS     },
 // Font (Config)
 		{"MODE"       , NULL, PARAM_FONT_MODE      }, // also INFO, CONSOLE, DISASM (from Window)
 // General
@@ -1101,6 +1101,29 @@ Update_t CmdHelpSpecific (int nArgs)
 			ConsolePrintFormat( "%s   %s              // list all addresses viewed as data", CHC_EXAMPLE, g_aCommands[ CMD_DISASM_LIST ].m_sName  );
 			break;
 
+	// Disk
+		case CMD_DISK:
+			ConsoleColorizePrintFormat( " Usage: %s [#]"                             , g_aParameters[ PARAM_DISK_SET_SLOT ].m_sName );
+			ConsoleBufferPush( "  Show [or set] the slot of the Disk II card for the other DISK commands" );
+			ConsoleColorizePrintFormat( " Usage: %s"                                 , g_aParameters[ PARAM_DISK_INFO     ].m_sName );
+			ConsoleColorizePrintFormat( " Usage: %s [%s | %s [\"filename\"]]"        , g_aParameters[ PARAM_DISK_STATS    ].m_sName
+				, g_aParameters[ PARAM_RESET ].m_sName
+				, g_aParameters[ PARAM_SAVE  ].m_sName
+			);
+			ConsoleBufferPush( "  Activity stats for all Disk II & hard disk drives, in emulated cycles" );
+			ConsoleBufferPushFormat( "  %s: clear the stats, %s: write them as CSV (default: DiskStats.csv)"
+				, g_aParameters[ PARAM_RESET ].m_sName
+				, g_aParameters[ PARAM_SAVE  ].m_sName
+			);
+			ConsoleColorizePrintFormat( " Usage: <#> %s"                             , g_aParameters[ PARAM_DISK_EJECT    ].m_sName );
+			ConsoleColorizePrintFormat( " Usage: <#> %s <0 | 1>"                     , g_aParameters[ PARAM_DISK_PROTECT  ].m_sName );
+			ConsoleColorizePrint( " Usage: <#> \"filename\"" );
+			Help_Examples();
+			ConsolePrintFormat( "%s   %s %s"      , CHC_EXAMPLE, pCommand->m_sName, g_aParameters[ PARAM_DISK_STATS ].m_sName );
+			ConsolePrintFormat( "%s   %s %s %s"   , CHC_EXAMPLE, pCommand->m_sName, g_aParameters[ PARAM_DISK_STATS ].m_sName, g_aParameters[ PARAM_RESET ].m_sName );
+			ConsolePrintFormat( "%s   %s %s %s \"stats.csv\"", CHC_EXAMPLE, pCommand->m_sName, g_aParameters[ PARAM_DISK_STATS ].m_sName, g_aParameters[ PARAM_SAVE ].m_sName );
+			break;
+
 	// Memory
 		case CMD_MEMORY_ENTER_BYTE:
 			ConsoleColorizePrint( " Usage: <address | symbol> ## [## ... ##]" );
@@ -1218,6 +1241,16 @@ Update_t CmdHelpSpecific (int nArgs)
 			ConsolePrintFormat( "%s   %s F000:FFFF C030"   , CHC_EXAMPLE, pCommand->m_sName );
 			ConsolePrintFormat( "%s   U @1 - 1"            , CHC_EXAMPLE                    );
 			break;
+		case CMD_MEMORY_SEARCH_ALL:
+			ConsoleColorizePrint( " Usage: range <\"ASCII text\" | 'apple text' | hex>" );
+			Help_Range();
+			ConsoleBufferPush( "  Searches main, aux, RamWorks, LC and Saturn banks" );
+			ConsoleBufferPush( "  Results are shown as: [sN/][bank/][lN/]address" );
+			ConsoleBufferPush( "  See: SH for hex & wildcard syntax" );
+			Help_Examples();
+			ConsolePrintFormat( "%s   %s 0:FFFF 4C ? ?0", CHC_EXAMPLE, pCommand->m_sName );
+			ConsolePrintFormat( "%s   %s 0:BFFF 'Apple'", CHC_EXAMPLE, pCommand->m_sName );
+			break;
 //		case CMD_MEMORY_SEARCH_APPLE:
 //			ConsoleBufferPushFormat( "Deprecated.  Use: %s", g_aCommands[ CMD_MEMORY_SEARCH ].m_sName );
 //			break;
@@ -0,0 +1,183 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 2009-2025, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Debugger memory search engine (used by S, SALL)
+ *
+ * . The search values are compiled into segments of fixed-length (mask,value) bytes, separated by "??" (any number of bytes)
+ * . Each segment is located with memchr() on its first exact byte (vectorised by the CRT), then verified
+ * . Memory is searched as flat buffers: either a copy of the current 64K view, or directly in each physical bank (see Debug.cpp)
+ */
+
+#include "StdAfx.h"
+
+#include "Debugger_MemorySearch.h"
+
+//===========================================================================
+void _SearchMemoryCompile (const MemorySearchValues_t& vMemorySearchValues, MemorySearchPattern_t& pattern_)
+{
+	pattern_.clear();
+	pattern_.push_back( MemorySearchSegment_t() );
+
+	for (size_t iValue = 0; iValue < vMemorySearchValues.size(); iValue++)
+	{
+		const MemorySearch_t& ms = vMemorySearchValues[ iValue ];
+		MemorySearchSegment_t& segment = pattern_.back();
+
+		BYTE nMask = 0xFF;
+		switch (ms.m_iType)
+		{
+		case MEM_SEARCH_BYTE_EXACT    : nMask = 0xFF; break;
+		case MEM_SEARCH_NIB_LOW_EXACT : nMask = 0x0F; break;
+		case MEM_SEARCH_NIB_HIGH_EXACT: nMask = 0xF0; break;
+		case MEM_SEARCH_BYTE_1_WILD   : nMask = 0x00; break;
+		case MEM_SEARCH_BYTE_N_WILD   :
+			// Leading or repeated "??" are redundant
+			if (!segment.vMask.empty())
+				pattern_.push_back( MemorySearchSegment_t() );
+			continue;
+		default:
+			_ASSERT(0);
+			continue;
+		}
+
+		segment.vMask.push_back( nMask );
+		segment.vValue.push_back( ms.m_nValue & nMask );
+	}
+
+	// Trailing "??" matches by definition
+	if (pattern_.back().vMask.empty())
+		pattern_.pop_back();
+
+	for (size_t iSegment = 0; iSegment < pattern_.size(); iSegment++)
+	{
+		MemorySearchSegment_t& segment = pattern_[ iSegment ];
+		segment.iFirstExact = -1;
+		for (size_t i = 0; i < segment.vMask.size(); i++)
+		{
+			if (segment.vMask[ i ] == 0xFF)
+			{
+				segment.iFirstExact = (int) i;
+				break;
+			}
+		}
+	}
+}
+
+//===========================================================================
+static inline bool _SearchMemoryMatchAt (const BYTE* pMem, const MemorySearchSegment_t& segment)
+{
+	const size_t nLen = segment.vMask.size();
+	for (size_t i = 0; i < nLen; i++)
+	{
+		if ((pMem[ i ] & segment.vMask[ i ]) != segment.vValue[ i ])
+			return false;
+	}
+	return true;
+}
+
+// Find first match of segment starting in [pBegin, pLastStart], where the match must also end before pBufferEnd
+//===========================================================================
+const BYTE* _SearchMemoryFindSegment (const BYTE* pBegin, const BYTE* pLastStart, const BYTE* pBufferEnd, const MemorySearchSegment_t& segment)
+{
+	const size_t nLen = segment.vMask.size();
+	if ((size_t)(pBufferEnd - pBegin) < nLen)
+		return NULL;
+
+	if (pLastStart > (pBufferEnd - nLen))
+		pLastStart = pBufferEnd - nLen;
+
+	if (segment.iFirstExact < 0)
+	{
+		for (const BYTE* p = pBegin; p <= pLastStart; p++)
+		{
+			if (_SearchMemoryMatchAt( p, segment ))
+				return p;
+		}
+		return NULL;
+	}
+
+	const int  iExact = segment.iFirstExact;
+	const BYTE nExact = segment.vValue[ iExact ];
+
+	const BYTE* p = pBegin;
+	while (p <= pLastStart)
+	{
+		const BYTE* pExact = (const BYTE*) memchr( p + iExact, nExact, (pLastStart - p) + 1 );
+		if (!pExact)
+			return NULL;
+
+		p = pExact - iExact;
+		if (_SearchMemoryMatchAt( p, segment ))
+			return p;
+		p++;
+	}
+
+	return NULL;
+}
+
+// Search a contiguous block of memory, which is mapped to 6502 addresses [nBlockAddr, nBlockAddr+nBlockLen)
+// . Only matches that start in [nAddressStart, nAddressEnd] are saved, but a match may extend beyond nAddressEnd
+//===========================================================================
+int _SearchMemoryBlock (
+	const MemorySearchPattern_t& pattern,
+	const BYTE* pBlock, const UINT nBlockAddr, const UINT nBlockLen,
+	const WORD nAddressStart, const WORD nAddressEnd,
+	const AddressPrefix_t& addrPrefix,
+	MemorySearchResults_t& vResults_ )
+{
+	if (pattern.empty() || !pBlock)
+		return 0;
+
+	const UINT nFirst = (nAddressStart > nBlockAddr) ? nAddressStart : nBlockAddr;
+	const UINT nLast  = (nAddressEnd < (nBlockAddr + nBlockLen - 1)) ? nAddressEnd : (nBlockAddr + nBlockLen - 1);
+	if (nFirst > nLast)
+		return 0;
+
+	const BYTE* const pBufferEnd = pBlock + nBlockLen;
+	const BYTE* const pLastStart = pBlock + (nLast - nBlockAddr);
+
+	int nFound = 0;
+	MemorySearchResult_t result;
+	result.m_addrPrefix = addrPrefix;
+
+	const BYTE* p = pBlock + (nFirst - nBlockAddr);
+	while ((p = _SearchMemoryFindSegment( p, pLastStart, pBufferEnd, pattern[0] )) != NULL)
+	{
+		// Subsequent segments just need to be found somewhere after the previous one
+		const BYTE* pNext = p + pattern[0].vMask.size();
+		for (size_t iSegment = 1; pNext && iSegment < pattern.size(); iSegment++)
+		{
+			pNext = _SearchMemoryFindSegment( pNext, pBufferEnd, pBufferEnd, pattern[ iSegment ] );
+			if (pNext)
+				pNext += pattern[ iSegment ].vMask.size();
+		}
+
+		// If a subsequent segment wasn't found, then it won't be found for any later start address either
+		if (!pNext)
+			break;
+
+		result.m_nAddress = (WORD) (nBlockAddr + (p - pBlock));
+		vResults_.push_back( result );
+		nFound++;
+		p++;
+	}
+
+	return nFound;
+}
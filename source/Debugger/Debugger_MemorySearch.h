@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Debugger_Types.h"
+
+// Memory Search __________________________________________________________
+
+	struct MemorySearchSegment_t
+	{
+		std::vector<BYTE> vMask;
+		std::vector<BYTE> vValue;
+		int               iFirstExact; // -1 if no exact byte to prefilter on (eg. "?1 ? C?")
+	};
+
+	typedef std::vector<MemorySearchSegment_t> MemorySearchPattern_t;
+
+	void _SearchMemoryCompile (const MemorySearchValues_t& vMemorySearchValues, MemorySearchPattern_t& pattern_);
+
+	// Find first match of segment starting in [pBegin, pLastStart], where the match must also end before pBufferEnd
+	const BYTE* _SearchMemoryFindSegment (const BYTE* pBegin, const BYTE* pLastStart, const BYTE* pBufferEnd, const MemorySearchSegment_t& segment);
+
+	// Search a contiguous block of memory, which is mapped to 6502 addresses [nBlockAddr, nBlockAddr+nBlockLen)
+	// . Only matches that start in [nAddressStart, nAddressEnd] are added to vResults_, but a match may extend beyond nAddressEnd
+	// . Returns the number of matches
+	int _SearchMemoryBlock (
+		const MemorySearchPattern_t& pattern,
+		const BYTE* pBlock, const UINT nBlockAddr, const UINT nBlockLen,
+		const WORD nAddressStart, const WORD nAddressEnd,
+		const AddressPrefix_t& addrPrefix,
+		MemorySearchResults_t& vResults_ );
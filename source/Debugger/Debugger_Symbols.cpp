@@ -551,6 +551,129 @@ Update_t _CmdSymbolsListTables (int nArgs, int bSymbolTables )
 }
 
 
+// Case-insensitive index of symbol names (for the duplicate symbol name check when loading a symbol table)
+// . Avoids a linear search of all symbol tables per symbol loaded, as done by FindAddressFromSymbol()
+// . Same priority as FindAddressFromSymbol(): highest (enabled) table first, then lowest address
+typedef std::map< std::string, std::pair<WORD, int> > SymbolNameIndex_t;
+
+//===========================================================================
+static std::string _SymbolNameIndexKey ( const char* pSymbol )
+{
+	std::string sKey( pSymbol );
+	for (size_t i = 0; i < sKey.length(); i++)
+		sKey[ i ] = (char) tolower( (unsigned char) sKey[ i ] );
+	return sKey;
+}
+
+//===========================================================================
+static void _SymbolNameIndexAdd ( SymbolNameIndex_t& index, const char* pSymbol, WORD nAddress, int iTable )
+{
+	if (! (g_bDisplaySymbolTables & (1 << iTable)))
+		return;
+
+	const std::pair<WORD, int> entry( nAddress, iTable );
+
+	SymbolNameIndex_t::iterator it = index.find( _SymbolNameIndexKey( pSymbol ) );
+	if (it == index.end())
+		index.insert( std::make_pair( _SymbolNameIndexKey( pSymbol ), entry ) );
+	else if ((iTable > it->second.second) || ((iTable == it->second.second) && (nAddress < it->second.first)))
+		it->second = entry;
+}
+
+//===========================================================================
+static void _SymbolNameIndexBuild ( SymbolNameIndex_t& index )
+{
+	index.clear();
+
+	for (int iTable = 0; iTable < NUM_SYMBOL_TABLES; iTable++)
+	{
+		SymbolTable_t :: iterator  iSymbol = g_aSymbols[iTable].begin();
+		while (iSymbol != g_aSymbols[iTable].end())
+		{
+			_SymbolNameIndexAdd( index, iSymbol->second.c_str(), iSymbol->first, iTable );
+			iSymbol++;
+		}
+	}
+}
+
+// Equivalent to FindAddressFromSymbol()
+//===========================================================================
+static bool _SymbolNameIndexFind ( SymbolNameIndex_t& index, const char* pSymbol, WORD* pAddress_, int* iTable_ )
+{
+	SymbolNameIndex_t::iterator it = index.find( _SymbolNameIndexKey( pSymbol ) );
+	if (it == index.end())
+		return false;
+
+	// The entry is stale if its address has since been re-assigned a different name
+	SymbolTable_t :: iterator  iSymbol = g_aSymbols[ it->second.second ].find( it->second.first );
+	if (iSymbol == g_aSymbols[ it->second.second ].end() || _stricmp( iSymbol->second.c_str(), pSymbol ))
+		return FindAddressFromSymbol( pSymbol, pAddress_, iTable_ );
+
+	*pAddress_ = it->second.first;
+	*iTable_ = it->second.second;
+	return true;
+}
+
+//===========================================================================
+static void _ParseSymbolTableText ( FILE* hFile, SymbolCache_t& cache )
+{
+	std::string sFormat1 = StrFormat( "%%x %%%ds", MAX_SYMBOLS_LEN ); // i.e. "%x %51s"
+	std::string sFormat2 = StrFormat( "%%%ds %%x", MAX_SYMBOLS_LEN ); // i.e. "%51s %x"
+
+	while ( !feof(hFile) )
+	{
+		// Support 2 types of symbols files:
+		// 1) AppleWin:
+		//    . 0000 SYMBOL
+		//    . FFFF SYMBOL
+		// 2) ACME:
+		//    . SYMBOL  =$0000; Comment
+		//    . SYMBOL  =$FFFF; Comment
+		//
+		uint32_t nAddress = _6502_MEM_END + 1; // default to invalid address
+		char  sName[ MAX_SYMBOLS_LEN+1 ]  = "";
+
+		const int MAX_LINE = 256;
+		char  szLine[ MAX_LINE ] = "";
+
+		if ( !fgets(szLine, MAX_LINE-1, hFile) )	// Get next line
+		{
+			//ConsolePrint("<<EOF");
+			break;
+		}
+
+		if (strstr(szLine, "$") == NULL)
+		{
+			sscanf(szLine, sFormat1.c_str(), &nAddress, sName);
+		}
+		else
+		{
+			char* p = strstr(szLine, "=");	// Optional
+			if (p) *p = ' ';
+			p = strstr(szLine, "$");
+			if (p) *p = ' ';
+			p = strstr(szLine, ";");		// Optional
+			if (p) *p = 0;
+			p = strstr(szLine, " ");		// 1st space between name & value
+			if (p)
+			{
+				int nLen = (int) (p - szLine);
+				if (nLen > MAX_SYMBOLS_LEN)
+				{
+					memset(&szLine[MAX_SYMBOLS_LEN], ' ', nLen - MAX_SYMBOLS_LEN);	// sscanf fails for nAddress if string too long
+				}
+			}
+			sscanf(szLine, sFormat2.c_str(), sName, &nAddress);
+		}
+
+		// NB. SymbolOffset is applied when the symbols are added to the table (so the cache is independent of it)
+		if (sName[0] == 0)
+			continue;
+
+		cache.AddSymbol( nAddress, sName );
+	}
+}
+
 //===========================================================================
 int ParseSymbolTable(const std::string & pPathFileName, SymbolTable_Index_e eSymbolTableWrite, int nSymbolOffset )
 {
@@ -563,138 +686,147 @@ int ParseSymbolTable(const std::string & pPathFileName, SymbolTable_Index_e eSym
 	if (pPathFileName.empty())
 		return nSymbolsLoaded;
 
-	std::string sFormat1 = StrFormat( "%%x %%%ds", MAX_SYMBOLS_LEN ); // i.e. "%x %51s"
-	std::string sFormat2 = StrFormat( "%%%ds %%x", MAX_SYMBOLS_LEN ); // i.e. "%51s %x"
+	// Use the binary cache if it's up-to-date, else parse the text & (re)create the cache
+	SymbolCache_t cache;
+	if (! cache.Open( pPathFileName ))
+	{
+		FILE *hFile = fopen( pPathFileName.c_str(), "rt" );
 
-	FILE *hFile = fopen( pPathFileName.c_str(), "rt" );
+		if ( !hFile )
+		{
+			if ( g_bSymbolsDisplayMissingFile )
+			{
+				// TODO: print filename! Bug #242 Help file (.chm) description for "Symbols" #242
+				ConsoleDisplayError( "Symbol File not found:" );
+				_PrintCurrentPath();
+				nSymbolsLoaded = -1; // HACK: ERROR: FILE NOT EXIST
+			}
+			return nSymbolsLoaded;
+		}
 
-	if ( !hFile && g_bSymbolsDisplayMissingFile )
-	{
-		// TODO: print filename! Bug #242 Help file (.chm) description for "Symbols" #242
-		ConsoleDisplayError( "Symbol File not found:" );
-		_PrintCurrentPath();
-		nSymbolsLoaded = -1; // HACK: ERROR: FILE NOT EXIST
+		_ParseSymbolTableText( hFile, cache );
+		fclose(hFile);
+
+		cache.Write( pPathFileName );
 	}
-	
+
+	SymbolNameIndex_t symbolNameIndex;
+	_SymbolNameIndexBuild( symbolNameIndex );
+
 	bool bDupSymbolHeader = false;
-	if ( hFile )
+	for ( UINT iSymbol = 0; iSymbol < cache.GetNumSymbols(); iSymbol++ )
 	{
-		while ( !feof(hFile) )
-		{
-			// Support 2 types of symbols files:
-			// 1) AppleWin:
-			//    . 0000 SYMBOL
-			//    . FFFF SYMBOL
-			// 2) ACME:
-			//    . SYMBOL  =$0000; Comment
-			//    . SYMBOL  =$FFFF; Comment
-			//
-			uint32_t nAddress = _6502_MEM_END + 1; // default to invalid address
-			char  sName[ MAX_SYMBOLS_LEN+1 ]  = "";
-
-			const int MAX_LINE = 256;
-			char  szLine[ MAX_LINE ] = "";
-
-			if ( !fgets(szLine, MAX_LINE-1, hFile) )	// Get next line
-			{
-				//ConsolePrint("<<EOF");
-				break;
-			}
+		const char* sName = cache.GetSymbolName( iSymbol );
 
-			if (strstr(szLine, "$") == NULL)
-			{
-				sscanf(szLine, sFormat1.c_str(), &nAddress, sName);
-			}
-			else
-			{
-				char* p = strstr(szLine, "=");	// Optional
-				if (p) *p = ' ';
-				p = strstr(szLine, "$");
-				if (p) *p = ' ';
-				p = strstr(szLine, ";");		// Optional
-				if (p) *p = 0;
-				p = strstr(szLine, " ");		// 1st space between name & value
-				if (p)
-				{
-					int nLen = (int) (p - szLine);
-					if (nLen > MAX_SYMBOLS_LEN)
-					{
-						memset(&szLine[MAX_SYMBOLS_LEN], ' ', nLen - MAX_SYMBOLS_LEN);	// sscanf fails for nAddress if string too long
-					}
-				}
-				sscanf(szLine, sFormat2.c_str(), sName, &nAddress);
-			}
+		// SymbolOffset
+		uint32_t nAddress = cache.GetSymbolAddress( iSymbol ) + nSymbolOffset;
+
+		if ( nAddress > _6502_MEM_END )
+			continue;
 
-			// SymbolOffset
-			nAddress += nSymbolOffset;
+		// 2.9.0.11 Bug #479
+		size_t nLen = strlen( sName );
+		if (nLen > nMaxLen)
+		{
+			ConsolePrintFormat( " %sWarn.: %s%s %s(%s%" SIZE_T_FMT " %s> %s%d%s)"
+				, CHC_WARNING
+				, CHC_SYMBOL
+				, sName
+				, CHC_ARG_SEP
+				, CHC_NUM_DEC
+				, nLen
+				, CHC_ARG_SEP
+				, CHC_NUM_DEC
+				, nMaxLen
+				, CHC_ARG_SEP
+			);
+			ConsoleUpdate(); // Flush buffered output so we don't ask the user to pause
+		}
 
-			if ( (nAddress > _6502_MEM_END) || (sName[0] == 0) )
-				continue;
+		int iTable = 0;
 
-			// 2.9.0.11 Bug #479
-			size_t nLen = strlen( sName );
-			if (nLen > nMaxLen)
+		// 2.8.0.5 Bug #244 (Debugger) Duplicate symbols for identical memory addresses in APPLE2E.SYM
+		std::string const* pSymbolPrev = FindSymbolFromAddress( (WORD)nAddress, &iTable ); // don't care which table it is in
+		if ( pSymbolPrev )
+		{
+			if ( !bFileDisplayed )
 			{
-				ConsolePrintFormat( " %sWarn.: %s%s %s(%s%" SIZE_T_FMT " %s> %s%d%s)"
-					, CHC_WARNING
-					, CHC_SYMBOL
-					, sName
-					, CHC_ARG_SEP
-					, CHC_NUM_DEC
-					, nLen
-					, CHC_ARG_SEP
-					, CHC_NUM_DEC
-					, nMaxLen
-					, CHC_ARG_SEP
+				bFileDisplayed = true;
+
+				ConsolePrintFormat( "%s%s"
+					, CHC_PATH
+					, pPathFileName.c_str()
 				);
-				ConsoleUpdate(); // Flush buffered output so we don't ask the user to pause
 			}
 
-			int iTable = 0;
+			ConsolePrintFormat( " %sInfo.: %s%-16s %saliases %s$%s%04X %s%-12s%s (%s%s%s)" // MAGIC NUMBER: -MAX_SYMBOLS_LEN
+				, CHC_INFO // 2.9.0.10 was CHC_WARNING, see #479
+				, CHC_SYMBOL
+				, sName
+				, CHC_INFO
+				, CHC_ARG_SEP
+				, CHC_ADDRESS
+				, nAddress
+				, CHC_SYMBOL
+				, pSymbolPrev->c_str()
+				, CHC_DEFAULT
+				, CHC_STRING
+				, g_aSymbolTableNames[ iTable ]
+				, CHC_DEFAULT
+			);
 
-			// 2.8.0.5 Bug #244 (Debugger) Duplicate symbols for identical memory addresses in APPLE2E.SYM
-			std::string const* pSymbolPrev = FindSymbolFromAddress( (WORD)nAddress, &iTable ); // don't care which table it is in
-			if ( pSymbolPrev )
-			{
-				if ( !bFileDisplayed )
-				{
-					bFileDisplayed = true;
+			ConsoleUpdate(); // Flush buffered output so we don't ask the user to pause
+/*
+			ConsolePrintFormat( " %sWarning: %sAddress already has symbol Name%s (%s%s%s): %s%s"
+				, CHC_WARNING
+				, CHC_INFO
+				, CHC_ARG_SEP
+				, CHC_STRING
+				, g_aSymbolTableNames[ iTable ]
+				, CHC_DEFAULT
+				, CHC_SYMBOL
+				, pSymbolPrev
+			);
 
-					ConsolePrintFormat( "%s%s"
-						, CHC_PATH
-						, pPathFileName.c_str()
-					);
-				}
+			ConsolePrintFormat( "  %s$%s%04X %s%-31s%s"
+				, CHC_ARG_SEP
+				, CHC_ADDRESS
+				, nAddress
+				, CHC_SYMBOL
+				, sName
+				, CHC_DEFAULT
+			);
+*/
+		}
 
-				ConsolePrintFormat( " %sInfo.: %s%-16s %saliases %s$%s%04X %s%-12s%s (%s%s%s)" // MAGIC NUMBER: -MAX_SYMBOLS_LEN
-					, CHC_INFO // 2.9.0.10 was CHC_WARNING, see #479
-					, CHC_SYMBOL
-					, sName
-					, CHC_INFO
-					, CHC_ARG_SEP
-					, CHC_ADDRESS
-					, nAddress
-					, CHC_SYMBOL
-					, pSymbolPrev->c_str()
+		// If updating symbol, print duplicate symbols
+		WORD nAddressPrev = 0;
+
+		bool bExists  = _SymbolNameIndexFind( symbolNameIndex, sName, &nAddressPrev, &iTable );
+		if ( bExists )
+		{
+			if ( !bDupSymbolHeader )
+			{
+				bDupSymbolHeader = true;
+				ConsolePrintFormat( "%s Dup Symbol Name%s (%s%s%s) %s"
+					, CHC_ERROR
 					, CHC_DEFAULT
 					, CHC_STRING
 					, g_aSymbolTableNames[ iTable ]
 					, CHC_DEFAULT
+					, pPathFileName.c_str()
 				);
-
-				ConsoleUpdate(); // Flush buffered output so we don't ask the user to pause
-/*
-				ConsolePrintFormat( " %sWarning: %sAddress already has symbol Name%s (%s%s%s): %s%s"
-					, CHC_WARNING
-					, CHC_INFO
+				ConsolePrintFormat( "%s  %s$%s%04X %s%-31s%s"
+					, CHC_ERROR
 					, CHC_ARG_SEP
-					, CHC_STRING
-					, g_aSymbolTableNames[ iTable ]
-					, CHC_DEFAULT
+					, CHC_ADDRESS
+					, nAddress
 					, CHC_SYMBOL
-					, pSymbolPrev
+					, sName
+					, CHC_DEFAULT
 				);
-
+			}
+			else
 				ConsolePrintFormat( "  %s$%s%04X %s%-31s%s"
 					, CHC_ARG_SEP
 					, CHC_ADDRESS
@@ -703,53 +835,13 @@ int ParseSymbolTable(const std::string & pPathFileName, SymbolTable_Index_e eSym
 					, sName
 					, CHC_DEFAULT
 				);
-*/
-			}
+		}
 
-			// If updating symbol, print duplicate symbols
-			WORD nAddressPrev = 0;
+		// else // It is not a bug to have duplicate addresses by different names
 
-			bool bExists  = FindAddressFromSymbol( sName, &nAddressPrev, &iTable );
-			if ( bExists )
-			{
-				if ( !bDupSymbolHeader )
-				{
-					bDupSymbolHeader = true;
-					ConsolePrintFormat( "%s Dup Symbol Name%s (%s%s%s) %s"
-						, CHC_ERROR
-						, CHC_DEFAULT
-						, CHC_STRING
-						, g_aSymbolTableNames[ iTable ]
-						, CHC_DEFAULT
-						, pPathFileName.c_str()
-					);
-					ConsolePrintFormat( "%s  %s$%s%04X %s%-31s%s"
-						, CHC_ERROR
-						, CHC_ARG_SEP
-						, CHC_ADDRESS
-						, nAddress
-						, CHC_SYMBOL
-						, sName
-						, CHC_DEFAULT
-					);
-				}
-				else
-					ConsolePrintFormat( "  %s$%s%04X %s%-31s%s"
-						, CHC_ARG_SEP
-						, CHC_ADDRESS
-						, nAddress
-						, CHC_SYMBOL
-						, sName
-						, CHC_DEFAULT
-					);
-			}
-	
-			// else // It is not a bug to have duplicate addresses by different names
-
-			g_aSymbols[ eSymbolTableWrite ] [ (WORD) nAddress ] = sName;
-			nSymbolsLoaded++; // TODO: FIXME: BUG: This is the total symbols read, not added
-		}
-		fclose(hFile);
+		g_aSymbols[ eSymbolTableWrite ] [ (WORD) nAddress ] = sName;
+		_SymbolNameIndexAdd( symbolNameIndex, sName, (WORD) nAddress, eSymbolTableWrite );
+		nSymbolsLoaded++; // TODO: FIXME: BUG: This is the total symbols read, not added
 	}
 
 	return nSymbolsLoaded;
@@ -504,6 +504,7 @@
 //		, CMD_MEMORY_SEARCH_ASCII   // Ascii Text
 //		, CMD_MEMORY_SEARCH_APPLE   // Flashing Chars, Hi-Bit Set
 		, CMD_MEMORY_SEARCH_HEX
+		, CMD_MEMORY_SEARCH_ALL
 		, CMD_MEMORY_FILL
 		, CMD_NTSC
 		, CMD_TEXT_SAVE
@@ -778,6 +779,7 @@
 	Update_t CmdMemorySearchAscii  (int nArgs);
 	Update_t CmdMemorySearchApple  (int nArgs);
 	Update_t CmdMemorySearchHex    (int nArgs);
+	Update_t CmdMemorySearchAll    (int nArgs);
 // Output/Scripts
 	Update_t CmdOutputCalc         (int nArgs);
 	Update_t CmdOutputEcho         (int nArgs);
@@ -1280,8 +1282,14 @@ const	DisasmData_t* pDisasmData; // If != NULL then bytes are marked up as data
 		bool           m_bFound  ; // 
 	};
 
-	typedef std::vector<MemorySearch_t> MemorySearchValues_t;
-	typedef std::vector<int>            MemorySearchResults_t;
+	struct MemorySearchResult_t
+	{
+		WORD            m_nAddress  ; // 6502 address of match
+		AddressPrefix_t m_addrPrefix; // bank/slot/LC of match (all invalid if found in current 64K view)
+	};
+
+	typedef std::vector<MemorySearch_t>       MemorySearchValues_t;
+	typedef std::vector<MemorySearchResult_t> MemorySearchResults_t;
 
 // Parameters _____________________________________________________________________________________
 
@@ -1459,6 +1467,7 @@ const	DisasmData_t* pDisasmData; // If != NULL then bytes are marked up as data
 		, PARAM_DISK_EJECT                     // DISK 1 EJECT
 		, PARAM_DISK_PROTECT                   // DISK 1 PROTECT
 		, PARAM_DISK_READ                      // DISK 1 READ Track Sector NumSectors MemAddress
+		, PARAM_DISK_STATS                     // DISK STATS [RESET | SAVE]
 	, _PARAM_DISK_END
 	,  PARAM_DISK_NUM = _PARAM_DISK_END - _PARAM_DISK_BEGIN
 
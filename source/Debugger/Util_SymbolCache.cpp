@@ -0,0 +1,343 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2014, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Binary cache for symbol tables & assembly listings
+ *
+ * File layout:
+ *   Header_t
+ *   Symbol_t[ nSymbols ]
+ *   Line_t  [ nLines ]
+ *   Byte_t  [ nBytes ]
+ *   char    [ nNamesSize ]	// null-terminated names
+ */
+
+#include "StdAfx.h"
+
+#include "Util_SymbolCache.h"
+#include "../Common.h"
+#include "StrFormat.h"
+
+// SymbolCache ____________________________________________________________________________________
+
+static const uint64_t kFNV1aBasis = 0xcbf29ce484222325ULL;
+
+//===========================================================================
+static uint64_t HashFNV1a( uint64_t nHash, const BYTE *pData, size_t nLen )
+{
+	for (size_t i = 0; i < nLen; i++)
+	{
+		nHash ^= pData[ i ];
+		nHash *= 0x100000001b3ULL;
+	}
+	return nHash;
+}
+
+//===========================================================================
+SymbolCache_t::SymbolCache_t()
+	: m_hFile( INVALID_HANDLE_VALUE )
+	, m_hMapping( NULL )
+	, m_pView( NULL )
+	, m_pSymbols( NULL )
+	, m_pLines( NULL )
+	, m_pBytes( NULL )
+	, m_pNames( NULL )
+	, m_nSymbols( 0 )
+	, m_nLines( 0 )
+	, m_nBytes( 0 )
+{
+}
+
+//===========================================================================
+SymbolCache_t::~SymbolCache_t()
+{
+	Close();
+}
+
+//===========================================================================
+bool SymbolCache_t::GetSourceInfo( const std::string & sSourcePathFileName, uint64_t & nSize_, uint64_t & nTime_ )
+{
+	return GetFileSizeAndLastWriteTime( sSourcePathFileName.c_str(), nSize_, nTime_ );	// NB. same check as the save-state cache (see YamlHelper)
+}
+
+// Hash of the source file's contents, for when the size & last write time are unchanged (eg. restored from a backup or VCS)
+//===========================================================================
+bool SymbolCache_t::GetSourceHash( const std::string & sSourcePathFileName, uint64_t & nHash_ )
+{
+	HANDLE hFile = CreateFile( sSourcePathFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	nHash_ = kFNV1aBasis;
+
+	BYTE aBuffer[ 16*1024 ];
+	DWORD nRead = 0;
+	bool bOK;
+	while ((bOK = ReadFile( hFile, aBuffer, sizeof(aBuffer), &nRead, NULL ) != FALSE) && nRead)
+		nHash_ = HashFNV1a( nHash_, aBuffer, nRead );
+
+	CloseHandle( hFile );
+	return bOK;
+}
+
+//===========================================================================
+// NB. Not next to the source file, as that's typically the (read-only) install dir
+std::string SymbolCache_t::GetCachePathFileName( const std::string & sSourcePathFileName )
+{
+	char szDir[ MAX_PATH ];
+	DWORD nLen = GetEnvironmentVariable( "LOCALAPPDATA", szDir, MAX_PATH );
+	if (nLen == 0 || nLen >= MAX_PATH)
+		nLen = GetTempPath( MAX_PATH, szDir );
+	if (nLen == 0 || nLen >= MAX_PATH)
+		return "";
+
+	std::string sCacheDir = szDir;
+	if (sCacheDir[ sCacheDir.size() - 1 ] != PATH_SEPARATOR)
+		sCacheDir += PATH_SEPARATOR;
+
+	sCacheDir += "AppleWin";
+	CreateDirectory( sCacheDir.c_str(), NULL );	// (fails if it already exists)
+	sCacheDir += PATH_SEPARATOR;
+	sCacheDir += "SymbolCache";
+	CreateDirectory( sCacheDir.c_str(), NULL );
+	sCacheDir += PATH_SEPARATOR;
+
+	// Key by the full source pathname (FNV-1a), as different dirs can have the same filename
+	char szFullPathName[ MAX_PATH ];
+	std::string sKey = sSourcePathFileName;
+	nLen = GetFullPathName( sSourcePathFileName.c_str(), MAX_PATH, szFullPathName, NULL );
+	if (nLen > 0 && nLen < MAX_PATH)
+		sKey = szFullPathName;
+
+	const size_t iFileName = sKey.find_last_of( "\\/" );
+	const std::string sFileName = (iFileName == std::string::npos) ? sKey : sKey.substr( iFileName + 1 );
+
+	for (size_t i = 0; i < sKey.size(); i++)
+		sKey[ i ] = (char) tolower( (BYTE) sKey[ i ] );	// NB. Windows paths are case-insensitive
+
+	const uint64_t nHash = HashFNV1a( kFNV1aBasis, (const BYTE*) sKey.data(), sKey.size() );
+
+	return sCacheDir + sFileName + StrFormat( ".%016llX.cache", (unsigned long long) nHash );
+}
+
+//===========================================================================
+bool SymbolCache_t::Open( const std::string & sSourcePathFileName )
+{
+	Close();
+
+	uint64_t nSourceSize, nSourceTime;
+	if (!GetSourceInfo( sSourcePathFileName, nSourceSize, nSourceTime ))
+		return false;
+
+	const std::string sCachePathFileName = GetCachePathFileName( sSourcePathFileName );
+
+	m_hFile = CreateFile( sCachePathFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER nFileSize;
+	if (!GetFileSizeEx( m_hFile, &nFileSize ) || nFileSize.QuadPart < (LONGLONG)sizeof(Header_t) || nFileSize.HighPart)
+	{
+		Close();
+		return false;
+	}
+
+	m_hMapping = CreateFileMapping( m_hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+	if (m_hMapping)
+		m_pView = (const BYTE*) MapViewOfFile( m_hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+	if (!m_pView)
+	{
+		Close();
+		return false;
+	}
+
+	const Header_t* pHeader = (const Header_t*) m_pView;
+
+	const uint64_t nExpectedSize = sizeof(Header_t)
+		+ (uint64_t)pHeader->nSymbols * sizeof(Symbol_t)
+		+ (uint64_t)pHeader->nLines   * sizeof(Line_t)
+		+ (uint64_t)pHeader->nBytes   * sizeof(Byte_t)
+		+ pHeader->nNamesSize;
+
+	if (pHeader->nMagic != kMagic
+		|| pHeader->nVersion != kVersion
+		|| pHeader->nSourceSize != nSourceSize
+		|| pHeader->nSourceTime != nSourceTime
+		|| nExpectedSize != (uint64_t)nFileSize.QuadPart)
+	{
+		Close();
+		return false;
+	}
+
+	// Only read the source once the cheap checks have passed
+	uint64_t nSourceHash;
+	if (!GetSourceHash( sSourcePathFileName, nSourceHash ) || pHeader->nSourceHash != nSourceHash)
+	{
+		Close();
+		return false;
+	}
+
+	m_nSymbols = pHeader->nSymbols;
+	m_nLines   = pHeader->nLines;
+	m_nBytes   = pHeader->nBytes;
+
+	const BYTE* p = m_pView + sizeof(Header_t);
+	m_pSymbols = (const Symbol_t*) p; p += m_nSymbols * sizeof(Symbol_t);
+	m_pLines   = (const Line_t*)   p; p += m_nLines   * sizeof(Line_t);
+	m_pBytes   = (const Byte_t*)   p; p += m_nBytes   * sizeof(Byte_t);
+	m_pNames   = (const char*)     p;
+
+	// Names must all be inside the (null-terminated) names block
+	bool bValid = (m_nSymbols == 0) || (pHeader->nNamesSize && m_pNames[ pHeader->nNamesSize - 1 ] == 0);
+	for (UINT i = 0; bValid && i < m_nSymbols; i++)
+		bValid = m_pSymbols[ i ].nName < pHeader->nNamesSize;
+
+	if (!bValid)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+//===========================================================================
+void SymbolCache_t::Close()
+{
+	if (m_pView)
+		UnmapViewOfFile( m_pView );
+	if (m_hMapping)
+		CloseHandle( m_hMapping );
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		CloseHandle( m_hFile );
+
+	m_pView = NULL;
+	m_hMapping = NULL;
+	m_hFile = INVALID_HANDLE_VALUE;
+
+	m_vSymbols.clear();
+	m_vLines.clear();
+	m_vBytes.clear();
+	m_vNames.clear();
+
+	UpdatePointers();
+}
+
+//===========================================================================
+bool SymbolCache_t::Write( const std::string & sSourcePathFileName )
+{
+	_ASSERT( !m_pView );
+
+	Header_t header;
+	memset( &header, 0, sizeof(header) );
+
+	if (!GetSourceInfo( sSourcePathFileName, header.nSourceSize, header.nSourceTime )
+		|| !GetSourceHash( sSourcePathFileName, header.nSourceHash ))
+		return false;
+
+	header.nMagic     = kMagic;
+	header.nVersion   = kVersion;
+	header.nSymbols   = (uint32_t) m_vSymbols.size();
+	header.nLines     = (uint32_t) m_vLines.size();
+	header.nBytes     = (uint32_t) m_vBytes.size();
+	header.nNamesSize = (uint32_t) m_vNames.size();
+
+	const std::string sCachePathFileName = GetCachePathFileName( sSourcePathFileName );
+
+	FILE *hFile = fopen( sCachePathFileName.c_str(), "wb" );
+	if (!hFile)
+		return false;
+
+	bool bOK = fwrite( &header, sizeof(header), 1, hFile ) == 1;
+	if (bOK && header.nSymbols)
+		bOK = fwrite( &m_vSymbols[0], sizeof(Symbol_t), header.nSymbols, hFile ) == header.nSymbols;
+	if (bOK && header.nLines)
+		bOK = fwrite( &m_vLines[0], sizeof(Line_t), header.nLines, hFile ) == header.nLines;
+	if (bOK && header.nBytes)
+		bOK = fwrite( &m_vBytes[0], sizeof(Byte_t), header.nBytes, hFile ) == header.nBytes;
+	if (bOK && header.nNamesSize)
+		bOK = fwrite( &m_vNames[0], 1, header.nNamesSize, hFile ) == header.nNamesSize;
+
+	fclose( hFile );
+
+	if (!bOK)
+		remove( sCachePathFileName.c_str() );	// Don't leave a truncated cache behind
+
+	return bOK;
+}
+
+//===========================================================================
+void SymbolCache_t::AddSymbol( uint32_t nAddress, const char *pName )
+{
+	_ASSERT( !m_pView );
+
+	Symbol_t symbol;
+	symbol.nAddress = nAddress;
+	symbol.nName = (uint32_t) m_vNames.size();
+	m_vSymbols.push_back( symbol );
+
+	m_vNames.insert( m_vNames.end(), pName, pName + strlen( pName ) + 1 );
+
+	UpdatePointers();
+}
+
+//===========================================================================
+void SymbolCache_t::AddLine( WORD nAddress, int iLine )
+{
+	_ASSERT( !m_pView );
+
+	Line_t line;
+	line.nAddress = nAddress;
+	line.iLine = (uint32_t) iLine;
+	m_vLines.push_back( line );
+
+	UpdatePointers();
+}
+
+//===========================================================================
+void SymbolCache_t::AddByte( WORD nAddress, BYTE nByte )
+{
+	_ASSERT( !m_pView );
+
+	Byte_t byte;
+	byte.nAddress = nAddress;
+	byte.nByte = nByte;
+	byte.nPad = 0;
+	m_vBytes.push_back( byte );
+
+	UpdatePointers();
+}
+
+// Point the accessors at the built vectors
+//===========================================================================
+void SymbolCache_t::UpdatePointers()
+{
+	m_nSymbols = (UINT) m_vSymbols.size();
+	m_nLines   = (UINT) m_vLines.size();
+	m_nBytes   = (UINT) m_vBytes.size();
+
+	m_pSymbols = m_nSymbols ? &m_vSymbols[0] : NULL;
+	m_pLines   = m_nLines   ? &m_vLines[0]   : NULL;
+	m_pBytes   = m_nBytes   ? &m_vBytes[0]   : NULL;
+	m_pNames   = m_vNames.size() ? &m_vNames[0] : NULL;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// Symbol Cache _____________________________________________________________
+
+	// Binary cache of a parsed symbol table or assembly listing, stored in the user's (writable) local app data:
+	//   %LOCALAPPDATA%\AppleWin\SymbolCache\<source filename>.<hash of source pathname>.cache
+	// . It is only used if the source file's size, last write time & contents hash (FNV-1a) match those recorded in the cache.
+	// . On load the cache is memory-mapped, so the source text is only hashed, not parsed.
+
+	class SymbolCache_t
+	{
+	public:
+		SymbolCache_t();
+		~SymbolCache_t();
+
+		bool Open( const std::string & sSourcePathFileName );	// true if an up-to-date cache was mapped
+		void Close();
+		bool Write( const std::string & sSourcePathFileName );	// (best-effort)
+
+		// Build (when parsing the source text)
+		void AddSymbol( uint32_t nAddress, const char *pName );
+		void AddLine  ( WORD nAddress, int iLine );
+		void AddByte  ( WORD nAddress, BYTE nByte );
+
+		// Access (either mapped or built)
+		UINT        GetNumSymbols() const { return m_nSymbols; }
+		uint32_t    GetSymbolAddress( UINT i ) const { return m_pSymbols[ i ].nAddress; }
+		const char *GetSymbolName   ( UINT i ) const { return m_pNames + m_pSymbols[ i ].nName; }
+
+		UINT        GetNumLines() const { return m_nLines; }
+		WORD        GetLineAddress( UINT i ) const { return m_pLines[ i ].nAddress; }
+		int         GetLine       ( UINT i ) const { return (int) m_pLines[ i ].iLine; }
+
+		UINT        GetNumBytes() const { return m_nBytes; }
+		WORD        GetByteAddress( UINT i ) const { return m_pBytes[ i ].nAddress; }
+		BYTE        GetByte       ( UINT i ) const { return m_pBytes[ i ].nByte; }
+
+	private:
+		struct Header_t
+		{
+			uint32_t nMagic;
+			uint32_t nVersion;
+			uint64_t nSourceSize;
+			uint64_t nSourceTime;
+			uint64_t nSourceHash;
+			uint32_t nSymbols;
+			uint32_t nLines;
+			uint32_t nBytes;
+			uint32_t nNamesSize;
+		};
+
+		struct Symbol_t
+		{
+			uint32_t nAddress;	// NB. before any symbol offset is applied
+			uint32_t nName;		// offset into names
+		};
+
+		struct Line_t
+		{
+			uint32_t nAddress;
+			uint32_t iLine;
+		};
+
+		struct Byte_t
+		{
+			uint16_t nAddress;
+			uint8_t  nByte;
+			uint8_t  nPad;
+		};
+
+		static bool GetSourceInfo( const std::string & sSourcePathFileName, uint64_t & nSize_, uint64_t & nTime_ );
+		static bool GetSourceHash( const std::string & sSourcePathFileName, uint64_t & nHash_ );
+		static std::string GetCachePathFileName( const std::string & sSourcePathFileName );
+		void UpdatePointers();
+
+		static const uint32_t kMagic   = 0x43535741;	// "AWSC"
+		static const uint32_t kVersion = 2;
+
+		// Built
+		std::vector<Symbol_t> m_vSymbols;
+		std::vector<Line_t  > m_vLines;
+		std::vector<Byte_t  > m_vBytes;
+		std::vector<char    > m_vNames;
+
+		// Mapped
+		HANDLE m_hFile;
+		HANDLE m_hMapping;
+		const BYTE *m_pView;
+
+		// Either
+		const Symbol_t *m_pSymbols;
+		const Line_t   *m_pLines;
+		const Byte_t   *m_pBytes;
+		const char     *m_pNames;
+		UINT m_nSymbols;
+		UINT m_nLines;
+		UINT m_nBytes;
+	};
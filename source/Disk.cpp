@@ -66,6 +66,7 @@ Disk2InterfaceCard::Disk2InterfaceCard(UINT slot) :
 	ResetSwitches();
 
 	m_floppyLatch = 0;
+	m_statsMotorOnCycle = 0;
 	m_saveDiskImage = true;	// Save the DiskImage name to Registry
 	m_saveDiskImageToRegistry = true;
 	m_diskLastCycle = 0;
@@ -347,13 +348,28 @@ void Disk2InterfaceCard::ReadTrack(const int drive, ULONG uExecutedCycles)
 		const UINT32 currentBitPosition = pFloppy->m_bitOffset;
 		const UINT32 currentBitTrackLength = pFloppy->m_bitCount;
 
-		ImageReadTrack(
-			pFloppy->m_imagehandle,
-			pDrive->m_phasePrecise,
-			pFloppy->m_trackimage,
-			&pFloppy->m_nibbles,
-			&pFloppy->m_bitCount,
-			m_enhanceDisk);
+		std::map<UINT, FloppyDisk::DirtyTrack>::const_iterator it = pFloppy->m_dirtyTracks.end();
+		if (CanDeferTrackWrite(*pFloppy))
+			it = pFloppy->m_dirtyTracks.find(ImagePhaseToTrack(pFloppy->m_imagehandle, pDrive->m_phasePrecise, false));
+
+		if (it != pFloppy->m_dirtyTracks.end())
+		{
+			// Written track that's not yet been written back to the image
+			memcpy(pFloppy->m_trackimage, &it->second.m_trackimage[0], it->second.m_nibbles);
+			pFloppy->m_nibbles = it->second.m_nibbles;
+		}
+		else
+		{
+			m_stats[drive].m_trackReads++;
+
+			ImageReadTrack(
+				pFloppy->m_imagehandle,
+				pDrive->m_phasePrecise,
+				pFloppy->m_trackimage,
+				&pFloppy->m_nibbles,
+				&pFloppy->m_bitCount,
+				m_enhanceDisk);
+		}
 
 		if (!ImageIsWOZ(pFloppy->m_imagehandle))
 		{
@@ -413,6 +429,8 @@ void Disk2InterfaceCard::EjectDiskInternal(const int drive)
 		pFloppy->m_imagehandle = NULL;
 	}
 
+	pFloppy->m_dirtyTracks.clear();
+
 	if (pFloppy->m_trackimage)
 	{
 		delete [] pFloppy->m_trackimage;
@@ -474,17 +492,86 @@ void Disk2InterfaceCard::WriteTrack(const int drive)
 			pDrive->m_phasePrecise,
 			pFloppy->m_trackimage,
 			pFloppy->m_nibbles);
+		m_stats[drive].m_trackWrites++;
 	}
 
 	pFloppy->m_trackimagedirty = false;
 }
 
-void Disk2InterfaceCard::FlushCurrentTrack(const int drive)
+// Only for images where a track maps directly to an area of the image
+// . WOZ: quarter tracks can share a track via the TMAP, so always write these through
+bool Disk2InterfaceCard::CanDeferTrackWrite(const FloppyDisk& floppy)
 {
-	FloppyDisk* pFloppy = &m_floppyDrive[drive].m_disk;
+	return floppy.m_imagehandle && !ImageIsWOZ(floppy.m_imagehandle);
+}
+
+// Called when the head moves off a track: rather than writing it to the image now, keep the dirty track in memory.
+// . Copy & format programs write many tracks in a row, and each ImageWriteTrack() denibblizes & writes to the file
+//   (or re-compresses the whole file for zip/gzip), so defer this until the drive has stopped spinning.
+void Disk2InterfaceCard::StoreCurrentTrack(const int drive)
+{
+	FloppyDrive* pDrive = &m_floppyDrive[drive];
+	FloppyDisk* pFloppy = &pDrive->m_disk;
 
-	if (pFloppy->m_trackimage && pFloppy->m_trackimagedirty)
+	if (!pFloppy->m_trackimage || !pFloppy->m_trackimagedirty)
+		return;
+
+	if (!CanDeferTrackWrite(*pFloppy))
+	{
 		WriteTrack(drive);
+		return;
+	}
+
+	const UINT track = ImagePhaseToTrack(pFloppy->m_imagehandle, pDrive->m_phasePrecise, false);
+	if (track >= ImageGetNumTracks(pFloppy->m_imagehandle))
+	{
+		_ASSERT(0);	// See WriteTrack()
+		return;
+	}
+
+	if (pFloppy->m_bWriteProtected)
+		return;
+
+	if (pFloppy->m_nibbles)
+	{
+		FloppyDisk::DirtyTrack& dirtyTrack = pFloppy->m_dirtyTracks[track];
+		dirtyTrack.m_phasePrecise = pDrive->m_phasePrecise;
+		dirtyTrack.m_nibbles = pFloppy->m_nibbles;
+		dirtyTrack.m_trackimage.assign(pFloppy->m_trackimage, pFloppy->m_trackimage + pFloppy->m_nibbles);
+	}
+
+	pFloppy->m_trackimagedirty = false;
+}
+
+// Write back all the stored tracks as a batch (in ascending track order)
+void Disk2InterfaceCard::WriteBackTracks(const int drive)
+{
+	FloppyDisk* pFloppy = &m_floppyDrive[drive].m_disk;
+
+	if (pFloppy->m_dirtyTracks.empty() || !pFloppy->m_imagehandle || pFloppy->m_bWriteProtected)
+		return;
+
+	for (std::map<UINT, FloppyDisk::DirtyTrack>::iterator it = pFloppy->m_dirtyTracks.begin(); it != pFloppy->m_dirtyTracks.end(); ++it)
+	{
+#if LOG_DISK_TRACKS
+		LOG_DISK("track $%02X write-back\r\n", it->first);
+#endif
+		ImageWriteTrack(
+			pFloppy->m_imagehandle,
+			it->second.m_phasePrecise,
+			&it->second.m_trackimage[0],
+			it->second.m_nibbles);
+		m_stats[drive].m_trackWrites++;
+	}
+
+	pFloppy->m_dirtyTracks.clear();
+}
+
+// Write the current track and any stored tracks back to the image
+void Disk2InterfaceCard::FlushCurrentTrack(const int drive)
+{
+	StoreCurrentTrack(drive);
+	WriteBackTracks(drive);
 }
 
 //===========================================================================
@@ -519,6 +606,11 @@ void __stdcall Disk2InterfaceCard::ControlMotor(WORD, WORD address, BYTE, BYTE,
 	{
 		m_floppyMotorOn = newState;
 		m_formatTrack.DriveNotWritingTrack();
+
+		if (m_floppyMotorOn)
+			m_statsMotorOnCycle = g_nCumulativeCycles;
+		else
+			StatsMotorOff(m_currDrive);
 	}
 
 	// NB. Motor off doesn't reset the Command Decoder like reset. (UTAIIe figures 9.7 & 9.8 chip C2)
@@ -664,7 +756,13 @@ void Disk2InterfaceCard::ControlStepperDeferred()
 	// apply magnet step, if any
 	if (newPhasePrecise != pDrive->m_phasePrecise)
 	{
-		FlushCurrentTrack(m_currDrive);
+		Disk2DriveStats& stats = m_stats[m_currDrive];
+		stats.m_quarterTrackSteps += (UINT) (fabs(newPhasePrecise - pDrive->m_phasePrecise) * 2);
+		const UINT newTrack = ((UINT)ceil(newPhasePrecise)) >> 1;	// See CImageBase::PhaseToTrack()
+		if (newTrack != (((UINT)ceil(pDrive->m_phasePrecise)) >> 1))
+			stats.m_seeks[MIN(newTrack, TRACKS_MAX - 1)]++;
+
+		StoreCurrentTrack(m_currDrive);
 		pDrive->m_phasePrecise = newPhasePrecise;
 		pFloppy->m_trackimagedata = false;
 		m_formatTrack.DriveNotWritingTrack();
@@ -718,6 +816,12 @@ bool __stdcall Disk2InterfaceCard::Enable(WORD, WORD address, BYTE, BYTE, ULONG
 	WORD newDrive = address & 1;
 	bool stateChanged = (newDrive != m_currDrive);
 
+	if (stateChanged && m_floppyMotorOn)
+	{
+		StatsMotorOff(m_currDrive);
+		m_statsMotorOnCycle = g_nCumulativeCycles;
+	}
+
 	m_currDrive = newDrive;
 #if LOG_DISK_ENABLE_DRIVE
 	LOG_DISK("%08X: enable drive: %d\r\n", (UINT32)g_nCumulativeCycles, m_currDrive);
@@ -997,6 +1101,10 @@ void Disk2InterfaceCard::SetProtect(const int drive, const bool bWriteProtect)
 	if (!IsDriveValid(drive))
 		return;
 
+	// Write any deferred tracks first: once write-protected, they can no longer be written back (and so would be lost)
+	if (bWriteProtect && !m_floppyDrive[drive].m_disk.m_bWriteProtected)
+		FlushCurrentTrack(drive);
+
 	m_floppyDrive[drive].m_disk.m_bWriteProtected = bWriteProtect;
 }
 
@@ -1131,6 +1239,7 @@ void __stdcall Disk2InterfaceCard::ReadWrite(WORD pc, WORD addr, BYTE bWrite, BY
 
 		m_floppyLatch = *(pFloppy->m_trackimage + pFloppy->m_byte);
 		m_diskLastReadLatchCycle = g_nCumulativeCycles;
+		m_stats[m_currDrive].m_nibblesRead++;
 
 #if LOG_DISK_NIBBLES_READ
   #if LOG_DISK_NIBBLES_USE_RUNTIME_VAR
@@ -1150,6 +1259,7 @@ void __stdcall Disk2InterfaceCard::ReadWrite(WORD pc, WORD addr, BYTE bWrite, BY
 
 		*(pFloppy->m_trackimage + pFloppy->m_byte) = m_floppyLatch;
 		pFloppy->m_trackimagedirty = true;
+		m_stats[m_currDrive].m_nibblesWritten++;
 
 		bool bIsSyncFF = false;
 #if LOG_DISK_NIBBLES_WRITE
@@ -1483,6 +1593,7 @@ void Disk2InterfaceCard::DataLatchReadWOZ(WORD pc, WORD addr, UINT bitCellRemain
 
 			if (m_shiftReg & 0x80)
 			{
+				m_stats[m_currDrive].m_nibblesRead++;
 				m_latchDelay = 7;
 				m_shiftReg = 0;
 #if LOG_DISK_NIBBLES_READ
@@ -1529,6 +1640,7 @@ void Disk2InterfaceCard::DataLoadWriteWOZ(WORD pc, WORD addr, UINT bitCellRemain
 	LOG_DISK("load shiftReg with %02X (was: %02X)\n", m_floppyLatch, m_shiftReg);
 #endif
 	m_shiftReg = m_floppyLatch;
+	m_stats[m_currDrive].m_nibblesWritten++;
 
 	floppy.m_longestSyncFFBitOffsetStart = -1;	// invalidate the track seam location after a write
 }
@@ -1803,6 +1915,8 @@ void Disk2InterfaceCard::Reset(const bool bIsPowerCycle)
 
 	ResetLogicStateSequencer();
 
+	ScheduleUpdateNow();	// flush any dirty tracks
+
 	if (bIsPowerCycle)	// GH#460
 	{
 		// NB. This doesn't affect the drive head (ie. drive's track position)
@@ -1821,6 +1935,16 @@ void Disk2InterfaceCard::Reset(const bool bIsPowerCycle)
 	GetFrame().FrameRefreshStatus(DRAW_TITLE);
 }
 
+void Disk2InterfaceCard::InitializeForLoadingSnapshot()
+{
+	Reset(false);
+
+	// LoadSnapshot() re-inserts the deferred stepper event, if there is one in the save-state
+	if (m_syncEvent.m_active)
+		g_SynchronousEventMgr.Remove(m_syncEvent.m_id);
+	m_deferredStepperEvent = false;
+}
+
 void Disk2InterfaceCard::ResetSwitches()
 {
 	m_currDrive = 0;
@@ -1831,6 +1955,34 @@ void Disk2InterfaceCard::ResetSwitches()
 
 //===========================================================================
 
+// End of a motor-on period: for the DOS 3.3 & ProDOS drivers this is (approximately) one read or write request
+void Disk2InterfaceCard::StatsMotorOff(const int drive)
+{
+	const UINT64 cycles = g_nCumulativeCycles - m_statsMotorOnCycle;
+	m_stats[drive].m_motorOnCycles += cycles;
+	m_stats[drive].m_motorOnLatency.Add(cycles);
+}
+
+Disk2DriveStats Disk2InterfaceCard::GetStats(const int drive) const
+{
+	Disk2DriveStats stats = m_stats[drive];
+
+	// Motor-on time is only accumulated when the motor stops, so add the period that's still in progress
+	if (m_floppyMotorOn && drive == m_currDrive)
+		stats.m_motorOnCycles += g_nCumulativeCycles - m_statsMotorOnCycle;
+
+	return stats;
+}
+
+void Disk2InterfaceCard::ResetStats()
+{
+	m_stats[DRIVE_1].Reset();
+	m_stats[DRIVE_2].Reset();
+	m_statsMotorOnCycle = g_nCumulativeCycles;
+}
+
+//===========================================================================
+
 bool Disk2InterfaceCard::UserSelectNewDiskImageOnly(const int drive, LPCSTR pszFilename, std::string& openFilename, DWORD flags)
 {
 	if (!IsDriveConnected(drive))
@@ -1995,11 +2147,18 @@ void Disk2InterfaceCard::Update(const ULONG cycles)
 
 		if (!m_floppyMotorOn && !pDrive->m_spinning)
 		{
-			// Motor off and not spinning: so write back any dirty track (GH#1444)
+			// Motor off and not spinning: so write back any dirty tracks as a batch (GH#1444)
 			// . this also supports the power-cycle case (where m_floppyMotorOn & m_spinning are instantaneously 0)
 			FlushCurrentTrack(loop);
 		}
 	}
+
+	// Only keep updating whilst a drive is spinning or its write-light is on (otherwise IORead/IOWrite will reschedule)
+	if (m_floppyDrive[DRIVE_1].m_spinning || m_floppyDrive[DRIVE_2].m_spinning ||
+		m_floppyDrive[DRIVE_1].m_writelight || m_floppyDrive[DRIVE_2].m_writelight)
+	{
+		ScheduleUpdateNow();
+	}
 }
 
 //===========================================================================
@@ -2158,6 +2317,7 @@ BYTE __stdcall Disk2InterfaceCard::IORead(WORD pc, WORD addr, BYTE bWrite, BYTE
 
 	UINT uSlot = ((addr & 0xff) >> 4) - 8;
 	Disk2InterfaceCard* pCard = (Disk2InterfaceCard*) MemGetSlotParameters(uSlot);
+	pCard->ScheduleUpdateNow();	// motor/write-light may change
 
 	ImageInfo* pImage = pCard->m_floppyDrive[pCard->m_currDrive].m_disk.m_imagehandle;
 	bool isWOZ = ImageIsWOZ(pImage);
@@ -2193,6 +2353,9 @@ BYTE __stdcall Disk2InterfaceCard::IORead(WORD pc, WORD addr, BYTE bWrite, BYTE
 		if (isWOZ && pCard->m_seqFunc.function != dataShiftWrite)
 			pCard->DataLatchReadWriteWOZ(pc, addr, bWrite, nExecutedCycles);
 
+		if (!pCard->m_seqFunc.writeMode)
+			pCard->m_stats[pCard->m_currDrive].m_latchReads++;
+
 		return pCard->m_floppyLatch;
 	}
 
@@ -2205,6 +2368,7 @@ BYTE __stdcall Disk2InterfaceCard::IOWrite(WORD pc, WORD addr, BYTE bWrite, BYTE
 
 	UINT uSlot = ((addr & 0xff) >> 4) - 8;
 	Disk2InterfaceCard* pCard = (Disk2InterfaceCard*) MemGetSlotParameters(uSlot);
+	pCard->ScheduleUpdateNow();	// motor/write-light may change
 
 	ImageInfo* pImage = pCard->m_floppyDrive[pCard->m_currDrive].m_disk.m_imagehandle;
 	bool isWOZ = ImageIsWOZ(pImage);
@@ -2369,6 +2533,10 @@ void Disk2InterfaceCard::SaveSnapshot(YamlSaveHelper& yamlSaveHelper)
 	yamlSaveHelper.SaveHexUint64(SS_YAML_KEY_DEFERRED_STEPPER_CYCLE, m_deferredStepperCumulativeCycles);	// v8
 	m_formatTrack.SaveSnapshot(yamlSaveHelper);	// v2
 
+	// Stored tracks aren't part of the save-state, so write them back now (the current track is saved below)
+	WriteBackTracks(DRIVE_1);
+	WriteBackTracks(DRIVE_2);
+
 	SaveSnapshotDriveUnit(yamlSaveHelper, DRIVE_1);
 	SaveSnapshotDriveUnit(yamlSaveHelper, DRIVE_2);
 }
@@ -2538,6 +2706,7 @@ bool Disk2InterfaceCard::LoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT versi
 	m_enhanceDisk		= yamlLoadHelper.LoadBool(SS_YAML_KEY_ENHANCE_DISK);
 	m_floppyLatch		= yamlLoadHelper.LoadUint(SS_YAML_KEY_FLOPPY_LATCH);
 	m_floppyMotorOn		= yamlLoadHelper.LoadBool(SS_YAML_KEY_FLOPPY_MOTOR_ON);
+	m_statsMotorOnCycle	= g_nCumulativeCycles;
 
 	if (version >= 2)
 	{
@@ -2598,5 +2767,7 @@ bool Disk2InterfaceCard::LoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT versi
 	if (m_deferredStepperEvent)
 		InsertSyncEvent();
 
+	ScheduleUpdateNow();
+
 	return true;
 }
@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "DiskLog.h"
 #include "DiskFormatTrack.h"
 #include "DiskImage.h"
+#include "DiskStats.h"
 #include "SynchronousEventManager.h"
 
 enum Drive_e
@@ -75,8 +76,17 @@ public:
 		m_longestSyncFFBitOffsetStart = -1;
 		m_initialBitOffset = 0;
 		m_revs = 0;
+		m_dirtyTracks.clear();
 	}
 
+	// A written track that is held in memory until it's written back to the image
+	struct DirtyTrack
+	{
+		float m_phasePrecise;		// phase passed to ImageWriteTrack()
+		int m_nibbles;
+		std::vector<BYTE> m_trackimage;
+	};
+
 public:
 	std::string m_imagename;	// <FILENAME> (ie. no extension)
 	std::string m_fullname;	// <FILENAME.EXT> or <FILENAME.zip>  : This is persisted to the snapshot file
@@ -96,6 +106,7 @@ public:
 	int m_longestSyncFFBitOffsetStart;
 	UINT m_initialBitOffset;	// debug
 	UINT m_revs;				// debug
+	std::map<UINT, DirtyTrack> m_dirtyTracks;	// track -> written track (not WOZ) / Written back as a batch by FlushCurrentTrack()
 };
 
 class FloppyDrive
@@ -140,6 +151,7 @@ public:
 	virtual ~Disk2InterfaceCard();
 
 	virtual void Reset(const bool powerCycle);
+	virtual void InitializeForLoadingSnapshot();
 
 	virtual void InitializeIO(LPBYTE pCxRomPeripheral);
 	virtual void Update(const ULONG nExecutedCycles);
@@ -183,6 +195,8 @@ public:
 	bool IsDriveConnected(int drive) { return m_floppyDrive[drive].m_isConnected; }
 	bool Get13SectorFirmware();
 	void Set13SectorFirmware(const bool is13Sector);
+	Disk2DriveStats GetStats(const int drive) const;	// Includes the current motor-on period
+	void ResetStats();
 
 	static const std::string& GetSnapshotCardNameOld();
 	static const std::string& GetSnapshotCardName();
@@ -214,6 +228,9 @@ private:
 	void AllocTrack(const int drive, const UINT minSize=NIBBLES_PER_TRACK);
 	void ReadTrack(const int drive, ULONG uExecutedCycles);
 	void WriteTrack(const int drive);
+	bool CanDeferTrackWrite(const FloppyDisk& floppy);
+	void StoreCurrentTrack(const int drive);
+	void WriteBackTracks(const int drive);
 	void ResetLogicStateSequencer();
 	UINT GetBitCellDelta(const ULONG uExecutedCycles);
 	void UpdateBitStreamPosition(FloppyDisk& floppy, const ULONG bitCellDelta);
@@ -232,6 +249,7 @@ private:
 	static int SyncEventCallback(int id, int cycles, ULONG uExecutedCycles);
 	void ControlStepperDeferred();
 	void ControlStepperLogging(WORD address, unsigned __int64 cumulativeCycles);
+	void StatsMotorOff(const int drive);
 
 	void PreJitterCheck(int phase, BYTE latch);
 	void AddJitter(int phase, FloppyDisk& floppy);
@@ -281,6 +299,9 @@ private:
 	FormatTrack m_formatTrack;
 	bool m_enhanceDisk;
 
+	Disk2DriveStats m_stats[NUM_DRIVES];
+	unsigned __int64 m_statsMotorOnCycle;	// Start of current motor-on period
+
 	static const UINT SPINNING_CYCLES = 1000*1000;		// 1M cycles = ~1.000s
 	static const UINT WRITELIGHT_CYCLES = 1000*1000;	// 1M cycles = ~1.000s
 	static const UINT MOTOR_ON_UNTIL_LSS_STABLE_CYCLES = 0x2EC;	// ~0x2EC-0x990 cycles (depending on card). See GH#864
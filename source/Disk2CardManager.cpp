@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Disk2CardManager.h"
 #include "Core.h"
 #include "CardManager.h"
+#include "CPU.h"
 #include "Disk.h"
 
 bool Disk2CardManager::IsConditionForFullSpeed()
@@ -48,13 +49,18 @@ bool Disk2CardManager::IsConditionForFullSpeed()
 	return false;
 }
 
-void Disk2CardManager::Update(const ULONG nExecutedCycles)
+// Only for the benchmark, which doesn't call CardManager::Update()
+void Disk2CardManager::Update()
 {
+	const UINT64 cycle = g_nCumulativeCycles;
+
 	for (UINT i = 0; i < NUM_SLOTS; i++)
 	{
 		if (GetCardMgr().QuerySlot(i) == CT_Disk2)
 		{
-			GetCardMgr().GetRef(i).Update(nExecutedCycles);
+			Card& card = GetCardMgr().GetRef(i);
+			if (cycle >= card.GetNextUpdateCycle())
+				card.ScheduledUpdate(cycle);
 		}
 	}
 }
@@ -7,7 +7,7 @@ public:
 	~Disk2CardManager() {}
 
 	bool IsConditionForFullSpeed();
-	void Update(const ULONG nExecutedCycles);
+	void Update();
 	bool GetEnhanceDisk();
 	void SetEnhanceDisk(bool enhanceDisk);
 	void LoadLastDiskImage();
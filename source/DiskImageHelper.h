@@ -367,7 +367,8 @@ public:
 	CImageHelperBase(const bool bIsFloppy) :
 		m_2IMGHelper(bIsFloppy),
 		m_Result2IMG(eMismatch),
-		m_WOZHelper()
+		m_WOZHelper(),
+		m_bBatchMode(false)
 	{
 	}
 	virtual ~CImageHelperBase()
@@ -379,6 +380,7 @@ public:
 	ImageError_e Open(LPCTSTR pszImageFilename, ImageInfo* pImageInfo, const bool bCreateIfNecessary, std::string& strFilenameInZip);
 	void Close(ImageInfo* pImageInfo);
 	bool WOZUpdateInfo(ImageInfo* pImageInfo, uint32_t& dwOffset);
+	void SetBatchMode(const bool bBatchMode) { m_bBatchMode = bBatchMode; }	// No message-boxes (eg. for the -index-images worker threads)
 
 	virtual CImageBase* Detect(LPBYTE pImage, uint32_t dwSize, const char* pszExt, uint32_t& dwOffset, ImageInfo* pImageInfo) = 0;
 	virtual CImageBase* GetImageForCreation(const char* pszExt, uint32_t* pCreateImageSize) = 0;
@@ -415,6 +417,7 @@ protected:
 	C2IMGHelper m_2IMGHelper;
 	eDetectResult m_Result2IMG;
 	CWOZHelper m_WOZHelper;
+	bool m_bBatchMode;
 };
 
 //-------------------------------------
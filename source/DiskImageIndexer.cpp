@@ -0,0 +1,453 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Batch disk image indexer
+ *
+ * The images are split into one job queue per worker thread. A worker takes jobs from the front of
+ * its own queue, and when that's empty it steals from the back of another worker's queue. So a worker
+ * that gets a run of 32MB .hdv images doesn't hold up the others once they've finished their .dsk's.
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "DiskImageIndexer.h"
+#include "Common.h"
+#include "DiskImageHelper.h"
+#include "Log.h"
+#include "ProDOS_Utils.h"
+
+#include "zlib.h"
+
+namespace
+{
+	class ImageIndexer;
+
+	const char* const g_imageExtensions[] = { ".dsk", ".do", ".po", ".nib", ".woz", ".2mg", ".2img", ".hdv" };
+
+	const char* const g_imageTypeNames[] = { "unknown", "do", "po", "nib1", "nib2", "hdv", "iie", "apl", "prg", "woz1", "woz2" };
+
+	struct IndexRecord
+	{
+		IndexRecord()
+			: size(0)
+			, crc(0)
+			, imageType(eImageUNKNOWN)
+			, isHardDisk(false)
+			, writeProtected(false)
+			, numTracks(0)
+			, numBlocks(0)
+			, isProDOS(false)
+		{
+		}
+
+		std::string pathname;
+		UINT size;
+		UINT crc;			// zlib crc32 of the whole file
+		eImageType imageType;
+		bool isHardDisk;
+		bool writeProtected;
+		UINT numTracks;		// floppy only
+		UINT numBlocks;		// sector-based images only
+		bool isProDOS;
+		std::string volumeName;
+		std::vector<ProDOS_CatalogEntry_t> catalog;
+		std::string status;
+	};
+
+	// Each worker owns its image helpers, since these (and their image types) keep per-image state
+	struct IndexWorker
+	{
+		IndexWorker(ImageIndexer* pIndexer, UINT id)
+			: pIndexer(pIndexer)
+			, id(id)
+			, hThread(NULL)
+		{
+			InitializeCriticalSection(&lock);
+			floppyHelper.SetBatchMode(true);
+			hardDiskHelper.SetBatchMode(true);
+		}
+
+		~IndexWorker()
+		{
+			DeleteCriticalSection(&lock);
+		}
+
+		ImageIndexer* pIndexer;
+		UINT id;
+		HANDLE hThread;
+		CRITICAL_SECTION lock;		// To guard /jobs/
+		std::deque<UINT> jobs;		// Indices into ImageIndexer::m_records
+		std::vector<BYTE> buffer;	// Re-used for each image
+		CDiskImageHelper floppyHelper;
+		CHardDiskImageHelper hardDiskHelper;
+	};
+
+	class ImageIndexer
+	{
+	public:
+		bool Run(const std::string& strDir, const std::string& strIndexFilename);
+
+	private:
+		void FindImages(const std::string& strDir);
+		static bool IsImageFilename(const std::string& strFilename, std::string& strExt);
+
+		static DWORD WINAPI WorkerThread(LPVOID lpParameter);
+		bool GetJob(IndexWorker& worker, UINT& job);
+		void IndexImage(IndexWorker& worker, IndexRecord& record);
+		static bool ReadImage(const std::string& strPathname, std::vector<BYTE>& buffer, const UINT maxSize, IndexRecord& record);
+
+		bool WriteIndex(const std::string& strIndexFilename);
+
+		std::vector<IndexRecord> m_records;
+		std::vector< std::unique_ptr<IndexWorker> > m_workers;
+	};
+
+	//-------------------------------------
+
+	bool ImageIndexer::IsImageFilename(const std::string& strFilename, std::string& strExt)
+	{
+		// As per CImageHelperBase::GetCharLowerExt()
+		const size_t pos = strFilename.rfind('.');
+		if (pos == std::string::npos)
+			return false;
+
+		char szExt[_MAX_EXT] = "";
+		strncpy(szExt, strFilename.c_str() + pos, _MAX_EXT);
+		szExt[_MAX_EXT - 1] = 0;
+		CharLowerBuff(szExt, (uint32_t)strlen(szExt));
+		strExt = szExt;
+
+		for (UINT i = 0; i < sizeof(g_imageExtensions) / sizeof(g_imageExtensions[0]); i++)
+		{
+			if (strExt == g_imageExtensions[i])
+				return true;
+		}
+
+		return false;
+	}
+
+	void ImageIndexer::FindImages(const std::string& strDir)
+	{
+		WIN32_FIND_DATA findData;
+		HANDLE hFind = FindFirstFile((strDir + PATH_SEPARATOR + "*").c_str(), &findData);
+		if (hFind == INVALID_HANDLE_VALUE)
+			return;
+
+		do
+		{
+			const std::string strName = findData.cFileName;
+			if (strName == "." || strName == "..")
+				continue;
+
+			const std::string strPathname = strDir + PATH_SEPARATOR + strName;
+
+			std::string strExt;
+			if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			{
+				FindImages(strPathname);
+			}
+			else if (IsImageFilename(strName, strExt))
+			{
+				m_records.push_back(IndexRecord());
+				m_records.back().pathname = strPathname;
+			}
+		}
+		while (FindNextFile(hFind, &findData));
+
+		FindClose(hFind);
+	}
+
+	//-------------------------------------
+
+	DWORD WINAPI ImageIndexer::WorkerThread(LPVOID lpParameter)
+	{
+		IndexWorker& worker = *(IndexWorker*)lpParameter;
+
+		UINT job;
+		while (worker.pIndexer->GetJob(worker, job))
+			worker.pIndexer->IndexImage(worker, worker.pIndexer->m_records[job]);
+
+		return 0;
+	}
+
+	// No jobs are added once the workers have started, so when all the queues are empty then we're done
+	bool ImageIndexer::GetJob(IndexWorker& worker, UINT& job)
+	{
+		bool found = false;
+
+		EnterCriticalSection(&worker.lock);
+		if (!worker.jobs.empty())
+		{
+			job = worker.jobs.front();
+			worker.jobs.pop_front();
+			found = true;
+		}
+		LeaveCriticalSection(&worker.lock);
+
+		for (UINT i = 1; !found && i < m_workers.size(); i++)
+		{
+			IndexWorker& victim = *m_workers[(worker.id + i) % m_workers.size()];
+
+			EnterCriticalSection(&victim.lock);
+			if (!victim.jobs.empty())
+			{
+				job = victim.jobs.back();
+				victim.jobs.pop_back();
+				found = true;
+			}
+			LeaveCriticalSection(&victim.lock);
+		}
+
+		return found;
+	}
+
+	//-------------------------------------
+
+	bool ImageIndexer::ReadImage(const std::string& strPathname, std::vector<BYTE>& buffer, const UINT maxSize, IndexRecord& record)
+	{
+		HANDLE hFile = CreateFile(strPathname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (hFile == INVALID_HANDLE_VALUE)
+		{
+			record.status = "unable to open";
+			return false;
+		}
+
+		DWORD sizeHigh = 0;
+		const DWORD size = GetFileSize(hFile, &sizeHigh);
+		if (sizeHigh || size == 0 || size > maxSize)
+		{
+			CloseHandle(hFile);
+			record.status = "bad size";
+			return false;
+		}
+
+		if (buffer.size() < size)
+			buffer.resize(size);
+
+		DWORD bytesRead = 0;
+		const bool res = !!ReadFile(hFile, &buffer[0], size, &bytesRead, NULL);
+		CloseHandle(hFile);
+
+		if (!res || bytesRead != size)
+		{
+			record.status = "read failed";
+			return false;
+		}
+
+		record.size = size;
+		return true;
+	}
+
+	void ImageIndexer::IndexImage(IndexWorker& worker, IndexRecord& record)
+	{
+		const UINT maxSize = std::max<UINT>(worker.floppyHelper.GetMaxImageSize(), worker.hardDiskHelper.GetMaxImageSize());
+		if (!ReadImage(record.pathname, worker.buffer, maxSize, record))
+			return;
+
+		LPBYTE pImage = &worker.buffer[0];
+		record.crc = crc32(0, pImage, record.size);
+
+		std::string strExt;
+		IsImageFilename(record.pathname, strExt);
+
+		// Detect: try as a floppy first (which includes WOZ chunk processing), then as a hard disk.
+		// NB. CDiskImageHelper matches a small .hdv, but only to reject it from a floppy drive.
+		ImageInfo imageInfo;
+		uint32_t offset = 0;
+		CImageBase* pImageType = NULL;
+
+		if (record.size <= worker.floppyHelper.GetMaxImageSize())
+			pImageType = worker.floppyHelper.Detect(pImage, record.size, strExt.c_str(), offset, &imageInfo);
+
+		if (pImageType && pImageType->GetType() != eImageHDV)
+		{
+			record.numTracks = worker.floppyHelper.GetNumTracksInImage(pImageType);
+		}
+		else
+		{
+			imageInfo = ImageInfo();
+			offset = 0;
+			pImageType = NULL;
+
+			if (record.size <= worker.hardDiskHelper.GetMaxImageSize())
+				pImageType = worker.hardDiskHelper.Detect(pImage, record.size, strExt.c_str(), offset, &imageInfo);
+
+			record.isHardDisk = (pImageType != NULL);
+		}
+
+		if (!pImageType)
+		{
+			record.status = "unsupported";
+			return;
+		}
+
+		record.imageType = pImageType->GetType();
+		record.writeProtected = imageInfo.bWriteProtected;
+		record.status = "ok";
+
+		if (record.imageType == eImageWOZ1 || record.imageType == eImageWOZ2)
+		{
+			// In batch mode Detect() doesn't ask about a bad CRC, so flag it here
+			const CWOZHelper::WOZHeader* pWozHdr = (const CWOZHelper::WOZHeader*) pImage;
+			if (pWozHdr->crc32 && // WOZ spec: CRC of 0 should be ignored
+				pWozHdr->crc32 != crc32(0, pImage + sizeof(CWOZHelper::WOZHeader), record.size - sizeof(CWOZHelper::WOZHeader)))
+				record.status = "woz crc mismatch";
+			return;
+		}
+
+		// Catalogue the sector-based images (offset skips any 2MG header)
+		if (record.imageType != eImageDO && record.imageType != eImagePO && record.imageType != eImageHDV)
+			return;
+
+		const UINT dataSize = record.size - offset;
+		record.numBlocks = dataSize / HD_BLOCK_SIZE;
+		record.isProDOS = ProDOS_GetCatalog(pImage + offset, dataSize, record.imageType == eImageDO, record.volumeName, record.catalog);
+	}
+
+	//-------------------------------------
+
+	bool ImageIndexer::WriteIndex(const std::string& strIndexFilename)
+	{
+		FILE* hFile = fopen(strIndexFilename.c_str(), "wt");
+		if (!hFile)
+			return false;
+
+		fprintf(hFile, "pathname,type,size,crc32,tracks,blocks,write_protected,volume,files,catalog,status\n");
+
+		for (UINT i = 0; i < m_records.size(); i++)
+		{
+			const IndexRecord& record = m_records[i];
+
+			// Quote the pathname, since it may contain commas
+			std::string strPathname;
+			for (size_t j = 0; j < record.pathname.size(); j++)
+			{
+				if (record.pathname[j] == '"')
+					strPathname += '"';
+				strPathname += record.pathname[j];
+			}
+
+			const char* pType = record.isHardDisk ? "hdv" : g_imageTypeNames[record.imageType];
+
+			// ProDOS filenames are only A-Z, 0-9 & '.', so space separated is unambiguous
+			std::string strCatalog;
+			for (size_t j = 0; j < record.catalog.size(); j++)
+			{
+				if (j)
+					strCatalog += ' ';
+				strCatalog += record.catalog[j].name;
+			}
+
+			fprintf(hFile, "\"%s\",%s,%u,%08X,%u,%u,%d,%s,%u,%s,%s\n",
+				strPathname.c_str(),
+				pType,
+				record.size,
+				record.crc,
+				record.numTracks,
+				record.numBlocks,
+				record.writeProtected ? 1 : 0,
+				record.isProDOS ? record.volumeName.c_str() : "",
+				(UINT)record.catalog.size(),
+				strCatalog.c_str(),
+				record.status.c_str());
+		}
+
+		const bool res = ferror(hFile) == 0;
+		fclose(hFile);
+		return res;
+	}
+
+	//-------------------------------------
+
+	bool ImageIndexer::Run(const std::string& strDir, const std::string& strIndexFilename)
+	{
+		const DWORD startTime = GetTickCount();
+
+		std::string strRoot = strDir;
+		while (strRoot.size() > 1 && strRoot[strRoot.size() - 1] == PATH_SEPARATOR)
+			strRoot.erase(strRoot.size() - 1);
+
+		FindImages(strRoot);
+
+		struct PathnameLess
+		{
+			bool operator()(const IndexRecord& a, const IndexRecord& b) const { return a.pathname < b.pathname; }
+		};
+		std::sort(m_records.begin(), m_records.end(), PathnameLess());
+
+		SYSTEM_INFO sysInfo;
+		GetSystemInfo(&sysInfo);
+		const UINT numRecords = (UINT) m_records.size();
+		const UINT numWorkers = std::max<UINT>(1, std::min<UINT>(sysInfo.dwNumberOfProcessors, numRecords));
+
+		// Give each worker a contiguous run of images (ie. mostly from the same directory)
+		for (UINT i = 0; i < numWorkers; i++)
+		{
+			m_workers.push_back(std::unique_ptr<IndexWorker>(new IndexWorker(this, i)));
+
+			const UINT first = (UINT)(((UINT64)numRecords * i) / numWorkers);
+			const UINT last = (UINT)(((UINT64)numRecords * (i + 1)) / numWorkers);
+			for (UINT job = first; job < last; job++)
+				m_workers[i]->jobs.push_back(job);
+		}
+
+		for (UINT i = 0; i < numWorkers; i++)
+		{
+			DWORD threadId;
+			m_workers[i]->hThread = CreateThread(NULL, 0, WorkerThread, m_workers[i].get(), 0, &threadId);
+		}
+
+		// If a thread failed to start then its queue just gets stolen by the others, or else run it here
+		bool anyThreads = false;
+		for (UINT i = 0; i < numWorkers; i++)
+		{
+			if (!m_workers[i]->hThread)
+				continue;
+			anyThreads = true;
+			WaitForSingleObject(m_workers[i]->hThread, INFINITE);
+			CloseHandle(m_workers[i]->hThread);
+			m_workers[i]->hThread = NULL;
+		}
+
+		if (!anyThreads)
+			WorkerThread(m_workers[0].get());
+
+		const bool res = WriteIndex(strIndexFilename);
+
+		LogFileOutput("IndexImages: %u images in %s, %u threads, %u ms: %s %s\n",
+			numRecords, strRoot.c_str(), numWorkers, GetTickCount() - startTime,
+			res ? "wrote" : "failed to write", strIndexFilename.c_str());
+
+		return res;
+	}
+}
+
+//=============================================================================
+
+bool DiskImageIndexer_Run(const std::string& strDir, const std::string& strIndexFilename)
+{
+	ImageIndexer indexer;
+	return indexer.Run(strDir, strIndexFilename);
+}
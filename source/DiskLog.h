@@ -18,9 +18,10 @@
 #define LOG_DISK_WOZ_TRACK_SEAM 1
 
 // __VA_ARGS__ not supported on MSVC++ .NET 7.x
+// NB. When compiled in, LOG_DISK is also filtered at runtime by the disk subsystem's log level (see command line: -log-level)
 #if (LOG_DISK_ENABLED)
 	#if !defined(_VC71)
-		#define LOG_DISK(format, ...) LOG(format, __VA_ARGS__)
+		#define LOG_DISK(...) LOG_SUBSYSTEM(LOG_SUBSYSTEM_DISK, LOG_LEVEL_DEBUG, __VA_ARGS__)
 	#else
 		#define LOG_DISK	 LogOutput
 	#endif
@@ -0,0 +1,95 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Disk II & hard disk activity statistics
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "DiskStats.h"
+
+void DiskLatencyHistogram::Reset()
+{
+	memset(m_bucket, 0, sizeof(m_bucket));
+	m_count = 0;
+	m_totalCycles = 0;
+	m_maxCycles = 0;
+}
+
+void DiskLatencyHistogram::Add(const UINT64 cycles)
+{
+	UINT bucket = 0;
+	while ((bucket < kNumBuckets - 1) && (cycles >> (bucket + 1)))
+		bucket++;
+
+	m_bucket[bucket]++;
+	m_count++;
+	m_totalCycles += cycles;
+	if (cycles > m_maxCycles)
+		m_maxCycles = cycles;
+}
+
+UINT64 DiskLatencyHistogram::GetPercentileCycles(const UINT percent) const
+{
+	if (!m_count)
+		return 0;
+
+	const UINT64 target = (m_count * percent + 99) / 100;	// round up, so that 100% is the last sample
+	UINT64 count = 0;
+
+	for (UINT bucket = 0; bucket < kNumBuckets; bucket++)
+	{
+		count += m_bucket[bucket];
+		if (count >= target)
+			return std::min<UINT64>(((UINT64)2 << bucket) - 1, m_maxCycles);
+	}
+
+	return m_maxCycles;
+}
+
+//===========================================================================
+
+void Disk2DriveStats::Reset()
+{
+	memset(m_seeks, 0, sizeof(m_seeks));
+	m_quarterTrackSteps = 0;
+	m_motorOnCycles = 0;
+	m_latchReads = 0;
+	m_nibblesRead = 0;
+	m_nibblesWritten = 0;
+	m_trackReads = 0;
+	m_trackWrites = 0;
+	m_motorOnLatency.Reset();
+}
+
+void HardDiskDriveStats::Reset()
+{
+	m_blocksRead = 0;
+	m_blocksWritten = 0;
+	m_errors = 0;
+	m_formats = 0;
+	m_readLatency.Reset();
+	m_writeLatency.Reset();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "DiskImage.h"	// TRACKS_MAX
+
+// Disk activity statistics, all times are in emulated cycles (see debugger: DISK STATS)
+
+class DiskLatencyHistogram
+{
+public:
+	DiskLatencyHistogram() { Reset(); }
+
+	void Reset();
+	void Add(const UINT64 cycles);
+
+	UINT64 GetCount() const { return m_count; }
+	UINT64 GetTotalCycles() const { return m_totalCycles; }
+	UINT64 GetMeanCycles() const { return m_count ? m_totalCycles / m_count : 0; }
+	UINT64 GetMaxCycles() const { return m_maxCycles; }
+	UINT64 GetPercentileCycles(const UINT percent) const;	// Upper bound of the bucket containing this percentile
+	UINT64 GetBucket(const UINT bucket) const { return m_bucket[bucket]; }
+
+	// bucket[n] counts latencies of [2^n .. 2^(n+1)-1] cycles (and bucket[0] also counts 0 cycles)
+	static const UINT kNumBuckets = 32;
+
+private:
+	UINT64 m_bucket[kNumBuckets];
+	UINT64 m_count;
+	UINT64 m_totalCycles;
+	UINT64 m_maxCycles;
+};
+
+struct Disk2DriveStats
+{
+	Disk2DriveStats() { Reset(); }
+	void Reset();
+
+	UINT64 m_seeks[TRACKS_MAX];			// # times the head arrived at each track
+	UINT64 m_quarterTrackSteps;			// # half-phase (quarter track) steps
+	UINT64 m_motorOnCycles;
+	UINT64 m_latchReads;				// # 6502 reads of the data latch (in read mode)
+	UINT64 m_nibblesRead;				// # complete nibbles shifted into the data latch
+	UINT64 m_nibblesWritten;
+	UINT64 m_trackReads;				// # tracks read from the image
+	UINT64 m_trackWrites;				// # tracks written back to the image
+	DiskLatencyHistogram m_motorOnLatency;	// Per motor-on period (ie. approximately per RWTS request)
+};
+
+struct HardDiskDriveStats
+{
+	HardDiskDriveStats() { Reset(); }
+	void Reset();
+
+	UINT64 m_blocksRead;
+	UINT64 m_blocksWritten;
+	UINT64 m_errors;
+	UINT64 m_formats;
+	DiskLatencyHistogram m_readLatency;		// From executing the cmd until the firmware sees it's not busy
+	DiskLatencyHistogram m_writeLatency;
+};
@@ -764,6 +764,10 @@ BYTE HarddiskInterfaceCard::CmdExecute(HardDiskDrive* pHDD, const ULONG nExecute
 #if DEBUG_SKIP_BUSY_STATUS
 				m_notBusyCycle = 0;
 #endif
+				pHDD->m_stats.m_blocksRead++;
+				pHDD->m_statsRequestBusy = true;
+				pHDD->m_statsRequestIsWrite = false;
+				pHDD->m_statsRequestCycle = g_nCumulativeCycles;
 			}
 			else
 			{
@@ -854,6 +858,10 @@ BYTE HarddiskInterfaceCard::CmdExecute(HardDiskDrive* pHDD, const ULONG nExecute
 #if DEBUG_SKIP_BUSY_STATUS
 				m_notBusyCycle = 0;
 #endif
+				pHDD->m_stats.m_blocksWritten++;
+				pHDD->m_statsRequestBusy = true;
+				pHDD->m_statsRequestIsWrite = true;
+				pHDD->m_statsRequestCycle = g_nCumulativeCycles;
 			}
 			else
 			{
@@ -873,6 +881,7 @@ BYTE HarddiskInterfaceCard::CmdExecute(HardDiskDrive* pHDD, const ULONG nExecute
 		{
 			const UINT numBlocks = GetImageSizeInBlocks(pHDD->m_imagehandle);
 			memset(pHDD->m_buf, 0, HD_BLOCK_SIZE);
+			pHDD->m_stats.m_formats++;
 			bool res = false;
 			m_notBusyCycle = g_nCumulativeCycles;
 
@@ -899,9 +908,21 @@ BYTE HarddiskInterfaceCard::CmdExecute(HardDiskDrive* pHDD, const ULONG nExecute
 		break;
 	}
 
+	if (pHDD->m_error != DEVICE_OK)
+		pHDD->m_stats.m_errors++;
+
 	return CmdStatus(pHDD);
 }
 
+void HarddiskInterfaceCard::ResetStats()
+{
+	for (UINT i = 0; i < NUM_HARDDISKS; i++)
+	{
+		m_hardDiskDrive[i].m_stats.Reset();
+		m_hardDiskDrive[i].m_statsRequestBusy = false;
+	}
+}
+
 BYTE HarddiskInterfaceCard::CmdStatus(HardDiskDrive* pHDD)
 {
 	BYTE r = 0;
@@ -910,10 +931,22 @@ BYTE HarddiskInterfaceCard::CmdStatus(HardDiskDrive* pHDD)
 		r = STATUS_ERROR;		// Firmware requires that b0=1 for an error
 
 	if (g_nCumulativeCycles <= m_notBusyCycle)
+	{
 		r |= STATUS_BUSY;		// Firmware requires that b7=1 for busy (eg. busy doing r/w DMA operation)
+	}
 	else
+	{
 		pHDD->m_status_next = DISK_STATUS_OFF; // TODO: FIXME: ??? YELLOW ??? WARNING
 
+		if (pHDD->m_statsRequestBusy)
+		{
+			// Firmware now sees the r/w request has completed
+			DiskLatencyHistogram& latency = pHDD->m_statsRequestIsWrite ? pHDD->m_stats.m_writeLatency : pHDD->m_stats.m_readLatency;
+			latency.Add(g_nCumulativeCycles - pHDD->m_statsRequestCycle);
+			pHDD->m_statsRequestBusy = false;
+		}
+	}
+
 	// Firmware requires that error code is [b6..1]
 	_ASSERT(pHDD->m_error <= ERRORCODE_MASK);
 	r |= (pHDD->m_error & ERRORCODE_MASK) << 1;
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Card.h"
 #include "DiskImage.h"
 #include "DiskImageHelper.h"
+#include "DiskStats.h"
 #include "MemoryDefs.h"	// APPLE_SLOT_SIZE
 
 enum HardDrive_e
@@ -71,6 +72,9 @@ public:
 		memset(m_buf, 0, sizeof(m_buf));
 		m_status_next = DISK_STATUS_OFF;
 		m_status_prev = DISK_STATUS_OFF;
+		m_statsRequestBusy = false;
+		m_statsRequestIsWrite = false;
+		m_statsRequestCycle = 0;
 	}
 
 	// From FloppyDisk
@@ -89,6 +93,11 @@ public:
 
 	Disk_Status_e m_status_next;
 	Disk_Status_e m_status_prev;
+
+	HardDiskDriveStats m_stats;		// NB. Not reset by clear(), so persists across image changes
+	bool m_statsRequestBusy;		// Read or write request that the firmware hasn't yet seen complete
+	bool m_statsRequestIsWrite;
+	UINT64 m_statsRequestCycle;
 };
 
 class HarddiskInterfaceCard : public Card
@@ -117,6 +126,8 @@ public:
 	void SetHdcFirmwareMode(HdcMode hdcMode);
 
 	void GetLightStatus(Disk_Status_e* pDisk1Status);
+	const HardDiskDriveStats& GetStats(const int iDrive) { return m_hardDiskDrive[iDrive].m_stats; }
+	void ResetStats();
 	bool ImageSwap();
 
 	void ForbidSaveDiskImageToRegistry() { m_saveDiskImageToRegistry = false; }
@@ -745,3 +745,20 @@ uint8_t LanguageCardManager::ReadByte(uint8_t slot, uint8_t bank, uint16_t phyAd
 	_ASSERT(0);
 	return 0;
 }
+
+// Returns the card's 16K bank: [$0000-0FFF] = LC1-4K, [$1000-3FFF] = LC2-4K & 8K
+// . NULL if no such bank, or for the //e's LC (which is in main mem)
+LPBYTE LanguageCardManager::GetBankPtr(uint8_t slot, uint8_t bank)
+{
+	if (slot > SLOT7)
+	{
+		_ASSERT(0);
+		return NULL;
+	}
+
+	const SS_CARDTYPE type = GetCardMgr().QuerySlot(slot);
+	if (type == CT_LanguageCard || type == CT_LanguageCardIIe || type == CT_Saturn128K)
+		return dynamic_cast<LanguageCardUnit&>(GetCardMgr().GetRef(slot)).GetBankPtr(bank);
+
+	return NULL;
+}
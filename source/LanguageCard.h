@@ -32,6 +32,7 @@ public:
 	SS_CARDTYPE GetMemoryType() { return QueryType(); }
 	bool IsOpcodeRMWabs(WORD addr);
 	uint8_t ReadByte(uint16_t phyAddr);
+	virtual LPBYTE GetBankPtr(UINT bank) { return (bank == 0) ? m_pMemory : NULL; }	// NULL for //e (LC is in main mem)
 
 	static BYTE __stdcall IO(WORD PC, WORD uAddr, BYTE bWrite, BYTE uValue, ULONG nExecutedCycles);
 
@@ -91,6 +92,7 @@ public:
 	virtual bool LoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT version);
 
 	virtual void SetMainMemLanguageCardMemory();
+	virtual LPBYTE GetBankPtr(UINT bank) { return (bank < m_uSaturnTotalBanks) ? m_aSaturnBanks[bank] : NULL; }
 
 	void SetMemMainLanguageCard();
 	uint8_t ReadByteFromBank(uint8_t bank, uint16_t phyAddr);
@@ -143,6 +145,7 @@ public:
 	void SetMemModeFromSnapshot();
 
 	uint8_t ReadByte(uint8_t slot, uint8_t bank, uint16_t phyAddr);
+	LPBYTE GetBankPtr(uint8_t slot, uint8_t bank);
 
 private:
 	LanguageCardUnit* m_pLanguageCard;
@@ -22,6 +22,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 
 /* Description: Log
+ *
+ * Logging is asynchronous once LogInit() has been called:
+ * . each thread has its own single-producer/single-consumer staging buffer, so logging takes no locks
+ * . only the format string & the raw arguments are captured (strings are copied), and formatting is deferred
+ * . a background thread periodically drains all the buffers, orders the messages, formats them, then writes them
  *
  * Author: Nick Westgate
  */
@@ -30,6 +35,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "Log.h"
 
+#include <atomic>
 #include <time.h>
 
 FILE* g_fh = NULL;
@@ -42,6 +48,540 @@ FILE* g_fh = NULL;
 #define LOG_FILENAME "/tmp/AppleWin.log"
 #endif
 
+LogLevel g_logLevels[NUM_LOG_SUBSYSTEMS] =
+{
+	LOG_LEVEL_DEBUG,	// Disk (NB. LOG_DISK is also compiled out by default - see DiskLog.h)
+	LOG_LEVEL_OFF,		// Uthernet2
+};
+
+static const char* const g_logSubsystemNames[NUM_LOG_SUBSYSTEMS] = { "disk", "uthernet2" };
+static const char* const g_logLevelNames[] = { "off", "warning", "info", "debug", "trace" };
+
+//---------------------------------------------------------------------------
+
+namespace
+{
+	enum
+	{
+		LOG_DEST_DEBUGGER = 1<<0,
+		LOG_DEST_FILE = 1<<1,
+	};
+
+	// Record: header, format string (inc. NUL), then the arguments
+	struct RecordHeader
+	{
+		UINT32 size;	// Of the whole record (0 = no more records before the end of the buffer)
+		UINT32 dest;
+		UINT64 seq;		// Global order
+	};
+
+	const UINT32 kStagingBufferSize = 256*1024;	// Per thread
+	const UINT32 kMaxRecordSize = kStagingBufferSize / 4;
+	const UINT32 kRecordAlign = 8;
+	const DWORD kFlushIntervalMS = 20;
+
+	class StagingBuffer
+	{
+	public:
+		StagingBuffer() : m_inUse(true), m_data(kStagingBufferSize), m_writePos(0), m_readPos(0) {}
+
+		// Producer (the owning thread)
+		bool Write(const BYTE* pRecord, UINT32 size);
+		bool IsHalfFull() const { return m_writePos.load(std::memory_order_relaxed) - m_readPos.load(std::memory_order_relaxed) >= kStagingBufferSize / 2; }
+
+		// Consumer (the flusher): append all the complete records to 'out'
+		void Drain(std::vector<BYTE>& out);
+
+		std::atomic<bool> m_inUse;	// Owned by a running thread
+
+	private:
+		std::vector<BYTE> m_data;
+		std::atomic<UINT64> m_writePos;	// Monotonic, so (write - read) is the fill level
+		std::atomic<UINT64> m_readPos;
+	};
+
+	bool StagingBuffer::Write(const BYTE* pRecord, UINT32 size)
+	{
+		const UINT64 writePos = m_writePos.load(std::memory_order_relaxed);
+		const UINT64 readPos = m_readPos.load(std::memory_order_acquire);
+
+		// Records are contiguous, so if it doesn't fit before the end of the buffer then skip to the start
+		UINT32 offset = (UINT32)(writePos % kStagingBufferSize);
+		const UINT32 skip = (offset + size > kStagingBufferSize) ? kStagingBufferSize - offset : 0;
+
+		if ((writePos - readPos) + skip + size > kStagingBufferSize)
+			return false;
+
+		if (skip)
+		{
+			const UINT32 endMarker = 0;	// NB. records are aligned, so there's always room for this
+			memcpy(&m_data[offset], &endMarker, sizeof(endMarker));
+			offset = 0;
+		}
+
+		memcpy(&m_data[offset], pRecord, size);
+		m_writePos.store(writePos + skip + size, std::memory_order_release);
+		return true;
+	}
+
+	void StagingBuffer::Drain(std::vector<BYTE>& out)
+	{
+		const UINT64 writePos = m_writePos.load(std::memory_order_acquire);
+		UINT64 readPos = m_readPos.load(std::memory_order_relaxed);
+
+		while (readPos != writePos)
+		{
+			const UINT32 offset = (UINT32)(readPos % kStagingBufferSize);
+			UINT32 size;
+			memcpy(&size, &m_data[offset], sizeof(size));
+
+			if (size == 0)
+			{
+				readPos += kStagingBufferSize - offset;
+				continue;
+			}
+
+			out.insert(out.end(), m_data.begin() + offset, m_data.begin() + offset + size);
+			readPos += size;
+		}
+
+		m_readPos.store(readPos, std::memory_order_release);
+	}
+
+	// A thread's buffer may still hold messages when the thread exits, so the buffers live for the whole process:
+	// . when a thread exits its buffer is released, then reused by the next new thread that logs
+	std::vector<StagingBuffer*> g_stagingBuffers;
+	CRITICAL_SECTION g_csStagingBuffers;	// Protects g_stagingBuffers
+	CRITICAL_SECTION g_csFlush;				// Only one consumer at a time
+	bool g_bCriticalSectionsInit = false;
+
+	struct ThreadStagingBuffer
+	{
+		ThreadStagingBuffer() : pBuffer(NULL) {}
+		~ThreadStagingBuffer() { if (pBuffer) pBuffer->m_inUse = false; }
+		StagingBuffer* pBuffer;
+	};
+
+	thread_local ThreadStagingBuffer t_stagingBuffer;
+	thread_local std::vector<BYTE> t_record;	// Scratch, to build a record
+
+	std::atomic<bool> g_bLogAsync(false);
+	std::atomic<UINT64> g_nextSeq(0);
+	std::atomic<UINT32> g_numDroppedMessages(0);
+
+	HANDLE g_hFlusherThread = NULL;
+	HANDLE g_hFlusherEvent = NULL;
+	std::atomic<bool> g_bStopFlusher(false);
+
+	std::vector<BYTE> g_drained;	// Flusher's scratch
+	std::string g_fileOutput;
+	std::string g_message;
+}
+
+static StagingBuffer* GetThreadStagingBuffer()
+{
+	if (t_stagingBuffer.pBuffer)
+		return t_stagingBuffer.pBuffer;
+
+	StagingBuffer* pBuffer = NULL;
+
+	EnterCriticalSection(&g_csStagingBuffers);
+	for (size_t i = 0; i < g_stagingBuffers.size(); i++)
+	{
+		if (!g_stagingBuffers[i]->m_inUse)
+		{
+			pBuffer = g_stagingBuffers[i];
+			pBuffer->m_inUse = true;
+			break;
+		}
+	}
+	if (!pBuffer)
+	{
+		pBuffer = new StagingBuffer;
+		g_stagingBuffers.push_back(pBuffer);
+	}
+	LeaveCriticalSection(&g_csStagingBuffers);
+
+	t_stagingBuffer.pBuffer = pBuffer;
+	return pBuffer;
+}
+
+//---------------------------------------------------------------------------
+
+// Deferred formatting: capture each argument by its printf conversion, then format them later with the same conversion
+
+namespace
+{
+	enum ArgType
+	{
+		ARG_NONE,			// eg. "%%"
+		ARG_INT,			// Incl. char & short (promoted)
+		ARG_LONG,
+		ARG_LONGLONG,
+		ARG_SIZE_T,
+		ARG_INTMAX_T,
+		ARG_PTRDIFF_T,
+		ARG_DOUBLE,			// Incl. float (promoted)
+		ARG_LONGDOUBLE,
+		ARG_STRING,
+		ARG_WSTRING,
+		ARG_POINTER,
+		ARG_UNSUPPORTED,	// eg. "%n": the argument is consumed, but nothing is output
+	};
+
+	struct FormatSpec
+	{
+		const char* pStart;	// The '%'
+		const char* pEnd;	// Just past the conversion character
+		UINT numStars;		// Width and/or precision from int arguments, which precede the argument
+		ArgType type;
+	};
+}
+
+// Find the next conversion spec at or after p, or return false at the end of the format
+static bool NextFormatSpec(const char* p, FormatSpec& spec)
+{
+	p = strchr(p, '%');
+	if (!p)
+		return false;
+
+	spec.pStart = p++;
+	spec.numStars = 0;
+
+	if (*p == '%')
+	{
+		spec.pEnd = p + 1;
+		spec.type = ARG_NONE;
+		return true;
+	}
+
+	while (*p && strchr("-+ #0'", *p))
+		p++;
+
+	// Width & precision
+	for (int i = 0; i < 2; i++)
+	{
+		if (i == 1)
+		{
+			if (*p != '.')
+				break;
+			p++;
+		}
+
+		if (*p == '*')
+		{
+			spec.numStars++;
+			p++;
+		}
+		else
+		{
+			while (*p >= '0' && *p <= '9')
+				p++;
+		}
+	}
+
+	enum { LEN_NONE, LEN_LONG, LEN_LONGLONG, LEN_LONGDOUBLE, LEN_SIZE_T, LEN_INTMAX_T, LEN_PTRDIFF_T } length = LEN_NONE;
+
+	if (strncmp(p, "hh", 2) == 0)			p += 2;
+	else if (*p == 'h')						p += 1;
+	else if (strncmp(p, "ll", 2) == 0)		{ p += 2; length = LEN_LONGLONG; }
+	else if (*p == 'l')						{ p += 1; length = LEN_LONG; }
+	else if (*p == 'L')						{ p += 1; length = LEN_LONGDOUBLE; }
+	else if (*p == 'z')						{ p += 1; length = LEN_SIZE_T; }
+	else if (*p == 'j')						{ p += 1; length = LEN_INTMAX_T; }
+	else if (*p == 't')						{ p += 1; length = LEN_PTRDIFF_T; }
+	else if (strncmp(p, "I64", 3) == 0)		{ p += 3; length = LEN_LONGLONG; }	// MSVC
+	else if (strncmp(p, "I32", 3) == 0)		p += 3;
+	else if (*p == 'I')						{ p += 1; length = LEN_SIZE_T; }
+
+	const char conversion = *p;
+	if (!conversion)
+		return false;
+
+	spec.pEnd = p + 1;
+
+	switch (conversion)
+	{
+	case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+		spec.type = (length == LEN_LONG) ? ARG_LONG
+			: (length == LEN_LONGLONG || length == LEN_LONGDOUBLE) ? ARG_LONGLONG
+			: (length == LEN_SIZE_T) ? ARG_SIZE_T
+			: (length == LEN_INTMAX_T) ? ARG_INTMAX_T
+			: (length == LEN_PTRDIFF_T) ? ARG_PTRDIFF_T
+			: ARG_INT;
+		break;
+	case 'c': case 'C':
+		spec.type = ARG_INT;
+		break;
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		spec.type = (length == LEN_LONGDOUBLE) ? ARG_LONGDOUBLE : ARG_DOUBLE;
+		break;
+	case 's':
+		spec.type = (length == LEN_LONG) ? ARG_WSTRING : ARG_STRING;
+		break;
+	case 'S':
+		spec.type = ARG_WSTRING;
+		break;
+	case 'p':
+		spec.type = ARG_POINTER;
+		break;
+	case 'n':
+		spec.type = ARG_UNSUPPORTED;
+		break;
+	default:	// Not a conversion: output it as-is
+		spec.type = ARG_NONE;
+		break;
+	}
+
+	return true;
+}
+
+template <class T>
+static inline void PutArg(std::vector<BYTE>& record, T value)
+{
+	const size_t pos = record.size();
+	record.resize(pos + sizeof(T));
+	memcpy(&record[pos], &value, sizeof(T));
+}
+
+template <class T>
+static inline T GetArg(const BYTE*& pArgs)
+{
+	T value;
+	memcpy(&value, pArgs, sizeof(T));
+	pArgs += sizeof(T);
+	return value;
+}
+
+static void CaptureArgs(std::vector<BYTE>& record, const char* format, va_list args)
+{
+	FormatSpec spec;
+	const char* p = format;
+
+	while (NextFormatSpec(p, spec))
+	{
+		p = spec.pEnd;
+
+		for (UINT i = 0; i < spec.numStars; i++)
+			PutArg<int>(record, va_arg(args, int));
+
+		switch (spec.type)
+		{
+		case ARG_NONE:			break;
+		case ARG_INT:			PutArg<int>(record, va_arg(args, int)); break;
+		case ARG_LONG:			PutArg<long>(record, va_arg(args, long)); break;
+		case ARG_LONGLONG:		PutArg<long long>(record, va_arg(args, long long)); break;
+		case ARG_SIZE_T:		PutArg<size_t>(record, va_arg(args, size_t)); break;
+		case ARG_INTMAX_T:		PutArg<intmax_t>(record, va_arg(args, intmax_t)); break;
+		case ARG_PTRDIFF_T:		PutArg<ptrdiff_t>(record, va_arg(args, ptrdiff_t)); break;
+		case ARG_DOUBLE:		PutArg<double>(record, va_arg(args, double)); break;
+		case ARG_LONGDOUBLE:	PutArg<long double>(record, va_arg(args, long double)); break;
+		case ARG_POINTER:		PutArg<const void*>(record, va_arg(args, const void*)); break;
+		case ARG_UNSUPPORTED:	(void) va_arg(args, void*); break;
+		case ARG_STRING:
+			{
+				const char* pString = va_arg(args, const char*);
+				if (!pString)
+					pString = "(null)";
+				record.insert(record.end(), (const BYTE*)pString, (const BYTE*)pString + strlen(pString) + 1);
+			}
+			break;
+		case ARG_WSTRING:
+			{
+				const wchar_t* pString = va_arg(args, const wchar_t*);
+				if (!pString)
+					pString = L"(null)";
+				record.insert(record.end(), (const BYTE*)pString, (const BYTE*)(pString + wcslen(pString) + 1));
+			}
+			break;
+		}
+	}
+}
+
+template <class T>
+static void AppendFormatted(std::string& out, const char* spec, T value)
+{
+	char buffer[256];
+	const int len = snprintf(buffer, sizeof(buffer), spec, value);
+	if (len < 0)
+		return;
+
+	if (len < (int)sizeof(buffer))
+	{
+		out.append(buffer, len);
+		return;
+	}
+
+	const size_t pos = out.size();
+	out.resize(pos + len + 1);
+	snprintf(&out[pos], len + 1, spec, value);
+	out.resize(pos + len);
+}
+
+static void FormatRecord(std::string& out, const char* format, const BYTE* pArgs)
+{
+	std::string specString;
+	FormatSpec spec;
+	const char* p = format;
+
+	while (NextFormatSpec(p, spec))
+	{
+		out.append(p, spec.pStart);
+		p = spec.pEnd;
+
+		if (spec.type == ARG_NONE)
+		{
+			if (spec.pEnd - spec.pStart == 2 && spec.pStart[1] == '%')
+				out += '%';
+			else
+				out.append(spec.pStart, spec.pEnd);
+			continue;
+		}
+
+		// Replace any '*' with its captured value
+		specString.clear();
+		for (const char* q = spec.pStart; q != spec.pEnd; q++)
+		{
+			if (*q == '*')
+				specString += StrFormat("%d", GetArg<int>(pArgs));
+			else
+				specString += *q;
+		}
+		const char* pSpec = specString.c_str();
+
+		switch (spec.type)
+		{
+		case ARG_INT:			AppendFormatted(out, pSpec, GetArg<int>(pArgs)); break;
+		case ARG_LONG:			AppendFormatted(out, pSpec, GetArg<long>(pArgs)); break;
+		case ARG_LONGLONG:		AppendFormatted(out, pSpec, GetArg<long long>(pArgs)); break;
+		case ARG_SIZE_T:		AppendFormatted(out, pSpec, GetArg<size_t>(pArgs)); break;
+		case ARG_INTMAX_T:		AppendFormatted(out, pSpec, GetArg<intmax_t>(pArgs)); break;
+		case ARG_PTRDIFF_T:		AppendFormatted(out, pSpec, GetArg<ptrdiff_t>(pArgs)); break;
+		case ARG_DOUBLE:		AppendFormatted(out, pSpec, GetArg<double>(pArgs)); break;
+		case ARG_LONGDOUBLE:	AppendFormatted(out, pSpec, GetArg<long double>(pArgs)); break;
+		case ARG_POINTER:		AppendFormatted(out, pSpec, GetArg<const void*>(pArgs)); break;
+		case ARG_UNSUPPORTED:	break;
+		case ARG_STRING:
+			{
+				const char* pString = (const char*)pArgs;
+				pArgs += strlen(pString) + 1;
+				AppendFormatted(out, pSpec, pString);
+			}
+			break;
+		case ARG_WSTRING:
+			{
+				// Copy, as it may not be aligned in the record
+				std::wstring string;
+				wchar_t c;
+				while ((c = GetArg<wchar_t>(pArgs)) != 0)
+					string += c;
+				AppendFormatted(out, pSpec, string.c_str());
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	out.append(p);
+}
+
+//---------------------------------------------------------------------------
+
+static void LogEnqueue(UINT32 dest, const char* format, va_list args)
+{
+	std::vector<BYTE>& record = t_record;
+
+	record.resize(sizeof(RecordHeader));
+	record.insert(record.end(), (const BYTE*)format, (const BYTE*)format + strlen(format) + 1);
+	CaptureArgs(record, format, args);
+	record.resize((record.size() + kRecordAlign - 1) & ~(size_t)(kRecordAlign - 1));
+
+	if (record.size() > kMaxRecordSize)
+	{
+		g_numDroppedMessages++;
+		return;
+	}
+
+	RecordHeader header;
+	header.size = (UINT32)record.size();
+	header.dest = dest;
+	header.seq = g_nextSeq++;
+	memcpy(&record[0], &header, sizeof(header));
+
+	StagingBuffer* pBuffer = GetThreadStagingBuffer();
+	if (!pBuffer->Write(&record[0], (UINT32)record.size()))
+	{
+		g_numDroppedMessages++;
+		return;
+	}
+
+	if (pBuffer->IsHalfFull())
+		SetEvent(g_hFlusherEvent);	// Don't wait for the next periodic flush
+}
+
+void LogFlush()
+{
+	if (!g_bCriticalSectionsInit)
+		return;
+
+	EnterCriticalSection(&g_csFlush);
+
+	g_drained.clear();
+	EnterCriticalSection(&g_csStagingBuffers);
+	for (size_t i = 0; i < g_stagingBuffers.size(); i++)
+		g_stagingBuffers[i]->Drain(g_drained);
+	LeaveCriticalSection(&g_csStagingBuffers);
+
+	// Messages from different threads are interleaved by their global order
+	std::vector<std::pair<UINT64, size_t> > order;	// seq, offset in g_drained
+	for (size_t offset = 0; offset < g_drained.size(); )
+	{
+		RecordHeader header;
+		memcpy(&header, &g_drained[offset], sizeof(header));
+		order.push_back(std::make_pair(header.seq, offset));
+		offset += header.size;
+	}
+	std::sort(order.begin(), order.end());
+
+	g_fileOutput.clear();
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		RecordHeader header;
+		memcpy(&header, &g_drained[order[i].second], sizeof(header));
+		const char* format = (const char*)&g_drained[order[i].second + sizeof(RecordHeader)];
+		const BYTE* pArgs = (const BYTE*)format + strlen(format) + 1;
+
+		g_message.clear();
+		FormatRecord(g_message, format, pArgs);
+
+		if (header.dest & LOG_DEST_DEBUGGER)
+			OutputDebugString(g_message.c_str());
+		if (header.dest & LOG_DEST_FILE)
+			g_fileOutput += g_message;
+	}
+
+	const UINT32 numDropped = g_numDroppedMessages.exchange(0);
+	if (numDropped)
+		g_fileOutput += StrFormat("*** Log: %u messages dropped\n", numDropped);
+
+	if (g_fh && !g_fileOutput.empty())
+		fwrite(g_fileOutput.data(), 1, g_fileOutput.size(), g_fh);
+
+	LeaveCriticalSection(&g_csFlush);
+}
+
+static DWORD WINAPI LogFlusherThread(LPVOID)
+{
+	while (!g_bStopFlusher)
+	{
+		WaitForSingleObject(g_hFlusherEvent, kFlushIntervalMS);
+		LogFlush();
+	}
+
+	return 0;
+}
 
 //---------------------------------------------------------------------------
 
@@ -74,6 +614,28 @@ void LogInit()
 	setvbuf(g_fh, NULL, _IONBF, 0);			// No buffering (so implicit fflush after every fprintf)
 
 	fprintf(g_fh, "*** Logging started: %s\n", GetTimeStamp().c_str());
+
+	if (!g_bCriticalSectionsInit)
+	{
+		InitializeCriticalSection(&g_csStagingBuffers);
+		InitializeCriticalSection(&g_csFlush);
+		g_bCriticalSectionsInit = true;
+	}
+
+	g_bStopFlusher = false;
+	g_hFlusherEvent = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	DWORD dwThreadId;
+	g_hFlusherThread = g_hFlusherEvent ? CreateThread(NULL, 0, LogFlusherThread, NULL, 0, &dwThreadId) : NULL;
+	if (!g_hFlusherThread)
+	{
+		fprintf(g_fh, "*** Failed to create log thread: logging is synchronous\n");
+		if (g_hFlusherEvent)
+			CloseHandle(g_hFlusherEvent);
+		g_hFlusherEvent = NULL;
+		return;
+	}
+
+	g_bLogAsync = true;
 }
 
 void LogDone()
@@ -81,6 +643,22 @@ void LogDone()
 	if (!g_fh)
 		return;
 
+	if (g_bLogAsync)
+	{
+		// NB. any messages logged (by other threads) after this are output synchronously
+		g_bLogAsync = false;
+
+		g_bStopFlusher = true;
+		SetEvent(g_hFlusherEvent);
+		WaitForSingleObject(g_hFlusherThread, INFINITE);
+		CloseHandle(g_hFlusherThread);
+		CloseHandle(g_hFlusherEvent);
+		g_hFlusherThread = NULL;
+		g_hFlusherEvent = NULL;
+
+		LogFlush();
+	}
+
 	fprintf(g_fh,"*** Logging ended\n\n");
 	fclose(g_fh);
 	g_fh = NULL;
@@ -88,12 +666,67 @@ void LogDone()
 
 //---------------------------------------------------------------------------
 
+bool LogSetLevels(const char* pszLevels)
+{
+	bool bOK = true;
+	std::string levels(pszLevels);
+
+	size_t start = 0;
+	while (start < levels.size())
+	{
+		size_t end = levels.find(',', start);
+		if (end == std::string::npos)
+			end = levels.size();
+
+		const std::string item = levels.substr(start, end - start);
+		start = end + 1;
+
+		const size_t equals = item.find('=');
+		if (equals == std::string::npos)
+		{
+			bOK = false;
+			continue;
+		}
+
+		const std::string subsystem = item.substr(0, equals);
+		const std::string levelName = item.substr(equals + 1);
+
+		int level = -1;
+		for (int i = 0; i < (int)(sizeof(g_logLevelNames) / sizeof(g_logLevelNames[0])); i++)
+		{
+			if (levelName == g_logLevelNames[i])
+				level = i;
+		}
+
+		bool bFound = false;
+		for (int i = 0; i < NUM_LOG_SUBSYSTEMS; i++)
+		{
+			if (subsystem == g_logSubsystemNames[i] || subsystem == "all")
+			{
+				bFound = true;
+				if (level >= 0)
+					g_logLevels[i] = (LogLevel)level;
+			}
+		}
+
+		if (!bFound || level < 0)
+			bOK = false;
+	}
+
+	return bOK;
+}
+
+//---------------------------------------------------------------------------
+
 void LogOutput(const char* format, ...)
 {
 	va_list args;
 	va_start(args, format);
 
-	OutputDebugString(StrFormatV(format, args).c_str());
+	if (g_bLogAsync)
+		LogEnqueue(LOG_DEST_DEBUGGER, format, args);
+	else
+		OutputDebugString(StrFormatV(format, args).c_str());
 
 	va_end(args);
 }
@@ -108,7 +741,10 @@ void LogFileOutput(const char* format, ...)
 	va_list args;
 	va_start(args, format);
 
-	vfprintf(g_fh, format, args);
+	if (g_bLogAsync)
+		LogEnqueue(LOG_DEST_FILE, format, args);
+	else
+		vfprintf(g_fh, format, args);
 
 	va_end(args);
 }
@@ -16,6 +16,45 @@ extern FILE* g_fh;	// File handle for log file
 
 void LogInit();
 void LogDone();
+void LogFlush();	// Write out all pending messages (from all threads)
 
+// Once LogInit() has been called, LogOutput() & LogFileOutput() are non-blocking:
+// . the format string & arguments are copied to a per-thread staging buffer (no formatting, no locks)
+// . a background thread formats them (in order) and writes them to the debugger & log file
+// . if a staging buffer is full, then the message is dropped (and counted) rather than stalling the caller
+// NB. The format string is copied, so needn't be a literal. %n isn't supported.
 void LogOutput(const char* format, ...) ATTRIBUTE_FORMAT_PRINTF(1, 2);
 void LogFileOutput(const char* format, ...) ATTRIBUTE_FORMAT_PRINTF(1, 2);
+
+//---------------------------------------------------------------------------
+
+// Per-subsystem runtime log levels (see command line: -log-level <subsystem>=<level>[,...])
+
+enum LogSubsystem
+{
+	LOG_SUBSYSTEM_DISK,
+	LOG_SUBSYSTEM_UTHERNET2,
+	NUM_LOG_SUBSYSTEMS
+};
+
+enum LogLevel
+{
+	LOG_LEVEL_OFF,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_DEBUG,
+	LOG_LEVEL_TRACE,
+};
+
+extern LogLevel g_logLevels[NUM_LOG_SUBSYSTEMS];
+
+inline bool LogIsEnabled(LogSubsystem subsystem, LogLevel level)
+{
+	return level <= g_logLevels[subsystem];
+}
+
+bool LogSetLevels(const char* pszLevels);	// eg. "disk=debug,uthernet2=trace"
+
+// Only evaluate the arguments if the subsystem is logging at this level
+#define LOG_SUBSYSTEM(subsystem, level, ...) do { if (LogIsEnabled(subsystem, level)) LogOutput(__VA_ARGS__); } while (0)
+#define LOG_SUBSYSTEM_FILE(subsystem, level, ...) do { if (LogIsEnabled(subsystem, level)) LogFileOutput(__VA_ARGS__); } while (0)
@@ -259,7 +259,9 @@ static CNoSlotClock* g_NoSlotClock = new CNoSlotClock;
 #ifdef RAMWORKS
 static UINT		g_uMaxExBanks = 1;				// user requested ram banks (default to 1 aux bank: so total = 128KB)
 static UINT		g_uActiveBank = 0;				// 0 = aux 64K for: //e extended 80 Col card, or //c -- also RamWorks III aux card
-static LPBYTE	RWpages[kMaxExMemoryBanks];		// pointers to RW memory banks
+static LPBYTE	RWpages[kMaxExMemoryBanks];		// pointers to RW memory banks (NULL = not yet used, see GetRamWorksBank())
+static LPBYTE GetRamWorksBank(const UINT bank);
+static void FreeRamWorksBank(const UINT bank);
 #endif
 
 static const UINT kNumAnnunciators = 4;
@@ -1323,11 +1325,20 @@ static void ResetPaging(const UPDATEPAGING updateType)
 
 static void UpdatePagingForAltRW();
 
+// Incremented whenever memwrite[] (or the mem cache's consistency) may have changed
+// . eg. so the Z80 can rebuild its page table
+static UINT g_memPagingGeneration = 0;
+
 void MemUpdatePaging(const UPDATEPAGING updateType)
 {
 	UpdatePaging(updateType);
 }
 
+UINT MemGetPagingGeneration()
+{
+	return g_memPagingGeneration;
+}
+
 static void UpdatePaging(const UPDATEPAGING updateType)
 {
 	if (updateType == PagingFullInitialize)
@@ -1341,6 +1352,7 @@ static void UpdatePaging(const UPDATEPAGING updateType)
 	}
 
 	modechanging = false;
+	g_memPagingGeneration++;
 
 	// SAVE THE CURRENT PAGING SHADOW TABLE
 	LPBYTE oldshadow[256];
@@ -1606,13 +1618,7 @@ void MemDestroy()
 
 #ifdef RAMWORKS
 	for (UINT i=1; i<kMaxExMemoryBanks; i++)
-	{
-		if (RWpages[i])
-		{
-			ALIGNED_FREE(RWpages[i]);
-			RWpages[i] = NULL;
-		}
-	}
+		FreeRamWorksBank(i);
 	RWpages[0]=NULL;
 #endif
 
@@ -1774,10 +1780,41 @@ static void BackMainImage()
 
 //-------------------------------------
 
+#ifdef RAMWORKS
+// RamWorks III banks are only allocated when first used (ie. selected via $C071/$C073, or loaded from a savestate),
+// since most software only uses a few of the (up to) 256 banks
+// . a new bank is zeroed, so an unused bank doesn't need to be saved to a snapshot
+// . reading a bank (eg. debugger, saving a snapshot) must not allocate it - see MemGetBankPtr()
+static LPBYTE GetRamWorksBank(const UINT bank)
+{
+	_ASSERT(bank < kMaxExMemoryBanks);
+	if (!RWpages[bank])
+	{
+		RWpages[bank] = ALIGNED_ALLOC(_6502_MEM_LEN);	// NB. VirtualAlloc() returns zeroed memory
+#ifndef _WIN32
+		if (RWpages[bank])
+			memset(RWpages[bank], 0, _6502_MEM_LEN);
+#endif
+	}
+
+	return RWpages[bank];
+}
+
+static void FreeRamWorksBank(const UINT bank)
+{
+	_ASSERT(bank > 0);	// bank 0 is memaux
+	if (RWpages[bank])
+	{
+		ALIGNED_FREE(RWpages[bank]);
+		RWpages[bank] = NULL;
+	}
+}
+#endif
+
 // Used by:
 // . Savestate: MemSaveSnapshotMemory(), MemLoadSnapshotAux()
 // . VidHD    : SaveSnapshot(), LoadSnapshot()
-// . Debugger : CmdMemorySave(), CmdMemoryLoad()
+// Returns NULL for an out of range bank, or an unused (ie. not yet allocated) RamWorks III bank
 LPBYTE MemGetBankPtr(const UINT nBank, const bool isSaveSnapshotOrDebugging/*=true*/)
 {
 	// Only call BackMainImage() when a consistent 64K bank is needed, eg. for saving snapshot or debugging
@@ -1800,6 +1837,39 @@ LPBYTE MemGetBankPtr(const UINT nBank, const bool isSaveSnapshotOrDebugging/*=tr
 #endif
 }
 
+// Used by:
+// . Debugger : CmdMemoryLoad()
+// As MemGetBankPtr(), but an unused RamWorks III bank is allocated (as it's about to be written to), rather than returning NULL
+LPBYTE MemGetBankPtrForWrite(const UINT nBank)
+{
+	LPBYTE pBank = MemGetBankPtr(nBank);
+
+#ifdef RAMWORKS
+	if (!pBank && nBank <= g_uMaxExBanks)
+		pBank = GetRamWorksBank(nBank-1);
+#endif
+
+	return pBank;
+}
+
+// Used by:
+// . Debugger : CmdMemorySave()
+// As MemGetBankPtr(), but an unused RamWorks III bank is returned as a shared (read-only) bank of zeros, rather than NULL
+const BYTE* MemGetBankPtrReadOnly(const UINT nBank)
+{
+	const BYTE* pBank = MemGetBankPtr(nBank);
+
+#ifdef RAMWORKS
+	if (!pBank && nBank <= g_uMaxExBanks)
+	{
+		static const std::vector<BYTE> zeroBank(_6502_MEM_LEN, 0);
+		pBank = &zeroBank[0];
+	}
+#endif
+
+	return pBank;
+}
+
 //===========================================================================
 
 LPBYTE MemGetCxRomPeripheral()
@@ -2015,15 +2085,9 @@ void MemInitialize()
 	RWpages[0] = memaux;
 
 #ifdef RAMWORKS
-	if (GetCardMgr().QueryAux() == CT_RamWorksIII)
-	{
-		// allocate memory for RamWorks III - up to 16MB
-		UINT i = 1;
-		while ((i < g_uMaxExBanks) && (RWpages[i] = ALIGNED_ALLOC(_6502_MEM_LEN)))
-			i++;
-		while (i < kMaxExMemoryBanks)
-			RWpages[i++] = NULL;
-	}
+	// RamWorks III - up to 16MB: banks are allocated on first use (see GetRamWorksBank())
+	for (UINT i = 1; i < kMaxExMemoryBanks; i++)
+		RWpages[i] = NULL;
 #endif
 
 	//
@@ -2552,7 +2616,7 @@ BYTE __stdcall MemSetPaging(WORD programcounter, WORD address, BYTE write, BYTE
 #ifdef RAMWORKS
 			case 0x71: // extended memory aux page number
 			case 0x73: // Ramworks III set aux page number
-				if ((value < g_uMaxExBanks) && RWpages[value])
+				if ((value < g_uMaxExBanks) && GetRamWorksBank(value))
 				{
 					g_uActiveBank = value;
 					memaux = RWpages[g_uActiveBank];
@@ -2760,7 +2824,8 @@ static const UINT kUNIT_AUXSLOT_VER = 2;
 // 2: Added: RGB card state
 // 3: Extended: RGB card state ('80COL changed')
 // 4: Support aux empty or aux 1KiB card
-static const UINT kUNIT_CARD_VER = 4;
+// 5: RamWorks III: unused banks (ie. all zero) are omitted
+static const UINT kUNIT_CARD_VER = 5;
 
 #define SS_YAML_KEY_NUMAUXBANKS "Num Aux Banks"
 #define SS_YAML_KEY_ACTIVEAUXBANK "Active Aux Bank"
@@ -3010,6 +3075,9 @@ void MemSaveSnapshotAux(YamlSaveHelper& yamlSaveHelper)
 
 			for(UINT bank = 1; bank <= g_uMaxExBanks; bank++)
 			{
+				if (bank > 1 && !RWpages[bank-1])
+					continue;	// unused bank
+
 				MemSaveSnapshotMemory(yamlSaveHelper, false, bank);
 			}
 
@@ -3018,7 +3086,7 @@ void MemSaveSnapshotAux(YamlSaveHelper& yamlSaveHelper)
 	}
 }
 
-static SS_CARDTYPE MemLoadSnapshotAuxCommon(YamlLoadHelper& yamlLoadHelper, const std::string& card)
+static SS_CARDTYPE MemLoadSnapshotAuxCommon(YamlLoadHelper& yamlLoadHelper, const std::string& card, UINT cardVersion)
 {
 	g_uMaxExBanks = 1;	// Must be at least 1 (for aux mem) - regardless of Apple2 type!
 	g_uActiveBank = 0;
@@ -3082,15 +3150,21 @@ static SS_CARDTYPE MemLoadSnapshotAuxCommon(YamlLoadHelper& yamlLoadHelper, cons
 
 		for (UINT bank = 1; bank <= g_uMaxExBanks; bank++)
 		{
-			LPBYTE pBank = MemGetBankPtr(bank, false);
-			if (!pBank)
-				pBank = RWpages[bank - 1] = ALIGNED_ALLOC(_6502_MEM_LEN);
-
 			// "Auxiliary Memory Bankxx"
 			std::string auxMemName = MemGetSnapshotAuxMemStructName() + ByteToHexStr(bank - 1);
 
 			if (!yamlLoadHelper.GetSubMap(auxMemName))
-				throw std::runtime_error("Memory: Missing map name: " + auxMemName);
+			{
+				if (bank == 1 || cardVersion < 5)
+					throw std::runtime_error("Memory: Missing map name: " + auxMemName);
+
+				FreeRamWorksBank(bank - 1);		// unused bank (card version 5+)
+				continue;
+			}
+
+			LPBYTE pBank = GetRamWorksBank(bank - 1);
+			if (!pBank)
+				throw std::runtime_error("Memory: Failed to allocate: " + auxMemName);
 
 			yamlLoadHelper.LoadMemory(pBank, _6502_MEM_LEN);
 
@@ -3100,7 +3174,7 @@ static SS_CARDTYPE MemLoadSnapshotAuxCommon(YamlLoadHelper& yamlLoadHelper, cons
 
 	GetCardMgr().InsertAux(cardType);
 
-	memaux = RWpages[g_uActiveBank];
+	memaux = GetRamWorksBank(g_uActiveBank);
 	// NB. MemUpdatePaging(PagingFullInitialize) called at end of Snapshot_LoadState_v2()
 
 	return cardType;
@@ -3109,7 +3183,7 @@ static SS_CARDTYPE MemLoadSnapshotAuxCommon(YamlLoadHelper& yamlLoadHelper, cons
 static void MemLoadSnapshotAuxVer1(YamlLoadHelper& yamlLoadHelper)
 {
 	std::string card = yamlLoadHelper.LoadString(SS_YAML_KEY_CARD);
-	MemLoadSnapshotAuxCommon(yamlLoadHelper, card);
+	MemLoadSnapshotAuxCommon(yamlLoadHelper, card, 1);	// NB. no card version for unit v1
 }
 
 static void MemLoadSnapshotAuxVer2(YamlLoadHelper& yamlLoadHelper)
@@ -3123,7 +3197,7 @@ static void MemLoadSnapshotAuxVer2(YamlLoadHelper& yamlLoadHelper)
 			throw std::runtime_error(SS_YAML_KEY_UNIT ": Expected sub-map name: " SS_YAML_KEY_STATE);
 	}
 
-	SS_CARDTYPE cardType = MemLoadSnapshotAuxCommon(yamlLoadHelper, card);
+	SS_CARDTYPE cardType = MemLoadSnapshotAuxCommon(yamlLoadHelper, card, cardVersion);
 
 	if (card == MemGetSnapshotCardNameExtended80Col() || card == MemGetSnapshotCardNameRamWorksIII())
 		RGB_LoadSnapshot(yamlLoadHelper, cardVersion);
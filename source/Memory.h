@@ -66,6 +66,8 @@ LPBYTE  MemGetAuxPtr(const WORD offset);
 LPBYTE  MemGetMainPtrWithLC(const WORD offset);
 LPBYTE  MemGetMainPtr(const WORD offset);
 LPBYTE  MemGetBankPtr(const UINT nBank, const bool isSaveSnapshotOrDebugging = true);
+LPBYTE  MemGetBankPtrForWrite(const UINT nBank);
+const BYTE* MemGetBankPtrReadOnly(const UINT nBank);
 LPBYTE  MemGetCxRomPeripheral();
 uint32_t   GetMemMode();
 void    SetMemMode(uint32_t memmode);
@@ -86,6 +88,7 @@ void    MemReset ();
 void    MemResetPaging ();
 enum UPDATEPAGING { PagingUpdateOnly = 0, PagingFullInitialize };
 void    MemUpdatePaging(const UPDATEPAGING updateType);
+UINT    MemGetPagingGeneration();
 LPVOID	MemGetSlotParameters (UINT uSlot);
 void	MemAnnunciatorReset();
 bool    MemGetAnnunciator(UINT annunciator);
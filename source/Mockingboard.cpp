@@ -79,7 +79,7 @@ MockingboardCard::MockingboardCard(UINT slot, SS_CARDTYPE type) : Card(type, slo
 	SetPhasorMode(PH_Mockingboard);		// + re-init's AY CLK
 
 	m_lastMBUpdateCycle = 0;
-	m_numSamplesError = 0;
+	m_numAYSamplesRemainder = 0.0;
 
 	//
 
@@ -119,11 +119,13 @@ MockingboardCard::MockingboardCard(UINT slot, SS_CARDTYPE type) : Card(type, slo
 		}
 	}
 
-	AY8910_InitAll((int)g_fCurrentCLK6502, SAMPLE_RATE);
+	AY8910_InitAll((int)g_fCurrentCLK6502, (int)GetAYSampleRate());
 	LogFileOutput("MockingboardCard::ctor: AY8910_InitAll()\n");
 
 	Reset(true);
 	LogFileOutput("MockingboardCard::ctor: Reset()\n");
+
+	ScheduleUpdateNow();
 }
 
 MockingboardCard::~MockingboardCard()
@@ -550,14 +552,11 @@ UINT MockingboardCard::MB_Update()
 
 	m_lastMBUpdateCycle = m_lastCumulativeCycle;
 
-	const double nIrqFreq = g_fCurrentCLK6502 / updateInterval + 0.5;			// Round-up
-	const int nNumSamplesPerPeriod = (int)((double)SAMPLE_RATE / nIrqFreq);	// Eg. For 60Hz this is 735
-
-	int nNumSamples = nNumSamplesPerPeriod + m_numSamplesError;					// Apply correction
-	if (nNumSamples <= 0)
-		nNumSamples = 0;
-	if (nNumSamples > 2 * nNumSamplesPerPeriod)
-		nNumSamples = 2 * nNumSamplesPerPeriod;
+	// The AYs run at their own rate (see GetAYSampleRate()), so the number of samples just follows the cycles.
+	// Carry the fraction over, so there's no drift. (The ring-buffer's fill level is managed by the resampler.)
+	const double numSamples = updateInterval / (double)AY_CLKS_PER_SAMPLE + m_numAYSamplesRemainder;	// Eg. For 60Hz this is ~531
+	int nNumSamples = (int)numSamples;
+	m_numAYSamplesRemainder = numSamples - (double)nNumSamples;
 
 	if (nNumSamples > MAX_SAMPLES)
 		nNumSamples = MAX_SAMPLES;	// Clamp to prevent buffer overflow
@@ -587,8 +586,40 @@ UINT MockingboardCard::MB_Update()
 	return (UINT) nNumSamples;
 }
 
+// Called by MockingboardCardManager::MixAllAndCopyToRingBuffer()
+// . Returns NULL if neither SSI263 (nor the SC01) has any speech to mix
+const int* MockingboardCard::GetSpeechBuffer(UINT numSamples)
+{
+	if (numSamples > MAX_SAMPLES)
+		numSamples = MAX_SAMPLES;
+
+	bool hasSpeech = false;
+
+	for (UINT i = 0; i < NUM_SSI263; i++)
+	{
+		SSI263& ssi263 = m_MBSubUnit[i].ssi263;
+		if (!ssi263.IsSpeechBuffered())
+			continue;
+
+		if (!hasSpeech)
+		{
+			memset(m_speechBuffer, 0, numSamples * sizeof(int));
+			hasSpeech = true;
+		}
+
+		ssi263.MixSpeech(m_speechBuffer, numSamples, GetAYSampleRate());
+	}
+
+	return hasSpeech ? m_speechBuffer : NULL;
+}
+
 //-----------------------------------------------------------------------------
 
+double MockingboardCard::GetAYSampleRate()
+{
+	return g_fCurrentCLK6502 / (double)AY_CLKS_PER_SAMPLE;
+}
+
 // NB. Called when /g_fCurrentCLK6502/ changes
 void MockingboardCard::ReinitializeClock()
 {
@@ -600,9 +631,6 @@ void MockingboardCard::ReinitializeClock()
 
 void MockingboardCard::Destroy()
 {
-	for (UINT i = 0; i < NUM_SSI263; i++)
-		m_MBSubUnit[i].ssi263.DSUninit();
-
 	for (UINT i = 0; i < NUM_VOICES; i++)
 	{
 		delete[] m_ppAYVoiceBuffer[i];
@@ -627,6 +655,7 @@ void MockingboardCard::Reset(const bool powerCycle)	// CTRL+RESET or power-cycle
 
 	for (BYTE subunit = 0; subunit < NUM_SUBUNITS_PER_MB; subunit++)
 	{
+		m_MBSubUnit[subunit].sy6522.UpdateCycles(g_nCumulativeCycles);	// A CTRL+RESET doesn't stop the counters
 		m_MBSubUnit[subunit].sy6522.Reset(powerCycle);
 
 		for (BYTE ay = 0; ay < NUM_AY8913_PER_SUBUNIT; ay++)
@@ -645,6 +674,7 @@ void MockingboardCard::Reset(const bool powerCycle)	// CTRL+RESET or power-cycle
 		m_isActive = false;
 
 		m_lastMBUpdateCycle = 0;
+		m_numAYSamplesRemainder = 0.0;
 
 		for (int id = 0; id < kNumSyncEvents; id++)
 		{
@@ -933,66 +963,45 @@ void MockingboardCard::InitializeIO(LPBYTE pCxRomPeripheral)
 
 //-----------------------------------------------------------------------------
 
-void MockingboardCard::MuteControl(bool mute)
-{
-	if (mute)
-	{
-		for (UINT i = 0; i < NUM_SSI263; i++)
-			m_MBSubUnit[i].ssi263.Mute();
-	}
-	else
-	{
-		for (UINT i = 0; i < NUM_SSI263; i++)
-			m_MBSubUnit[i].ssi263.Unmute();
-	}
-}
-
-//-----------------------------------------------------------------------------
-
-#ifdef _DEBUG
-void MockingboardCard::CheckCumulativeCycles()
+// Called by: ResetState() and Snapshot_LoadState_v2()
+void MockingboardCard::SetCumulativeCycles()
 {
-	_ASSERT(m_lastCumulativeCycle == g_nCumulativeCycles);
 	m_lastCumulativeCycle = g_nCumulativeCycles;
+
+	for (UINT i = 0; i < NUM_SUBUNITS_PER_MB; i++)
+		m_MBSubUnit[i].sy6522.SetCumulativeCycles(g_nCumulativeCycles);
 }
-#endif
 
-// Called by: ResetState() and Snapshot_LoadState_v2()
-void MockingboardCard::SetCumulativeCycles()
+// Called at the end of an execution period: catch up the AY8913s' & SSI263s' view of time (but not the 6522s', which are only updated on demand)
+void MockingboardCard::UpdateAudioCycles()
 {
 	m_lastCumulativeCycle = g_nCumulativeCycles;
 }
 
-// Called by ContinueExecution() at the end of every execution period (~1000 cycles or ~3 cycles when MODE_STEPPING)
+// Called by CardManager::Update() every kSSI263UpdateCycles
 void MockingboardCard::Update(const ULONG executedCycles)
 {
+	UpdateAudioCycles();
+
 	for (UINT i = 0; i < NUM_SSI263; i++)
 		m_MBSubUnit[i].ssi263.PeriodicUpdate(executedCycles);
+
+	ScheduleUpdateIn(kSSI263UpdateCycles);
 }
 
 //-----------------------------------------------------------------------------
 
 // Called by:
-// . CpuExecute() every ~1000 cycles @ 1MHz (or ~3 cycles when MODE_STEPPING)
 // . MB_SyncEventCallback() on a TIMER1/2 underflow
 // . IORead() / IOWrite() (for both normal & full-speed)
+// NB. Not called between accesses, so an idle Mockingboard costs nothing
 void MockingboardCard::UpdateCycles(ULONG executedCycles)
 {
 	CpuCalcCycles(executedCycles);
-	UINT64 uCycles = g_nCumulativeCycles - m_lastCumulativeCycle;
-	_ASSERT(uCycles >= 0);
-	if (uCycles == 0)
-		return;
-
 	m_lastCumulativeCycle = g_nCumulativeCycles;
-	_ASSERT(uCycles < 0x10000 || g_nAppMode == MODE_BENCHMARK);
-	USHORT nClocks = (USHORT)uCycles;
 
 	for (UINT i = 0; i < NUM_SUBUNITS_PER_MB; i++)
-	{
-		m_MBSubUnit[i].sy6522.UpdateTimer1(nClocks);
-		m_MBSubUnit[i].sy6522.UpdateTimer2(nClocks);
-	}
+		m_MBSubUnit[i].sy6522.UpdateCycles(g_nCumulativeCycles);
 }
 
 //-----------------------------------------------------------------------------
@@ -1056,14 +1065,6 @@ bool MockingboardCard::IsActiveToPreventFullSpeed()
 	return m_isActive;
 }
 
-//-----------------------------------------------------------------------------
-
-void MockingboardCard::SetVolume(uint32_t volume, uint32_t volumeMax)
-{
-	for (UINT i = 0; i < NUM_SSI263; i++)
-		m_MBSubUnit[i].ssi263.SetVolume(volume, volumeMax);
-}
-
 //===========================================================================
 
 void MockingboardCard::GetSnapshotForDebugger(DEBUGGER_MB_CARD* const pMBForDebugger)
@@ -1074,6 +1075,7 @@ void MockingboardCard::GetSnapshotForDebugger(DEBUGGER_MB_CARD* const pMBForDebu
 	{
 		MB_SUBUNIT* pMB = &m_MBSubUnit[i];
 
+		pMB->sy6522.UpdateCycles(g_nCumulativeCycles);
 		pMB->sy6522.GetRegs(pMBForDebugger->subUnit[i].regsSY6522);	// continuous 16-byte array
 		pMBForDebugger->subUnit[i].timer1Active = pMB->sy6522.IsTimer1Active();
 		pMBForDebugger->subUnit[i].timer2Active = pMB->sy6522.IsTimer2Active();
@@ -1142,6 +1144,8 @@ void MockingboardCard::AY8910Update(BYTE subunit, BYTE ay, INT16** buffer, int n
 
 void MockingboardCard::AY8910_InitAll(int nClock, int nSampleRate)
 {
+	AY8913::SetSampleRate(nSampleRate);
+
 	for (UINT subunit = 0; subunit < NUM_SUBUNITS_PER_MB; subunit++)
 	{
 		for (UINT ay = 0; ay < 2; ay++)
@@ -1155,6 +1159,7 @@ void MockingboardCard::AY8910_InitAll(int nClock, int nSampleRate)
 void MockingboardCard::AY8910_InitClock(int nClock)
 {
 	AY8913::SetCLK((double)nClock);
+	AY8913::SetSampleRate((int)GetAYSampleRate());	// NB. Follows the 6502's CLK, not the AY's (eg. Phasor's x2)
 
 	for (UINT subunit = 0; subunit < NUM_SUBUNITS_PER_MB; subunit++)
 	{
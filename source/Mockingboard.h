@@ -29,17 +29,14 @@ public:
 	BYTE PhasorIOInternal(WORD PC, WORD nAddr, BYTE bWrite, BYTE nValue, ULONG nExecutedCycles);
 
 	void ReinitializeClock();
-	void MuteControl(bool mute);
 	void UpdateCycles(ULONG executedCycles);
 	bool IsActiveToPreventFullSpeed();
-	void SetVolume(uint32_t dwVolume, uint32_t dwVolumeMax);
 	void SetCumulativeCycles();
+	void UpdateAudioCycles();
 	UINT MB_Update();
 	short** GetVoiceBuffers() { return m_ppAYVoiceBuffer; }
-	int GetNumSamplesError() { return m_numSamplesError; }
-	void SetNumSamplesError(int numSamplesError) { m_numSamplesError = numSamplesError; }
+	const int* GetSpeechBuffer(UINT numSamples);
 #ifdef _DEBUG
-	void CheckCumulativeCycles();
 	void Get6522IrqDescription(std::string& desc);
 #endif
 
@@ -82,6 +79,11 @@ public:
 	static const unsigned short NUM_MB_CHANNELS = 2;
 	static const uint32_t SAMPLE_RATE = 44100;	// Use a base freq so that DirectX (or sound h/w) doesn't have to up/down-sample
 
+	// The AYs are synthesised at CLK/32 (~32KHz), then resampled to SAMPLE_RATE by MockingboardCardManager
+	// . 32 cycles per sample gives whole numbers of tone & envelope counter ticks per sample, and is cheaper than 44.1KHz
+	static const UINT AY_CLKS_PER_SAMPLE = 32;
+	static double GetAYSampleRate();
+
 private:
 	enum MockingboardUnitState_e { AY_NOP0, AY_NOP1, AY_INACTIVE, AY_READ, AY_NOP4, AY_NOP5, AY_WRITE, AY_LATCH };
 
@@ -170,9 +172,12 @@ private:
 	static const UINT kNumSyncEvents = NUM_SY6522 * SY6522::kNumTimersPer6522;
 	SyncEvent* m_syncEvent[kNumSyncEvents];
 
+	static const ULONG kSSI263UpdateCycles = 1000;	// Update() period
+
 	UINT64 m_lastCumulativeCycle;
 
 	short* m_ppAYVoiceBuffer[NUM_VOICES];
+	int m_speechBuffer[MAX_SAMPLES];	// Both SSI263s (and SC01), at the AYs' rate
 
 	UINT64 m_inActiveCycleCount;
 	bool m_regAccessedFlag;
@@ -187,5 +192,5 @@ private:
 	//
 
 	UINT64 m_lastMBUpdateCycle;
-	int m_numSamplesError;
+	double m_numAYSamplesRemainder;	// Fractional AY sample carried over to the next MB_Update()
 };
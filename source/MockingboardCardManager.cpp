@@ -35,6 +35,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "CPU.h"
 #include "MockingboardDefs.h"
 #include "Riff.h"
+#include "Capture.h"
 
 //#define DBG_MB_UPDATE
 
@@ -68,16 +69,12 @@ void MockingboardCardManager::InitializeForLoadingSnapshot()
 		return;
 
 	DSVoiceStop(&m_mockingboardVoice);	// Reason: 'MB voice is playing' then loading a save-state where 'no MB present' (GH#609)
+	m_resampler.Reset();
 }
 
+// NB. This also mutes the SSI263s (and SC01s), since they're mixed into this voice
 void MockingboardCardManager::MuteControl(bool mute)
 {
-	for (UINT i = SLOT0; i < NUM_SLOTS; i++)
-	{
-		if (IsMockingboard(i))
-			dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(i)).MuteControl(mute);
-	}
-
 	if (mute)
 	{
 		if (m_mockingboardVoice.bActive && !m_mockingboardVoice.bMute)
@@ -159,12 +156,6 @@ void MockingboardCardManager::SetVolume(uint32_t volume, uint32_t volumeMax)
 
 	if (m_mockingboardVoice.bActive && !m_mockingboardVoice.bMute)
 		m_mockingboardVoice.lpDSBvoice->SetVolume(m_mockingboardVoice.nVolume);
-
-	for (UINT i = SLOT0; i < NUM_SLOTS; i++)
-	{
-		if (IsMockingboard(i))
-			dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(i)).SetVolume(volume, volumeMax);
-	}
 }
 
 bool MockingboardCardManager::GetEnableExtraCardTypes()
@@ -182,15 +173,6 @@ bool MockingboardCardManager::GetEnableExtraCardTypes()
 }
 
 #ifdef _DEBUG
-void MockingboardCardManager::CheckCumulativeCycles()
-{
-	for (UINT i = SLOT0; i < NUM_SLOTS; i++)
-	{
-		if (IsMockingboard(i))
-			dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(i)).CheckCumulativeCycles();
-	}
-}
-
 void MockingboardCardManager::Get6522IrqDescription(std::string& desc)
 {
 	for (UINT i = SLOT0; i < NUM_SLOTS; i++)
@@ -241,6 +223,12 @@ void MockingboardCardManager::Update(const ULONG executedCycles)
 
 	m_cyclesThisAudioFrame %= kCyclesPerAudioFrame;
 
+	for (UINT i = SLOT0; i < NUM_SLOTS; i++)
+	{
+		if (IsMockingboard(i))
+			dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(i)).UpdateAudioCycles();
+	}
+
 	UpdateSoundBuffer();
 }
 
@@ -315,10 +303,7 @@ UINT MockingboardCardManager::GenerateAllSoundData()
 			continue;
 
 		MockingboardCard& MB = dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(slot));
-
-		MB.SetNumSamplesError(m_numSamplesError);
 		nNumSamples = MB.MB_Update();
-		m_numSamplesError = MB.GetNumSamplesError();
 	}
 
 	//
@@ -344,7 +329,7 @@ UINT MockingboardCardManager::GenerateAllSoundData()
 			LogOutput("%010.3f: [MBUpdt]    PC=%08X, WC=%08X, Diff=%08X, Off=%08X, NS=%08X %s\n",
 				fTicksSecs, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset, nNumSamples, tag);
 #endif
-			m_numSamplesError = 0;
+			m_resampler.SetRateTrim(0.0);
 		}
 	}
 
@@ -352,19 +337,20 @@ UINT MockingboardCardManager::GenerateAllSoundData()
 	if (nBytesRemaining < 0)
 		nBytesRemaining += SOUNDBUFFER_SIZE;
 
-	// Calc correction factor so that play-buffer doesn't under/overflow
-	const int nErrorInc = SoundCore_GetErrorInc();
-	if (nBytesRemaining < SOUNDBUFFER_SIZE / 4)
-		m_numSamplesError += nErrorInc;				// < 0.25 of buffer remaining
-	else if (nBytesRemaining > SOUNDBUFFER_SIZE / 2)
-		m_numSamplesError -= nErrorInc;				// > 0.50 of buffer remaining
-	else
-		m_numSamplesError = 0;						// Acceptable amount of data in buffer
+	// Trim the resampler's output rate so that play-buffer doesn't under/overflow
+	// . This is a small pitch change, rather than adding/dropping whole samples
+	// . Too little data: +ve trim (more output frames); too much data: -ve trim
+	const double fillError = RATE_TRIM_TARGET_FILL - (double)nBytesRemaining / SOUNDBUFFER_SIZE;
+	const double targetTrim = std::max<double>(std::min<double>(fillError * RATE_TRIM_GAIN, RATE_TRIM_MAX), -RATE_TRIM_MAX);
+
+	double rateTrim = m_resampler.GetRateTrim();
+	rateTrim += std::max<double>(std::min<double>(targetTrim - rateTrim, RATE_TRIM_SLEW), -RATE_TRIM_SLEW);
+	m_resampler.SetRateTrim(rateTrim);
 
 #ifdef DBG_MB_UPDATE
 	double fTicksSecs = (double)GetTickCount() / 1000.0;
 	// NB. removed outputting 'updateInterval' - would need to get it above from MB.MB_Update()
-	LogOutput("%010.3f: [MBUpdt]    PC=%08X, WC=%08X, Diff=%08X, Off=%08X, NS=%08X, NSE=%08X\n", fTicksSecs, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset, nNumSamples, m_numSamplesError);
+	LogOutput("%010.3f: [MBUpdt]    PC=%08X, WC=%08X, Diff=%08X, Off=%08X, NS=%08X, Trim=%f\n", fTicksSecs, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset, nNumSamples, rateTrim);
 #endif
 
 	return nNumSamples;
@@ -376,11 +362,16 @@ void MockingboardCardManager::MixAllAndCopyToRingBuffer(UINT nNumSamples)
 	const double fAttenuation = true ? 2.0 / 3.0 : 1.0;
 
 	short** slotAYVoiceBuffers[NUM_SLOTS] = {0};
+	const int* slotSpeechBuffers[NUM_SLOTS] = {0};
 
 	for (UINT slot = SLOT0; slot < NUM_SLOTS; slot++)
 	{
 		if (IsMockingboard(slot))
-			slotAYVoiceBuffers[slot] = dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(slot)).GetVoiceBuffers();
+		{
+			MockingboardCard& MB = dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(slot));
+			slotAYVoiceBuffers[slot] = MB.GetVoiceBuffers();
+			slotSpeechBuffers[slot] = MB.GetSpeechBuffer(nNumSamples);
+		}
 	}
 
 	for (UINT i = 0; i < nNumSamples; i++)
@@ -406,6 +397,13 @@ void MockingboardCardManager::MixAllAndCopyToRingBuffer(UINT nNumSamples)
 				nDataL += (int)((double)ppAYVoiceBuffer[1 * NUM_VOICES_PER_AY8913 + j][i] * fAttenuation);
 				nDataR += (int)((double)ppAYVoiceBuffer[3 * NUM_VOICES_PER_AY8913 + j][i] * fAttenuation);
 			}
+
+			// Speech (mono) is output to both speakers
+			if (slotSpeechBuffers[slot])
+			{
+				nDataL += slotSpeechBuffers[slot][i];
+				nDataR += slotSpeechBuffers[slot][i];
+			}
 		}
 
 		// Cap the superpositioned output
@@ -423,6 +421,19 @@ void MockingboardCardManager::MixAllAndCopyToRingBuffer(UINT nNumSamples)
 		m_mixBuffer[i * MockingboardCard::NUM_MB_CHANNELS + 1] = (short)nDataR;	// R
 	}
 
+	// Convert from the AYs' rate to the sound buffer's rate
+	// . NB. SetRates() does nothing unless a rate has changed (eg. g_fCurrentCLK6502)
+	m_resampler.SetRates(MockingboardCard::GetAYSampleRate(), MockingboardCard::SAMPLE_RATE);
+	nNumSamples = m_resampler.Process(&m_mixBuffer[0], nNumSamples, &m_outputBuffer[0], MAX_SAMPLES);
+	if (nNumSamples == 0)
+		return;
+
+	// Before locking the sound buffer: a failed (or lost) lock mustn't drop samples from the .wav output or the capture (eg. A/V sync)
+	if (m_outputToRiff)
+		RiffPutSamples(&m_outputBuffer[0], nNumSamples);
+
+	Capture_PutSamples(CAPTURE_VOICE_MOCKINGBOARD, &m_outputBuffer[0], nNumSamples, MockingboardCard::NUM_MB_CHANNELS);
+
 	//
 
 	DWORD dwDSLockedBufferSize0, dwDSLockedBufferSize1;
@@ -435,16 +446,13 @@ void MockingboardCardManager::MixAllAndCopyToRingBuffer(UINT nNumSamples)
 	if (FAILED(hr))
 		return;
 
-	memcpy(pDSLockedBuffer0, &m_mixBuffer[0], dwDSLockedBufferSize0);
+	memcpy(pDSLockedBuffer0, &m_outputBuffer[0], dwDSLockedBufferSize0);
 	if (pDSLockedBuffer1)
-		memcpy(pDSLockedBuffer1, &m_mixBuffer[dwDSLockedBufferSize0 / sizeof(short)], dwDSLockedBufferSize1);
+		memcpy(pDSLockedBuffer1, &m_outputBuffer[dwDSLockedBufferSize0 / sizeof(short)], dwDSLockedBufferSize1);
 
 	// Commit sound buffer
 	hr = m_mockingboardVoice.lpDSBvoice->Unlock((void*)pDSLockedBuffer0, dwDSLockedBufferSize0,
 		(void*)pDSLockedBuffer1, dwDSLockedBufferSize1);
 
 	m_byteOffset = (m_byteOffset + (uint32_t)nNumSamples * sizeof(short) * MockingboardCard::NUM_MB_CHANNELS) % SOUNDBUFFER_SIZE;
-
-	if (m_outputToRiff)
-		RiffPutSamples(&m_mixBuffer[0], nNumSamples);
 }
@@ -3,13 +3,13 @@
 #include "Core.h"
 #include "SoundCore.h"
 #include "Mockingboard.h"
+#include "Resampler.h"
 
 class MockingboardCardManager
 {
 public:
-	MockingboardCardManager()
+	MockingboardCardManager() : m_resampler(MockingboardCard::NUM_MB_CHANNELS)
 	{
-		m_numSamplesError = 0;
 		m_byteOffset = (uint32_t)-1;
 		m_cyclesThisAudioFrame = 0;
 		m_userVolume = 0;
@@ -40,12 +40,12 @@ public:
 	void Reset(const bool powerCycle)
 	{
 		m_cyclesThisAudioFrame = 0;
+		m_resampler.Reset();
 	}
 	void Update(const ULONG executedCycles);
 	void UpdateSoundBuffer();
 
 #ifdef _DEBUG
-	void CheckCumulativeCycles();
 	void Get6522IrqDescription(std::string& desc);
 #endif
 
@@ -60,12 +60,20 @@ private:
 	static const SHORT WAVE_DATA_MIN = (SHORT)0x8000;
 	static const SHORT WAVE_DATA_MAX = (SHORT)0x7FFF;
 
-	short m_mixBuffer[SOUNDBUFFER_SIZE / sizeof(short)];
+	// Resampler rate trim, to keep the ring-buffer around 0.375 full (ie. mid-way between 0.25 & 0.50)
+	// . proportional to the fill error, and slewed, so the (inaudibly small: max 0.5%) pitch change is smooth
+	static constexpr double RATE_TRIM_TARGET_FILL = 0.375;
+	static constexpr double RATE_TRIM_GAIN = 0.04;		// ie. max trim when 0.125 (the edge of the 0.25-0.50 band) from the target
+	static constexpr double RATE_TRIM_SLEW = 0.0005;	// max change per update
+	static constexpr double RATE_TRIM_MAX = 0.005;
+
+	short m_mixBuffer[SOUNDBUFFER_SIZE / sizeof(short)];		// At the AYs' rate
+	short m_outputBuffer[SOUNDBUFFER_SIZE / sizeof(short)];	// At SAMPLE_RATE
+	PolyphaseResampler m_resampler;
 	VOICE m_mockingboardVoice;
 
 	//
 
-	int m_numSamplesError;
 	uint32_t m_byteOffset;
 	UINT m_cyclesThisAudioFrame;
 	uint32_t m_userVolume;	// GUI's slide volume
@@ -311,6 +311,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 	static csbits_t csbits;		// charset, optionally followed by alt charset
 
+	static VidHDCard::SHRScanline g_shrScanline;
+	static int g_nSHRScanlineResolved = -1;	// scan-line that g_shrScanline was resolved for (-1 = none)
+
 // Prototypes
 	INLINE void      updateFramebufferTVSingleScanline( uint16_t signal, bgra_t *pTable );
 	INLINE void      updateFramebufferTVDoubleScanline( uint16_t signal, bgra_t *pTable );
@@ -731,6 +734,7 @@ inline void updateVideoScannerHorzEOL_SHR()
 	if (VIDEO_SCANNER_MAX_HORZ == ++g_nVideoClockHorz)
 	{
 		g_nVideoClockHorz = 0;
+		g_nSHRScanlineResolved = -1;	// re-fetch control byte & palette for the next scan-line
 
 		if (++g_nVideoClockVert == g_videoScannerMaxVert)
 		{
@@ -1873,20 +1877,16 @@ void updateScreenSHR(long cycles6502)
 
 			if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
 			{
+				if (g_nSHRScanlineResolved != g_nVideoClockVert)
+				{
+					VidHDCard::ResolveSHRScanline(g_nVideoClockVert, g_shrScanline);
+					g_nSHRScanlineResolved = g_nVideoClockVert;
+				}
+
 				uint32_t* pAux = (uint32_t*) MemGetAuxPtr(addr);	// 8 pixels (320 mode) / 16 pixels (640 mode)
 				uint32_t a = pAux[0];
 
-				uint8_t* pControl = MemGetAuxPtr(0x9D00 + g_nVideoClockVert);	// scan-line control byte
-				uint8_t c = pControl[0];
-
-				bool is640Mode = !!(c & 0x80);
-				bool isColorFillMode = !!(c & 0x20);
-				UINT paletteSelectCode = c & 0xf;
-				const UINT kColorsPerPalette = 16;
-				const UINT kColorSize = 2;
-				uint16_t addrPalette = 0x9E00 + paletteSelectCode * kColorsPerPalette * kColorSize;
-
-				VidHDCard::UpdateSHRCell(is640Mode, isColorFillMode, addrPalette, g_pVideoAddress, a);
+				VidHDCard::UpdateSHRCell(g_shrScanline, g_pVideoAddress, a);
 				g_pVideoAddress += 16;
 			}
 		}
@@ -1999,6 +1999,7 @@ void NTSC_SetVideoMode( uint32_t uVideoModeFlags, bool bDelay/*=false*/ )
 
 	if (uVideoModeFlags & VF_SHR)
 	{
+		g_nSHRScanlineResolved = -1;
 		g_pFuncUpdateGraphicsScreen = updateScreenSHR;
 		g_pFuncUpdateTextScreen = updateScreenSHR;
 		return;
@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "ParallelPrinter.h"
 #include "Core.h"
+#include "CPU.h"
 #include "Memory.h"
 #include "Pravets.h"
 #include "Registry.h"
@@ -52,43 +53,60 @@ void ParallelPrinterCard::InitializeIO(LPBYTE pCxRomPeripheral)
 	RegisterIoHandler(m_slot, IORead, IOWrite, NULL, NULL, this, NULL);
 }
 
+// Printed bytes are buffered, then passed to the PrinterOutput (which does the file writes on its own thread):
+// . when the buffer is full, and according to the flush policy (see PrinterFlush)
+static const size_t kPrintBufferSize = 64*1024;
+static const uint32_t kPrintFlushIdleCycles = 71000;	// ~0.1 sec
+
 //===========================================================================
 bool ParallelPrinterCard::CheckPrint()
 {
 	m_inactivity = 0;
-	if (m_file == NULL)
+	m_lastAccessCycle = g_nCumulativeCycles;
+
+	// Update() is only needed once idle (NB. an earlier scheduled update is kept, and Update() re-schedules from the last access)
+	ScheduleUpdateIn((m_flush == PRINTER_FLUSH_IDLE ? kPrintFlushIdleCycles : GetIdleLimitCycles()) + 1);
+
+	if (!m_bJobActive)
 	{
-		//char filepath[MAX_PATH * 2];
-		//strncpy(filepath, g_sProgramDir, MAX_PATH);
-		//_tcsncat(filepath, "Printer.txt", MAX_PATH);
-		//file = fopen(filepath, "wb");
-		if (m_bPrinterAppend )
-			m_file = fopen(ParallelPrinterCard::GetFilename().c_str(), "ab");
-		else
-			m_file = fopen(ParallelPrinterCard::GetFilename().c_str(), "wb");
+		// Start a new job: the print-file is opened on the PrinterOutput's thread
+		PrinterJob job;
+		job.filename = ParallelPrinterCard::GetFilename();
+		job.append = m_bPrinterAppend;
+		job.dumpToPrinter = m_bDumpToPrinter;
+		job.perJobFiles = m_bPerJobFiles;
+		job.convert = m_convert;
+		m_pOutput->StartJob(job);
+		m_bJobActive = true;
 	}
-	return (m_file != NULL);
+	return true;
+}
+
+//===========================================================================
+void ParallelPrinterCard::FlushPrint()
+{
+	m_pOutput->Write(m_buffer);
 }
 
 //===========================================================================
 void ParallelPrinterCard::ClosePrint()
 {
-	if (m_file != NULL)
+	if (m_bJobActive)
 	{
-		fclose(m_file);
-		m_file = NULL;
-#ifdef _WIN32
-		std::string ExtendedFileName = "copy \"";
-		ExtendedFileName.append (ParallelPrinterCard::GetFilename());
-		ExtendedFileName.append ("\" prn");
-		//if (g_bDumpToPrinter) ShellExecute(NULL, "print", Printer_GetFilename(), NULL, NULL, 0); //Print through Notepad
-		if (m_bDumpToPrinter)
-			system (ExtendedFileName.c_str ()); //Print through console. This is supposed to be the better way, because it shall print images (with older printers only).
-#endif
+		FlushPrint();
+		m_pOutput->EndJob();	// Closes the print-file (and dumps it to the printer, if enabled)
+		m_bJobActive = false;
 	}
 	m_inactivity = 0;
 }
 
+//===========================================================================
+ParallelPrinterCard::~ParallelPrinterCard()
+{
+	ClosePrint();
+	delete m_pOutput;	// Waits for all the output to be written
+}
+
 //===========================================================================
 void ParallelPrinterCard::Destroy()
 {
@@ -98,15 +116,29 @@ void ParallelPrinterCard::Destroy()
 //===========================================================================
 void ParallelPrinterCard::Update(const ULONG nExecutedCycles)
 {
-	if (m_file == NULL)
+	if (!m_bJobActive)
 		return;
 
+	// NB. Only scheduled from the last access, so use that rather than nExecutedCycles
+	const UINT64 inactivity = (g_nCumulativeCycles > m_lastAccessCycle) ? g_nCumulativeCycles - m_lastAccessCycle : 0;
+	m_inactivity = (uint32_t)std::min<UINT64>(inactivity, UINT32_MAX);
+
+	if (m_flush == PRINTER_FLUSH_IDLE && !m_buffer.empty() && m_inactivity > kPrintFlushIdleCycles)
+		FlushPrint();
+
 //	if ((inactivity += totalcycles) > (Printer_GetIdleLimit () * 1000 * 1000))  //This line seems to give a very big deviation
-	if ((m_inactivity += nExecutedCycles) > (ParallelPrinterCard::GetIdleLimit () * 710000))
+	const uint32_t idleLimitCycles = GetIdleLimitCycles();
+	if (m_inactivity > idleLimitCycles)
 	{
 		// inactive, so close the file (next print will overwrite or append to it, according to the settings made)
 		ClosePrint();
+		return;
 	}
+
+	uint32_t nextUpdate = idleLimitCycles - m_inactivity + 1;
+	if (m_flush == PRINTER_FLUSH_IDLE && !m_buffer.empty())
+		nextUpdate = std::min<uint32_t>(nextUpdate, kPrintFlushIdleCycles - m_inactivity + 1);
+	ScheduleUpdateIn(nextUpdate);
 }
 
 //===========================================================================
@@ -147,7 +179,12 @@ BYTE __stdcall ParallelPrinterCard::IOWrite(WORD, WORD address, BYTE, BYTE value
 	}
 
 	if ((card->m_bFilterUnprintable == false) || (c>31) || (c==13) || (c==10) || (c>0x7F)) //c>0x7F is needed for cyrillic characters
-		fwrite(&c, 1, 1, card->m_file);
+	{
+		card->m_buffer.push_back(c);
+
+		if (card->m_buffer.size() >= kPrintBufferSize || (card->m_flush == PRINTER_FLUSH_LINE && (c == 13 || c == 10)))
+			card->FlushPrint();
+	}
 
 	return 0;
 }
@@ -239,7 +276,7 @@ void ParallelPrinterCard::SaveSnapshot(class YamlSaveHelper& yamlSaveHelper)
 	yamlSaveHelper.SaveUint(SS_YAML_KEY_INACTIVITY, m_inactivity);
 	yamlSaveHelper.SaveUint(SS_YAML_KEY_IDLELIMIT, m_printerIdleLimit);
 	yamlSaveHelper.SaveString(SS_YAML_KEY_FILENAME, m_szPrintFilename);
-	yamlSaveHelper.SaveBool(SS_YAML_KEY_FILEOPEN, (m_file != NULL));
+	yamlSaveHelper.SaveBool(SS_YAML_KEY_FILEOPEN, m_bJobActive);
 	yamlSaveHelper.SaveBool(SS_YAML_KEY_DUMPTOPRINTER, m_bDumpToPrinter);
 	yamlSaveHelper.SaveBool(SS_YAML_KEY_CONVERTENCODING, m_bConvertEncoding);
 	yamlSaveHelper.SaveBool(SS_YAML_KEY_FILTERUNPRINTABLE, m_bFilterUnprintable);
@@ -260,9 +297,15 @@ bool ParallelPrinterCard::LoadSnapshot(class YamlLoadHelper& yamlLoadHelper, UIN
 	{
 		yamlLoadHelper.LoadBool(SS_YAML_KEY_APPEND);	// Consume
 		m_bPrinterAppend = true;	// Re-open print-file in append mode
-		const bool bRes = CheckPrint();
-		if (!bRes)
+
+		// The print-file is opened asynchronously, so check now that it can be
+		FILE* file = fopen(GetFilename().c_str(), "ab");
+		if (!file)
 			throw std::runtime_error("Printer Card: Unable to resume printing to file");
+		fclose(file);
+
+		ClosePrint();	// End any current job first
+		CheckPrint();
 	}
 	else
 	{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Card.h"
+#include "PrinterOutput.h"
 
 class ParallelPrinterCard : public Card
 {
@@ -12,11 +13,17 @@ public:
 			ThrowErrorInvalidSlot();
 
 		m_inactivity = 0;
-		m_file = NULL;
+		m_lastAccessCycle = 0;
+		m_bJobActive = false;
+		m_pOutput = new PrinterOutput;
+
+		m_flush = PRINTER_FLUSH_IDLE;
+		m_bPerJobFiles = false;
+		m_convert = PRINTER_CONVERT_NONE;
 
 		ResetDefaultOptions();
 	}
-	virtual ~ParallelPrinterCard() {}
+	virtual ~ParallelPrinterCard();
 
 	virtual void Destroy();
 	virtual void Reset(const bool powerCycle);
@@ -59,6 +66,9 @@ public:
 	void SetPrinterAppend(bool value) { m_bPrinterAppend = value; }
 	bool GetEnableDumpToRealPrinter() { return m_bEnableDumpToRealPrinter; }
 	void SetEnableDumpToRealPrinter(bool value) { m_bEnableDumpToRealPrinter = value; }	// Set by cmd-line only
+	void SetFlush(PrinterFlush value) { m_flush = value; }				// Set by cmd-line only
+	void SetPerJobFiles(bool value) { m_bPerJobFiles = value; }			// Set by cmd-line only
+	void SetConvert(PrinterConvert value) { m_convert = value; }		// Set by cmd-line only
 
 	void ResetDefaultOptions()
 	{
@@ -76,9 +86,14 @@ public:
 private:
 	bool CheckPrint();
 	void ClosePrint();
+	void FlushPrint();
+	uint32_t GetIdleLimitCycles() { return GetIdleLimit() * 710000; }
 
 	uint32_t m_inactivity;
-	FILE* m_file;
+	UINT64 m_lastAccessCycle;		// For m_inactivity
+	bool m_bJobActive;
+	std::vector<BYTE> m_buffer;		// Printed, but not yet passed to m_pOutput
+	PrinterOutput* m_pOutput;		// Writes the output on a background thread
 	std::string m_szPrintFilename;
 
 	UINT m_printerIdleLimit;
@@ -87,4 +102,7 @@ private:
 	bool m_bFilterUnprintable;
 	bool m_bPrinterAppend;
 	bool m_bEnableDumpToRealPrinter;	// Set by cmd-line: -printer-real
+	PrinterFlush m_flush;				// Set by cmd-line: -printer-flush
+	bool m_bPerJobFiles;				// Set by cmd-line: -printer-per-job
+	PrinterConvert m_convert;			// Set by cmd-line: -printer-convert
 };
@@ -0,0 +1,589 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Parallel printer output - sinks, converters, and the background thread that drives them
+ *
+ * Converters (to plain text) are best-effort: printable characters & line breaks are kept, and the
+ * printer's escape sequences (including any graphics data) are skipped.
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "PrinterOutput.h"
+#include "Log.h"
+
+//===========================================================================
+
+namespace
+{
+	// Plain file: overwrite or append, as for the original single print-file
+	class PrinterFileSink : public PrinterSink
+	{
+	public:
+		PrinterFileSink() : m_file(NULL), m_dumpToPrinter(false) {}
+		virtual ~PrinterFileSink() { Close(); }
+
+		virtual bool Open(const PrinterJob& job)
+		{
+			m_filename = GetJobFilename(job);
+			m_dumpToPrinter = job.dumpToPrinter;
+			m_file = fopen(m_filename.c_str(), job.append ? "ab" : "wb");
+			return m_file != NULL;
+		}
+
+		virtual void Write(const BYTE* pData, size_t size)
+		{
+			if (m_file && size)
+				fwrite(pData, 1, size, m_file);
+		}
+
+		virtual void Close()
+		{
+			if (!m_file)
+				return;
+
+			fclose(m_file);
+			m_file = NULL;
+#ifdef _WIN32
+			if (m_dumpToPrinter)
+			{
+				const std::string command = "copy \"" + m_filename + "\" prn";
+				system(command.c_str());	// Print through console. This is supposed to be the better way, because it shall print images (with older printers only).
+			}
+#endif
+		}
+
+	protected:
+		virtual std::string GetJobFilename(const PrinterJob& job) { return job.filename; }
+
+	private:
+		FILE* m_file;
+		std::string m_filename;
+		bool m_dumpToPrinter;
+	};
+
+	// Each job to a new file: <filename>-NNNN.<ext>, numbered after any existing files
+	class PrinterJobFileSink : public PrinterFileSink
+	{
+	public:
+		PrinterJobFileSink() : m_jobNum(0) {}
+
+	protected:
+		virtual std::string GetJobFilename(const PrinterJob& job)
+		{
+			std::string base = job.filename;
+			std::string ext;
+			const size_t dot = base.find_last_of('.');
+			const size_t sep = base.find_last_of("\\/");
+			if (dot != std::string::npos && (sep == std::string::npos || dot > sep))
+			{
+				ext = base.substr(dot);
+				base = base.substr(0, dot);
+			}
+
+			while (true)
+			{
+				const std::string filename = StrFormat("%s-%04u%s", base.c_str(), ++m_jobNum, ext.c_str());
+				FILE* file = fopen(filename.c_str(), "rb");
+				if (!file)
+					return filename;
+				fclose(file);
+			}
+		}
+
+	private:
+		UINT m_jobNum;
+	};
+}
+
+PrinterSink* PrinterSink::Create(const PrinterJob& job)
+{
+	if (job.perJobFiles)
+		return new PrinterJobFileSink;
+
+	return new PrinterFileSink;
+}
+
+//===========================================================================
+
+namespace
+{
+	// Keeps the text, and skips the escape sequences that the derived class decodes
+	class PrinterTextFilter : public PrinterFilter
+	{
+	public:
+		PrinterTextFilter() : m_state(STATE_TEXT), m_command(0), m_numParams(0), m_skip(0), m_terminator(0), m_lastChar(0) {}
+		virtual ~PrinterTextFilter() {}
+
+		virtual void Process(const BYTE* pData, size_t size, std::vector<BYTE>& out);
+
+	protected:
+		static const BYTE ESC = 0x1B;
+
+		// Called for 'ESC <command>', and then after each group of parameters is collected, until it calls none of Params/Skip/SkipUntil
+		virtual void Escape(BYTE command, const std::vector<BYTE>& params, std::vector<BYTE>& out) = 0;
+
+		void Params(UINT n) { m_numParams = n; }
+		void Skip(UINT n) { m_skip = n; }
+		void SkipUntil(BYTE terminator) { m_terminator = terminator; m_state = STATE_UNTIL; }
+		void Text(BYTE c, std::vector<BYTE>& out);
+
+		static UINT Digits(const std::vector<BYTE>& params, size_t start, size_t count);	// ASCII decimal
+		static UINT Word(const std::vector<BYTE>& params, size_t start) { return params[start] | (params[start + 1] << 8); }
+
+	private:
+		void NextEscape(std::vector<BYTE>& out);
+
+		enum State { STATE_TEXT, STATE_COMMAND, STATE_PARAMS, STATE_SKIP, STATE_UNTIL };
+		State m_state;
+		BYTE m_command;
+		std::vector<BYTE> m_params;
+		UINT m_numParams;
+		UINT m_skip;
+		BYTE m_terminator;
+		BYTE m_lastChar;
+	};
+
+	void PrinterTextFilter::Process(const BYTE* pData, size_t size, std::vector<BYTE>& out)
+	{
+		for (size_t i = 0; i < size; i++)
+		{
+			const BYTE c = pData[i];
+
+			switch (m_state)
+			{
+			case STATE_TEXT:
+				if (c == ESC)
+					m_state = STATE_COMMAND;
+				else
+					Text(c, out);
+				break;
+
+			case STATE_COMMAND:
+				m_command = c;
+				m_params.clear();
+				m_numParams = m_skip = 0;
+				Escape(m_command, m_params, out);
+				NextEscape(out);
+				break;
+
+			case STATE_PARAMS:
+				m_params.push_back(c);
+				if (--m_numParams == 0)
+				{
+					Escape(m_command, m_params, out);
+					NextEscape(out);
+				}
+				break;
+
+			case STATE_SKIP:
+				if (--m_skip == 0)
+					m_state = STATE_TEXT;
+				break;
+
+			case STATE_UNTIL:
+				if (c == m_terminator)
+					m_state = STATE_TEXT;
+				break;
+			}
+		}
+	}
+
+	void PrinterTextFilter::NextEscape(std::vector<BYTE>& out)
+	{
+		if (m_state == STATE_UNTIL)
+			return;
+
+		if (m_numParams)
+			m_state = STATE_PARAMS;
+		else if (m_skip)
+			m_state = STATE_SKIP;
+		else
+			m_state = STATE_TEXT;
+	}
+
+	void PrinterTextFilter::Text(BYTE c, std::vector<BYTE>& out)
+	{
+		const BYTE lastChar = m_lastChar;
+		m_lastChar = c;
+
+		if (c == 0x0D)				// CR: the Apple's printer driver relies on the printer's auto line-feed
+		{
+			out.push_back(0x0D);
+			out.push_back(0x0A);
+		}
+		else if (c == 0x0A)			// LF: unless it's after a CR
+		{
+			if (lastChar != 0x0D)
+			{
+				out.push_back(0x0D);
+				out.push_back(0x0A);
+			}
+		}
+		else if (c == 0x09 || c == 0x0C || (c >= 0x20 && c != 0x7F))	// Tab, form-feed, or printable (c>0x7F is needed for cyrillic characters)
+		{
+			out.push_back(c);
+		}
+	}
+
+	UINT PrinterTextFilter::Digits(const std::vector<BYTE>& params, size_t start, size_t count)
+	{
+		UINT n = 0;
+		for (size_t i = start; i < start + count; i++)
+		{
+			if (params[i] >= '0' && params[i] <= '9')
+				n = n * 10 + (params[i] - '0');
+		}
+		return n;
+	}
+
+	//-----------------------------------------------------------------------
+
+	// Epson ESC/P (and ESC/P2)
+	class EscpTextFilter : public PrinterTextFilter
+	{
+	protected:
+		virtual void Escape(BYTE command, const std::vector<BYTE>& params, std::vector<BYTE>& out)
+		{
+			const size_t n = params.size();
+
+			switch (command)
+			{
+			// 1 parameter
+			case '!': case '%': case '-': case '+': case '/': case '3': case 'A': case 'I': case 'J': case 'N':
+			case 'Q': case 'R': case 'S': case 'U': case 'W': case 'a': case 'i': case 'j': case 'k': case 'l':
+			case 'p': case 'q': case 'r': case 's': case 't': case 'w': case 'x':
+				if (n == 0) Params(1);
+				break;
+			// 2 parameters
+			case '$': case '\\': case '?': case 'c':
+				if (n == 0) Params(2);
+				break;
+			case ':':
+				if (n == 0) Params(3);
+				break;
+			case 'C':	// Page length: in lines, or 'ESC C 0 n' in inches
+				if (n == 0) Params(1);
+				else if (n == 1 && params[0] == 0) Params(1);
+				break;
+			// Bit image: 'ESC K n1 n2 <data>'
+			case 'K': case 'L': case 'Y': case 'Z':
+				if (n == 0) Params(2);
+				else Skip(Word(params, 0));
+				break;
+			// Bit image: 'ESC * m n1 n2 <data>', with 1, 3 or 6 bytes per column
+			case '*':
+				if (n == 0) Params(3);
+				else Skip(Word(params, 1) * ((params[0] >= 70) ? 6 : (params[0] >= 32) ? 3 : 1));
+				break;
+			// 9-pin graphics: 'ESC ^ m n1 n2 <data>', with 1 or 2 bytes per column
+			case '^':
+				if (n == 0) Params(3);
+				else Skip(Word(params, 1) * (params[0] ? 2 : 1));
+				break;
+			// Extended commands: 'ESC ( c nL nH <data>'
+			case '(':
+				if (n == 0) Params(3);
+				else Skip(Word(params, 1));
+				break;
+			// Raster graphics: 'ESC . c v h m nL nH <data>' (NB. the size is only known if it's uncompressed)
+			case '.':
+				if (n == 0) Params(6);
+				else if (params[0] == 0) Skip(params[3] * ((Word(params, 4) + 7) / 8));
+				break;
+			// Tab stops
+			case 'B': case 'D':
+				SkipUntil(0x00);
+				break;
+			case 'b':
+				if (n == 0) Params(1);
+				else SkipUntil(0x00);
+				break;
+			default:	// No parameters
+				break;
+			}
+		}
+	};
+
+	//-----------------------------------------------------------------------
+
+	// Apple ImageWriter (and ImageWriter II): numeric parameters are ASCII decimal digits
+	class ImageWriterTextFilter : public PrinterTextFilter
+	{
+	protected:
+		virtual void Escape(BYTE command, const std::vector<BYTE>& params, std::vector<BYTE>& out)
+		{
+			const size_t n = params.size();
+
+			switch (command)
+			{
+			// 1 parameter
+			case 'a': case 'K': case 'l': case 's':
+				if (n == 0) Params(1);
+				break;
+			// 2 parameters
+			case 'D': case 'Z': case 'T':
+				if (n == 0) Params(2);
+				break;
+			// 3 digits
+			case 'L':
+				if (n == 0) Params(3);
+				break;
+			// 4 digits
+			case 'F': case 'H':
+				if (n == 0) Params(4);
+				break;
+			// Graphics: 'ESC G nnnn <data>'
+			case 'G': case 'S':
+				if (n == 0) Params(4);
+				else Skip(Digits(params, 0, 4));
+				break;
+			// Graphics: 'ESC g nnn <data>', in groups of 8
+			case 'g':
+				if (n == 0) Params(3);
+				else Skip(Digits(params, 0, 3) * 8);
+				break;
+			// Repeat a graphics column: 'ESC V nnnn c'
+			case 'V':
+				if (n == 0) Params(5);
+				break;
+			// Repeat a character: 'ESC R nnn c'
+			case 'R':
+				if (n == 0)
+				{
+					Params(4);
+				}
+				else
+				{
+					for (UINT i = Digits(params, 0, 3); i > 0; i--)
+						Text(params[3], out);
+				}
+				break;
+			// Tab stops: 'ESC ( nnn,nnn,...,nnn.'
+			case '(': case ')': case 'u':
+				SkipUntil('.');
+				break;
+			// Custom characters: until ctrl-D
+			case 'I':
+				SkipUntil(0x04);
+				break;
+			default:	// No parameters
+				break;
+			}
+		}
+	};
+}
+
+PrinterFilter* PrinterFilter::Create(const PrinterJob& job)
+{
+	switch (job.convert)
+	{
+	case PRINTER_CONVERT_ESCP:			return new EscpTextFilter;
+	case PRINTER_CONVERT_IMAGEWRITER:	return new ImageWriterTextFilter;
+	default:							return NULL;
+	}
+}
+
+//===========================================================================
+
+PrinterOutput::PrinterOutput()
+	: m_hThread(NULL)
+	, m_hEvent(NULL)
+	, m_bStop(false)
+	, m_pSink(NULL)
+	, m_pFilter(NULL)
+{
+	InitializeCriticalSection(&m_cs);
+
+	m_hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	DWORD dwThreadId;
+	m_hThread = m_hEvent ? CreateThread(NULL, 0, WorkerThread, this, 0, &dwThreadId) : NULL;
+	if (!m_hThread)
+		LogFileOutput("PrinterOutput: Failed to create thread: printing is synchronous\n");
+}
+
+PrinterOutput::~PrinterOutput()
+{
+	if (m_hThread)
+	{
+		// Let the thread drain the queue, then exit
+		EnterCriticalSection(&m_cs);
+		m_bStop = true;
+		LeaveCriticalSection(&m_cs);
+		SetEvent(m_hEvent);
+
+		WaitForSingleObject(m_hThread, INFINITE);
+		CloseHandle(m_hThread);
+	}
+
+	if (m_hEvent)
+		CloseHandle(m_hEvent);
+
+	_ASSERT(m_queue.empty());
+	for (size_t i = 0; i < m_freePackets.size(); i++)
+		delete m_freePackets[i];
+
+	delete m_pFilter;
+	delete m_pSink;		// Closes any unfinished job
+
+	DeleteCriticalSection(&m_cs);
+}
+
+PrinterOutput::Packet* PrinterOutput::NewPacket(PacketType type)
+{
+	Packet* pPacket = NULL;
+
+	EnterCriticalSection(&m_cs);
+	if (!m_freePackets.empty())
+	{
+		pPacket = m_freePackets.back();
+		m_freePackets.pop_back();
+	}
+	LeaveCriticalSection(&m_cs);
+
+	if (!pPacket)
+		pPacket = new Packet;
+
+	pPacket->type = type;
+	return pPacket;
+}
+
+void PrinterOutput::Queue(Packet* pPacket)
+{
+	if (!m_hThread)
+	{
+		Process(pPacket);
+		return;
+	}
+
+	EnterCriticalSection(&m_cs);
+	m_queue.push_back(pPacket);
+	LeaveCriticalSection(&m_cs);
+	SetEvent(m_hEvent);
+}
+
+void PrinterOutput::StartJob(const PrinterJob& job)
+{
+	Packet* pPacket = NewPacket(PACKET_START_JOB);
+	pPacket->job = job;
+	Queue(pPacket);
+}
+
+void PrinterOutput::Write(std::vector<BYTE>& data)
+{
+	if (data.empty())
+		return;
+
+	Packet* pPacket = NewPacket(PACKET_DATA);
+	pPacket->data.swap(data);	// NB. 'data' gets the recycled packet's (empty) buffer
+	Queue(pPacket);
+}
+
+void PrinterOutput::EndJob()
+{
+	Queue(NewPacket(PACKET_END_JOB));
+}
+
+void PrinterOutput::Process(Packet* pPacket)
+{
+	switch (pPacket->type)
+	{
+	case PACKET_START_JOB:
+		delete m_pFilter;
+		delete m_pSink;
+		m_pFilter = PrinterFilter::Create(pPacket->job);
+		m_pSink = PrinterSink::Create(pPacket->job);
+		if (!m_pSink->Open(pPacket->job))
+		{
+			LogFileOutput("PrinterOutput: Failed to open print-file: %s\n", pPacket->job.filename.c_str());
+			delete m_pSink;
+			m_pSink = NULL;		// Discard the job's output
+		}
+		break;
+
+	case PACKET_DATA:
+		if (!m_pSink)
+			break;
+
+		if (m_pFilter)
+		{
+			m_converted.clear();
+			m_pFilter->Process(&pPacket->data[0], pPacket->data.size(), m_converted);
+			if (!m_converted.empty())
+				m_pSink->Write(&m_converted[0], m_converted.size());
+		}
+		else
+		{
+			m_pSink->Write(&pPacket->data[0], pPacket->data.size());
+		}
+		break;
+
+	case PACKET_END_JOB:
+		if (m_pSink)
+			m_pSink->Close();
+		delete m_pSink;
+		delete m_pFilter;
+		m_pSink = NULL;
+		m_pFilter = NULL;
+		break;
+	}
+
+	pPacket->data.clear();	// Keep the capacity for reuse
+
+	EnterCriticalSection(&m_cs);
+	m_freePackets.push_back(pPacket);
+	LeaveCriticalSection(&m_cs);
+}
+
+DWORD WINAPI PrinterOutput::WorkerThread(LPVOID lpParameter)
+{
+	PrinterOutput* pThis = (PrinterOutput*)lpParameter;
+
+	while (true)
+	{
+		EnterCriticalSection(&pThis->m_cs);
+		Packet* pPacket = NULL;
+		if (!pThis->m_queue.empty())
+		{
+			pPacket = pThis->m_queue.front();
+			pThis->m_queue.pop_front();
+		}
+		const bool bStop = pThis->m_bStop;
+		LeaveCriticalSection(&pThis->m_cs);
+
+		if (!pPacket)
+		{
+			if (bStop)
+				break;		// Only once the queue is drained
+
+			WaitForSingleObject(pThis->m_hEvent, INFINITE);
+			continue;
+		}
+
+		pThis->Process(pPacket);
+	}
+
+	return 0;
+}
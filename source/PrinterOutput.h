@@ -0,0 +1,93 @@
+#pragma once
+
+// Parallel printer output (see ParallelPrinterCard)
+// . The card just buffers the printed bytes, then passes them to a PrinterOutput in batches (see PrinterFlush).
+// . A PrinterOutput's background thread converts each job (see PrinterConvert) and writes it to a sink (see PrinterSink).
+// . A job starts when the printer is first accessed, and ends when it has been idle for the idle limit (or on reset).
+
+enum PrinterFlush
+{
+	PRINTER_FLUSH_IDLE,		// When the printer is briefly idle (default)
+	PRINTER_FLUSH_LINE,		// At the end of each line
+	PRINTER_FLUSH_JOB,		// Only at the end of the job (or when the buffer is full)
+};
+
+enum PrinterConvert
+{
+	PRINTER_CONVERT_NONE,			// Raw bytes
+	PRINTER_CONVERT_ESCP,			// Epson ESC/P to plain text
+	PRINTER_CONVERT_IMAGEWRITER,	// Apple ImageWriter to plain text
+};
+
+struct PrinterJob
+{
+	PrinterJob() : append(false), dumpToPrinter(false), perJobFiles(false), convert(PRINTER_CONVERT_NONE) {}
+
+	std::string filename;
+	bool append;
+	bool dumpToPrinter;		// At the end of the job, copy the file to the (Windows) printer
+	bool perJobFiles;		// Each job to a new file: <filename>-NNNN.<ext>
+	PrinterConvert convert;
+};
+
+// Converts a job's byte stream (eg. to plain text)
+class PrinterFilter
+{
+public:
+	virtual ~PrinterFilter() {}
+	virtual void Process(const BYTE* pData, size_t size, std::vector<BYTE>& out) = 0;
+
+	static PrinterFilter* Create(const PrinterJob& job);	// NULL for PRINTER_CONVERT_NONE
+};
+
+// Where a job's (converted) output is written
+class PrinterSink
+{
+public:
+	virtual ~PrinterSink() {}
+	virtual bool Open(const PrinterJob& job) = 0;
+	virtual void Write(const BYTE* pData, size_t size) = 0;
+	virtual void Close() = 0;
+
+	static PrinterSink* Create(const PrinterJob& job);
+};
+
+class PrinterOutput
+{
+public:
+	PrinterOutput();
+	~PrinterOutput();	// Waits for all the output to be written
+
+	// Emulation thread: these just queue the request for the background thread
+	void StartJob(const PrinterJob& job);
+	void Write(std::vector<BYTE>& data);	// Takes the data (so 'data' is returned empty)
+	void EndJob();
+
+private:
+	enum PacketType { PACKET_START_JOB, PACKET_DATA, PACKET_END_JOB };
+
+	struct Packet
+	{
+		PacketType type;
+		PrinterJob job;
+		std::vector<BYTE> data;
+	};
+
+	Packet* NewPacket(PacketType type);
+	void Queue(Packet* pPacket);
+	void Process(Packet* pPacket);
+
+	static DWORD WINAPI WorkerThread(LPVOID lpParameter);
+
+	HANDLE m_hThread;
+	HANDLE m_hEvent;
+	CRITICAL_SECTION m_cs;			// Protects m_queue, m_freePackets & m_bStop
+	std::deque<Packet*> m_queue;
+	std::vector<Packet*> m_freePackets;
+	bool m_bStop;
+
+	// Background thread
+	PrinterSink* m_pSink;			// NULL if no job (or if the job's sink failed to open)
+	PrinterFilter* m_pFilter;		// NULL if not converting
+	std::vector<BYTE> m_converted;
+};
@@ -1010,3 +1010,77 @@ void Format_DOS33_Disk( const std::string & pathname, FrameBase *pFrame )
 		pFrame->FrameMessageBox( "ERROR: Unable to open disk image for writing DOS 3.3 file system", "Format", MB_ICONWARNING | MB_OK);
 	}
 }
+
+bool ProDOS_GetCatalog( const uint8_t *pImage, const size_t nImageSize, const bool bIsDOS33Order,
+	std::string & sVolumeName_, std::vector<ProDOS_CatalogEntry_t> & vEntries_ )
+{
+	sVolumeName_.clear();
+	vEntries_.clear();
+
+	const size_t nBlocks = nImageSize / PRODOS_BLOCK_SIZE;
+	if (nBlocks <= PRODOS_ROOT_BLOCK)
+		return false;
+
+	// NB. The ProDOS_Get*() helpers only read, so for a ProDOS order image there's no need to copy (eg. a 32MB .hdv)
+	std::vector<uint8_t> vSwizzled;
+	uint8_t *pDiskBytes = const_cast<uint8_t*>( pImage );
+	if (bIsDOS33Order)
+	{
+		vSwizzled.assign( pImage, pImage + nImageSize );
+		Util_ProDOS_ForwardSectorInterleave( vSwizzled.data(), nImageSize, INTERLEAVE_DOS33_ORDER );
+		pDiskBytes = vSwizzled.data();
+	}
+
+	ProDOS_VolumeHeader_t tVolume;
+	ProDOS_GetVolumeHeader( pDiskBytes, &tVolume, PRODOS_ROOT_BLOCK );
+
+	// Reject anything that doesn't look like a volume directory header (eg. a DOS 3.3 disk)
+	if (tVolume.kind != PRODOS_KIND_ROOT
+		|| tVolume.len == 0
+		|| tVolume.entry_len < 0x27
+		|| tVolume.entry_num == 0
+		|| 4 + (size_t)tVolume.entry_len * tVolume.entry_num > PRODOS_BLOCK_SIZE)
+		return false;
+
+	sVolumeName_ = tVolume.name;
+
+	// Walk the root directory's linked list of blocks. The 1st entry of the 1st block is the volume header.
+	// The walk is bounded by the image's block count, in case of a corrupt (circular) list.
+	int  iBlock  = PRODOS_ROOT_BLOCK;
+	bool bHeader = true;
+	for (size_t nVisited = 0; iBlock && nVisited < nBlocks; nVisited++)
+	{
+		if ((size_t)iBlock >= nBlocks)
+			break;
+
+		const int nBase   = iBlock * PRODOS_BLOCK_SIZE;
+		int       iOffset = nBase + 4; // Prev Block, Next Block
+
+		for (int iEntry = 0; iEntry < tVolume.entry_num; iEntry++, iOffset += tVolume.entry_len)
+		{
+			if (bHeader)
+			{
+				bHeader = false;
+				continue;
+			}
+
+			ProDOS_FileHeader_t file;
+			ProDOS_GetFileHeader( pDiskBytes, iOffset, &file );
+
+			if (file.kind == PRODOS_KIND_DEL || file.len == 0)
+				continue;
+
+			ProDOS_CatalogEntry_t entry;
+			entry.name   = file.name;
+			entry.kind   = file.kind;
+			entry.type   = file.type;
+			entry.blocks = file.blocks;
+			entry.size   = file.size;
+			vEntries_.push_back( entry );
+		}
+
+		iBlock = ProDOS_Get16( pDiskBytes, nBase + 2 );
+	}
+
+	return true;
+}
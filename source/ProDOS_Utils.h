@@ -32,3 +32,15 @@ void New_Blank_Disk( const char * pTitle, const std::string & pathname,
 	const size_t nDiskSize, const bool bIsHardDisk, FrameBase *pFrame );      // file will be overwritten
 void Format_ProDOS_Disk( const std::string & pathname, FrameBase *pFrame);  // file must exist
 void Format_DOS33_Disk( const std::string & pathname, FrameBase *pFrame);   // file must exist
+
+struct ProDOS_CatalogEntry_t
+{
+	std::string name;
+	uint8_t     kind;   // storage type
+	uint8_t     type;   // file type
+	uint16_t    blocks;
+	uint32_t    size;   // EOF
+};
+
+bool ProDOS_GetCatalog( const uint8_t *pImage, const size_t nImageSize, const bool bIsDOS33Order,
+	std::string & sVolumeName_, std::vector<ProDOS_CatalogEntry_t> & vEntries_ ); // root directory only, false if not a ProDOS volume
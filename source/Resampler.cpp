@@ -0,0 +1,158 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Polyphase sample rate converter
+ *
+ * Each output frame is the dot-product of m_numTaps input frames with one phase of a windowed-sinc
+ * low-pass filter, picked by the output frame's fractional position between input frames.
+ * The cut-off is just below the lower of the two Nyquist frequencies, so up-sampling doesn't image
+ * and down-sampling doesn't alias.
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "Resampler.h"
+
+PolyphaseResampler::PolyphaseResampler(UINT numChannels)
+	: m_numChannels(numChannels)
+	, m_numTaps(0)
+	, m_inputRate(0.0)
+	, m_outputRate(0.0)
+	, m_rateTrim(0.0)
+	, m_numHistoryFrames(0)
+	, m_position(0.0)
+{
+}
+
+void PolyphaseResampler::SetRates(double inputRate, double outputRate)
+{
+	_ASSERT(inputRate > 0.0 && outputRate > 0.0);
+	if (inputRate == m_inputRate && outputRate == m_outputRate)
+		return;
+
+	m_inputRate = inputRate;
+	m_outputRate = outputRate;
+	InitFilter();
+	Reset();
+}
+
+void PolyphaseResampler::Reset()
+{
+	// Start with silent history, so the first output frames ramp in from 0
+	m_numHistoryFrames = m_numTaps ? m_numTaps - 1 : 0;
+	m_input.assign(m_numHistoryFrames * m_numChannels, 0.0f);
+	m_position = 0.0;
+}
+
+void PolyphaseResampler::InitFilter()
+{
+	const double PI = 3.14159265358979323846;
+
+	// Cut-off, as a fraction of the input's Nyquist frequency
+	// . 0.9: leave room for the window's transition band
+	const double fCutoff = 0.9 * std::min<double>(1.0, m_outputRate / m_inputRate);
+
+	// Keep the filter's length (in output samples) constant, so down-sampling gets more taps
+	m_numTaps = 2 * (UINT)ceil(8.0 / fCutoff);
+	m_filter.resize(kNumPhases * m_numTaps);
+
+	for (UINT phase = 0; phase < kNumPhases; phase++)
+	{
+		float* pTaps = &m_filter[phase * m_numTaps];
+		double fSum = 0.0;
+
+		for (UINT i = 0; i < m_numTaps; i++)
+		{
+			// Distance (in input frames) of this tap from the output frame, with the filter centred on it
+			const double x = (double)i - (double)(m_numTaps / 2 - 1) - (double)phase / (double)kNumPhases;
+			const double sinc = (x == 0.0) ? 1.0 : sin(PI * fCutoff * x) / (PI * fCutoff * x);
+			const double w = 2.0 * PI * x / (double)m_numTaps;	// Blackman window, over [-m_numTaps/2, +m_numTaps/2]
+			const double window = 0.42 + 0.5 * cos(w) + 0.08 * cos(2.0 * w);
+			pTaps[i] = (float)(sinc * window);
+			fSum += pTaps[i];
+		}
+
+		// Unity gain at DC for every phase, so a constant input gives a constant output
+		for (UINT i = 0; i < m_numTaps; i++)
+			pTaps[i] = (float)(pTaps[i] / fSum);
+	}
+}
+
+UINT PolyphaseResampler::Process(const short* pIn, UINT numInFrames, short* pOut, UINT maxOutFrames)
+{
+	_ASSERT(m_numTaps);
+	if (!m_numTaps)
+		return 0;
+
+	// Append the new frames after the history
+	const UINT numFrames = m_numHistoryFrames + numInFrames;
+	m_input.resize(numFrames * m_numChannels);
+	float* pInput = &m_input[m_numHistoryFrames * m_numChannels];
+	for (UINT i = 0; i < numInFrames * m_numChannels; i++)
+		pInput[i] = (float)pIn[i];
+
+	const double step = (m_inputRate / m_outputRate) / (1.0 + m_rateTrim);	// In input frames per output frame
+
+	// An output frame needs all m_numTaps input frames from its (integer) position
+	UINT numOutFrames = 0;
+	while (numOutFrames < maxOutFrames)
+	{
+		const UINT frame = (UINT)m_position;
+		if (frame + m_numTaps > numFrames)
+			break;
+
+		const UINT phase = (UINT)((m_position - (double)frame) * kNumPhases);
+		const float* pTaps = &m_filter[phase * m_numTaps];
+		const float* pFrame = &m_input[frame * m_numChannels];
+
+		for (UINT c = 0; c < m_numChannels; c++)
+		{
+			float sum = 0.0f;
+			for (UINT i = 0; i < m_numTaps; i++)
+				sum += pFrame[i * m_numChannels + c] * pTaps[i];
+
+			int sample = (int)floor(sum + 0.5f);
+			if (sample > SHRT_MAX)
+				sample = SHRT_MAX;
+			else if (sample < SHRT_MIN)
+				sample = SHRT_MIN;
+
+			pOut[numOutFrames * m_numChannels + c] = (short)sample;
+		}
+
+		numOutFrames++;
+		m_position += step;
+	}
+
+	// Only keep the frames from the next output frame's position onwards
+	// . NB. if pOut filled up, then this keeps any input that wasn't used yet
+	const UINT firstKeptFrame = std::min<UINT>((UINT)m_position, numFrames);
+
+	m_input.erase(m_input.begin(), m_input.begin() + firstKeptFrame * m_numChannels);
+	m_numHistoryFrames = numFrames - firstKeptFrame;
+	m_position -= (double)firstKeptFrame;
+
+	return numOutFrames;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// Polyphase (windowed-sinc) sample rate converter, for interleaved 16-bit frames.
+// . Sound can be synthesised at whatever rate is cheapest/most natural (eg. the Mockingboard's AYs at
+//   CLK/32) and converted once to the output device's rate, with proper band-limiting.
+// . The ratio can be trimmed by a small amount, to keep a ring-buffer's fill level in range without
+//   having to add/drop whole samples.
+
+class PolyphaseResampler
+{
+public:
+	PolyphaseResampler(UINT numChannels);
+	~PolyphaseResampler() {}
+
+	void SetRates(double inputRate, double outputRate);
+	void SetRateTrim(double trim) { m_rateTrim = trim; }	// Output frames per input frame is scaled by (1 + trim)
+	double GetRateTrim() { return m_rateTrim; }
+	void Reset();
+
+	// Consumes all the input frames, and returns the number of output frames (at most maxOutFrames)
+	UINT Process(const short* pIn, UINT numInFrames, short* pOut, UINT maxOutFrames);
+
+private:
+	void InitFilter();
+
+	static const UINT kNumPhases = 256;
+
+	const UINT m_numChannels;
+	UINT m_numTaps;
+	double m_inputRate;
+	double m_outputRate;
+	double m_rateTrim;
+
+	std::vector<float> m_filter;	// [kNumPhases][m_numTaps]
+	std::vector<float> m_input;		// Interleaved: (m_numTaps-1) frames of history, then the new frames
+	UINT m_numHistoryFrames;
+	double m_position;				// Of the next output frame, in input frames relative to the start of m_input
+};
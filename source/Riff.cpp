@@ -136,3 +136,44 @@ bool RiffPutSamples(const short* buf, unsigned int uSamples)
 
 	return true;
 }
+
+void RiffWriteHeader(FILE* hFile, unsigned int sample_rate, unsigned int NumChannels, UINT64 numFrames)
+{
+	const UINT32 blockAlign = 2 * NumChannels;
+	const UINT32 dataSize = (UINT32)std::min<UINT64>(numFrames * blockAlign, 0xFFFFFFFF - 36);
+
+	struct WavHeader
+	{
+		char riff[4];
+		UINT32 totalSize;
+		char wave[4];
+		char fmt[4];
+		UINT32 formatLength;
+		UINT16 format;
+		UINT16 channels;
+		UINT32 sampleRate;
+		UINT32 bytesPerSecond;
+		UINT16 blockAlign;
+		UINT16 bitsPerSample;
+		char data[4];
+		UINT32 dataLength;
+	} header;
+
+	memcpy(header.riff, "RIFF", 4);
+	header.totalSize = 36 + dataSize;
+	memcpy(header.wave, "WAVE", 4);
+	memcpy(header.fmt, "fmt ", 4);
+	header.formatLength = 16;
+	header.format = 1;				// PCM format
+	header.channels = NumChannels;
+	header.sampleRate = sample_rate;
+	header.bytesPerSecond = sample_rate * blockAlign;
+	header.blockAlign = blockAlign;
+	header.bitsPerSample = 16;
+	memcpy(header.data, "data", 4);
+	header.dataLength = dataSize;
+
+	fseek(hFile, 0, SEEK_SET);
+	fwrite(&header, sizeof(header), 1, hFile);
+	fseek(hFile, 0, SEEK_END);
+}
@@ -3,3 +3,6 @@
 bool RiffInitWriteFile(const char* pszFile, unsigned int sample_rate, unsigned int NumChannels);
 bool RiffFinishWriteFile();
 bool RiffPutSamples(const short* buf, unsigned int uSamples);
+
+// For a .wav file that's written with stdio (eg. from a background thread): (re)write the header for numFrames
+void RiffWriteHeader(FILE* hFile, unsigned int sample_rate, unsigned int NumChannels, UINT64 numFrames);
@@ -73,6 +73,77 @@ const uint32_t SAMPLE_RATE_SSI263 = 22050;
 
 //-----------------------------------------------------------------------------
 
+// Phoneme cache: every phoneme (and the pause), pre-decoded for each duration mode (DUR)
+// . Shared by all SSI263/SC01 devices, and built once on first use
+// . So Update() is just a copy (and scale by amplitude) from here, instead of decoding (skipping/averaging) the samples each time
+
+namespace
+{
+	const UINT kNumDurationModes = 4;
+	const UINT kPhonemeCachePause = sizeof(g_nPhonemeInfo) / sizeof(g_nPhonemeInfo[0]);	// Entry after the last phoneme
+
+	std::vector<short> g_phonemeCache[kNumDurationModes][kPhonemeCachePause + 1];
+
+	// The decoding is the same as the previous (per-update) decode:
+	// . DUR=0: every sample
+	// . DUR=1: skip every 4th sample
+	// . DUR=2: average every 2 samples
+	// . DUR=3: average every 4 samples
+	// NB. Any partial group of samples at the end of the phoneme is dropped
+	void DecodePhoneme(std::vector<short>& cache, const short* pPhonemeData, UINT length, BYTE DUR)
+	{
+		const BYTE numSamplesToAvg = (DUR <= 1) ? 1 :
+									 (DUR == 2) ? 2 :
+												  4;
+
+		cache.clear();
+		cache.reserve(length / numSamplesToAvg);
+
+		int currSampleSum = 0;
+		int currNumSamples = 0;
+		UINT currSampleMod4 = 0;
+
+		while (length)
+		{
+			currSampleSum += *pPhonemeData++;
+			currNumSamples++;
+			length--;
+
+			if (currNumSamples == numSamplesToAvg)
+			{
+				cache.push_back((short)(currSampleSum / numSamplesToAvg));
+				currSampleSum = 0;
+				currNumSamples = 0;
+			}
+
+			currSampleMod4 = (currSampleMod4 + 1) & 3;
+			if (DUR == 1 && currSampleMod4 == 3 && length)
+			{
+				pPhonemeData++;
+				length--;
+			}
+		}
+	}
+}
+
+void SSI263::InitPhonemeCache()
+{
+	if (!g_phonemeCache[0][0].empty())
+		return;
+
+	for (BYTE DUR = 0; DUR < kNumDurationModes; DUR++)
+	{
+		for (UINT i = 0; i < kPhonemeCachePause; i++)
+			DecodePhoneme(g_phonemeCache[DUR][i], (const short*)&g_nPhonemeData[g_nPhonemeInfo[i].nOffset], g_nPhonemeInfo[i].nLength, DUR);
+
+		// 'pause' length is length of 1st phoneme (arbitrary choice, since don't know real length)
+		const std::vector<short>& phoneme0 = g_phonemeCache[DUR][0];
+		g_phonemeCache[DUR][kPhonemeCachePause].assign(phoneme0.size(), 0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+
 #if LOG_SSI263B
 static int ssiRegs[5]={-1,-1,-1,-1,-1};
 static int totalDuration_ms = 0;
@@ -157,7 +228,7 @@ void SSI263::Write(BYTE nReg, BYTE nValue)
 	{
 	case SSI_DURPHON:
 #if LOG_SSI263
-		if (g_fh) fprintf(g_fh, "DUR   = 0x%02X, PHON = 0x%02X\n\n", nValue>>6, nValue&PHONEME_MASK);
+		LogFileOutput("DUR   = 0x%02X, PHON = 0x%02X\n\n", nValue>>6, nValue&PHONEME_MASK);
 		LogOutput("DUR   = %d, PHON = 0x%02X\n", nValue>>6, nValue&PHONEME_MASK);
 #endif
 #if LOG_SSI263B
@@ -172,20 +243,20 @@ void SSI263::Write(BYTE nReg, BYTE nValue)
 		break;
 	case SSI_INFLECT:
 #if LOG_SSI263
-		if (g_fh) fprintf(g_fh, "INF   = 0x%02X\n", nValue);
+		LogFileOutput("INF   = 0x%02X\n", nValue);
 #endif
 		m_inflection = nValue;
 		break;
 
 	case SSI_RATEINF:
 #if LOG_SSI263
-		if (g_fh) fprintf(g_fh, "RATE  = 0x%02X, INF = 0x%02X\n", nValue>>4, nValue&0x0F);
+		LogFileOutput("RATE  = 0x%02X, INF = 0x%02X\n", nValue>>4, nValue&0x0F);
 #endif
 		m_rateInflection = nValue;
 		break;
 	case SSI_CTTRAMP:
 #if LOG_SSI263
-		if (g_fh) fprintf(g_fh, "CTRL  = %d, ART = 0x%02X, AMP=0x%02X\n", nValue>>7, (nValue&ARTICULATION_MASK)>>4, nValue&AMPLITUDE_MASK);
+		LogFileOutput("CTRL  = %d, ART = 0x%02X, AMP=0x%02X\n", nValue>>7, (nValue&ARTICULATION_MASK)>>4, nValue&AMPLITUDE_MASK);
 		//
 		{
 			bool H2L = (m_ctrlArtAmp & CONTROL_MASK) && !(nValue & CONTROL_MASK);
@@ -222,7 +293,7 @@ void SSI263::Write(BYTE nReg, BYTE nValue)
 	case SSI_FILFREQ:	// RegAddr.b2=1 (b1 & b0 are: don't care)
 	default:
 #if LOG_SSI263
-		if (g_fh) fprintf(g_fh, "FFREQ = 0x%02X\n", nValue);
+		LogFileOutput("FFREQ = 0x%02X\n", nValue);
 #endif
 		m_filterFreq = nValue;
 		break;
@@ -365,32 +436,18 @@ void SSI263::Play(unsigned int nPhoneme)
 	else
 		nPhoneme-=2;	// Missing phoneme-1
 
-	m_phonemeLengthRemaining = g_nPhonemeInfo[nPhoneme].nLength;
+	// NB. The accurate & lead-out lengths are in (undecoded) phoneme samples, as before
+	const UINT length = g_nPhonemeInfo[nPhoneme].nLength;
 
-	m_phonemeAccurateLengthRemaining = m_phonemeLengthRemaining;
+	m_phonemeAccurateLengthRemaining = length;
 	m_phonemePlaybackAndDebugger = (g_nAppMode == MODE_STEPPING || g_nAppMode == MODE_DEBUG);
 	m_phonemeCompleteByFullSpeed = false;
-	m_phonemeLeadoutLength = m_phonemeLengthRemaining / 10;	// Arbitrary! (TODO: determine a more accurate factor)
-
-	if (bPause)
-	{
-		if (!m_pPhonemeData00)
-		{
-			// 'pause' length is length of 1st phoneme (arbitrary choice, since don't know real length)
-			m_pPhonemeData00 = new short [m_phonemeLengthRemaining];
-			memset(m_pPhonemeData00, 0x00, m_phonemeLengthRemaining*sizeof(short));
-		}
-
-		m_pPhonemeData = m_pPhonemeData00;
-	}
-	else
-	{
-		m_pPhonemeData = (const short*) &g_nPhonemeData[g_nPhonemeInfo[nPhoneme].nOffset];
-	}
+	m_phonemeLeadoutLength = length / 10;	// Arbitrary! (TODO: determine a more accurate factor)
 
-	m_currSampleSum = 0;
-	m_currNumSamples = 0;
-	m_currSampleMod4 = 0;
+	m_phonemeIndex = bPause ? kPhonemeCachePause : nPhoneme;
+	m_phonemeDUR = GetDUR();
+	m_phonemePos = 0;
+	m_phonemeLengthRemaining = (UINT)g_phonemeCache[m_phonemeDUR][m_phonemeIndex].size();
 
 	// Set m_lastUpdateCycle, otherwise UpdateAccurateLength() can immediately complete phoneme! (GH#1104)
 	m_lastUpdateCycle = GetLastCumulativeCycles();
@@ -398,8 +455,37 @@ void SSI263::Play(unsigned int nPhoneme)
 
 void SSI263::Stop()
 {
-	if (SSI263SingleVoice.lpDSBvoice && SSI263SingleVoice.bActive)
-		DSVoiceStop(&SSI263SingleVoice);
+	m_speechFifoHead = 0;
+	m_speechFifoCount = 0;
+	m_speechFifoFrac = 0.0;
+	m_speechFifoPrimed = false;
+}
+
+BYTE SSI263::GetDUR()
+{
+	return (m_currentMode.function == (MODE_FRAME_IMMEDIATE_INFLECTION >> DURATION_MODE_SHIFT)) ? 3	// Frame timing mode
+			: m_durationPhoneme >> DURATION_MODE_SHIFT;	// Phoneme timing mode
+}
+
+// DUR changed mid-phoneme, so continue from the same relative position in the other decoded phoneme
+void SSI263::SetPhonemeDUR(BYTE DUR)
+{
+	if (DUR == m_phonemeDUR)
+		return;
+
+	const UINT oldSize = (UINT)g_phonemeCache[m_phonemeDUR][m_phonemeIndex].size();
+	const UINT newSize = (UINT)g_phonemeCache[DUR][m_phonemeIndex].size();
+	m_phonemeDUR = DUR;
+
+	if (!m_phonemeLengthRemaining || !oldSize || !newSize)
+		return;
+
+	UINT pos = (UINT)(((UINT64)m_phonemePos * newSize) / oldSize);
+	if (pos > newSize - 1)
+		pos = newSize - 1;
+
+	m_phonemePos = pos;
+	m_phonemeLengthRemaining = newSize - pos;
 }
 
 //-----------------------------------------------------------------------------
@@ -418,7 +504,7 @@ void SSI263::PeriodicUpdate(UINT executedCycles)
 
 //-----------------------------------------------------------------------------
 
-//#define DBG_SSI263_UPDATE		// NB. This outputs for all active SSI263 ring-buffers (eg. for mb-audit this may be 2 or 4)
+//#define DBG_SSI263_UPDATE		// NB. This outputs for all active SSI263s (eg. for mb-audit this may be 2 or 4)
 //#define DBG_SSI263_UPDATE_RETURN
 
 // Called by:
@@ -428,12 +514,6 @@ void SSI263::Update()
 	if (!IsPhonemeActive())
 		return;
 
-	if (!SSI263SingleVoice.lpDSBvoice || !SSI263SingleVoice.bActive)
-	{
-		if (!DSInit())
-			return;
-	}
-
 	UpdateAccurateLength();
 
 	if (g_bFullSpeed)	// NB. if true, then it's irrespective of IsPhonemeActive() - see MockingboardCard::IsActiveToPreventFullSpeed()
@@ -461,139 +541,50 @@ void SSI263::Update()
 	const bool nowNormalSpeed = m_updateWasFullSpeed;	// Just transitioned from full-speed to normal speed
 	m_updateWasFullSpeed = false;
 
-	// NB. next call to this function: nowNormalSpeed = false
 	if (nowNormalSpeed)
-		m_byteOffset = (uint32_t)-1;	// ...which resets m_numSamplesError below
-
-	//-------------
-
-	DWORD dwCurrentPlayCursor, dwCurrentWriteCursor;
-	HRESULT hr = SSI263SingleVoice.lpDSBvoice->GetCurrentPosition(&dwCurrentPlayCursor, &dwCurrentWriteCursor);
-	if (FAILED(hr))
 	{
-		LogOutput("SSI263::Update() early return: GetCurrentPosition() failed\n");
+		// Don't generate samples for all the cycles executed at full-speed
+		m_lastUpdateCycle = GetLastCumulativeCycles();
+		m_numSamplesRemainder = 0.0;
 		return;
 	}
 
-	bool prefillBufferOnInit = false;
-
-	if (m_byteOffset == (uint32_t)-1)
-	{
-		// First time in this func (or transitioned from full-speed to normal speed, or a ring-buffer reset)
-#ifdef DBG_SSI263_UPDATE
-		double fTicksSecs = (double)GetTickCount() / 1000.0;
-		LogOutput("%010.3f: [SSUpdtInit%1d]PC=%08X, WC=%08X, Diff=%08X, Off=%08X xxx\n",
-			fTicksSecs, m_device, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset);
-#endif
-		m_byteOffset = dwCurrentWriteCursor;
-		m_numSamplesError = 0;
-		prefillBufferOnInit = true;
-	}
-	else
-	{
-		// Check that our offset isn't between Play & Write positions
-		if (SoundCore_ValidateAndAlignWriteOffset(m_byteOffset, dwCurrentPlayCursor, dwCurrentWriteCursor))
-		{
-#ifdef DBG_SSI263_UPDATE
-			double fTicksSecs = (double)GetTickCount() / 1000.0;
-			const char* tag = (dwCurrentWriteCursor > dwCurrentPlayCursor) ? "xxx" : "XXX";
-			LogOutput("%010.3f: [SSUpdt%1d]    PC=%08X, WC=%08X, Diff=%08X, Off=%08X %s\n",
-				fTicksSecs, m_device, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset, tag);
-#endif
-			m_numSamplesError = 0;
-		}
-	}
-
 	//-------------
 
-	const UINT kMinBytesInBuffer = m_kDSBufferByteSize / 4;	// 25% full
-	int nNumSamples = 0;
-	double updateInterval = 0.0;
-
-	if (prefillBufferOnInit)
-	{
-		// Just prefill first 25% of buffer with zeros:
-		// . so we have a quarter buffer of silence/lag before the real sample data begins.
-		// . NB. this is fine, since it's the steady state; and it's likely that no actual data will ever occur during this initial time.
-		// This means that the '1st phoneme playback time' (in cycles) will be a bit longer for subsequent times.
-
-		m_lastUpdateCycle = GetLastCumulativeCycles();
+	// For small timer periods, wait for a period of 500cy before generating samples.
+	const double kMinimumUpdateInterval = 500.0;	// Arbitary (500 cycles = 10 samples)
+	const double kMaximumUpdateInterval = (double)(0xFFFF + 2);	// Max 6522 timer interval (1372 samples)
 
-		nNumSamples = kMinBytesInBuffer / sizeof(short);
-		memset(&m_mixBufferSSI263[0], 0, nNumSamples);
-	}
-	else
+	_ASSERT(GetLastCumulativeCycles() >= m_lastUpdateCycle);
+	double updateInterval = (double)(GetLastCumulativeCycles() - m_lastUpdateCycle);
+	if (updateInterval < kMinimumUpdateInterval)
 	{
-		// For small timer periods, wait for a period of 500cy before updating DirectSound ring-buffer.
-		// NB. A timer period of less than 24cy will yield nNumSamplesPerPeriod=0.
-		const double kMinimumUpdateInterval = 500.0;	// Arbitary (500 cycles = 21 samples)
-		const double kMaximumUpdateInterval = (double)(0xFFFF + 2);	// Max 6522 timer interval (1372 samples)
-
-		_ASSERT(GetLastCumulativeCycles() >= m_lastUpdateCycle);
-		updateInterval = (double)(GetLastCumulativeCycles() - m_lastUpdateCycle);
-		if (updateInterval < kMinimumUpdateInterval)
-		{
 #ifdef DBG_SSI263_UPDATE_RETURN
-			LogOutput("SSI263::Update() early return: updateInterval < kMinimumUpdateInterval\n");
+		LogOutput("SSI263::Update() early return: updateInterval < kMinimumUpdateInterval\n");
 #endif
-			return;
-		}
-		if (updateInterval > kMaximumUpdateInterval)
-			updateInterval = kMaximumUpdateInterval;
-
-		m_lastUpdateCycle = GetLastCumulativeCycles();
-
-		const double nIrqFreq = g_fCurrentCLK6502 / updateInterval + 0.5;			// Round-up
-		const int nNumSamplesPerPeriod = (int)((double)(SAMPLE_RATE_SSI263) / nIrqFreq);	// Eg. For 60Hz this is 367
-
-		nNumSamples = nNumSamplesPerPeriod + m_numSamplesError;						// Apply correction
-		if (nNumSamples <= 0)
-			nNumSamples = 0;
-		if (nNumSamples > 2 * nNumSamplesPerPeriod)
-			nNumSamples = 2 * nNumSamplesPerPeriod;
-
-		if (nNumSamples > m_kDSBufferByteSize / sizeof(short))
-			nNumSamples = m_kDSBufferByteSize / sizeof(short);	// Clamp to prevent buffer overflow
+		return;
+	}
+	if (updateInterval > kMaximumUpdateInterval)
+		updateInterval = kMaximumUpdateInterval;
 
-//		if (nNumSamples)
-//		{ /* Generate new sample data - ie. could merge from all the SSI263 sources */ }
+	m_lastUpdateCycle = GetLastCumulativeCycles();
 
-		//
+	// Samples are generated for the cycles executed (so no play/write cursor correction is needed)
+	// . the fractional part is carried to the next update, so there's no long-term drift
+	const double numSamplesExact = (double)SAMPLE_RATE_SSI263 * updateInterval / g_fCurrentCLK6502 + m_numSamplesRemainder;
+	UINT nNumSamples = (UINT)numSamplesExact;
+	m_numSamplesRemainder = numSamplesExact - (double)nNumSamples;
 
-		int nBytesRemaining = m_byteOffset - dwCurrentPlayCursor;
-		if (nBytesRemaining < 0)
-			nBytesRemaining += m_kDSBufferByteSize;
-
-		// Calc correction factor so that play-buffer doesn't under/overflow
-		const int nErrorInc = SoundCore_GetErrorInc();
-		if (nBytesRemaining < kMinBytesInBuffer)
-			m_numSamplesError += nErrorInc;				// < 0.25 of buffer remaining
-		else if (nBytesRemaining > m_kDSBufferByteSize / 2)
-			m_numSamplesError -= nErrorInc;				// > 0.50 of buffer remaining
-		else
-			m_numSamplesError = 0;						// Acceptable amount of data in buffer
-	}
+	if (nNumSamples > MAX_SAMPLES)
+		nNumSamples = MAX_SAMPLES;	// Clamp to prevent buffer overflow
 
 #if defined(DBG_SSI263_UPDATE)
 	double fTicksSecs = (double)GetTickCount() / 1000.0;
-	LogOutput("%010.3f: [SSUpdt%1d]    PC=%08X, WC=%08X, Diff=%08X, Off=%08X, NS=%08X, NSE=%08X, Interval=%f\n", fTicksSecs, m_device, dwCurrentPlayCursor, dwCurrentWriteCursor, dwCurrentWriteCursor - dwCurrentPlayCursor, m_byteOffset, nNumSamples, m_numSamplesError, updateInterval);
+	LogOutput("%010.3f: [SSUpdt%1d]    NS=%08X, FIFO=%08X, Interval=%f\n", fTicksSecs, m_device, nNumSamples, m_speechFifoCount, updateInterval);
 #endif
 
 	if (nNumSamples == 0)
 	{
-		if (m_numSamplesError)
-		{
-			// Reset ring-buffer if we've had a major interruption, eg. F7 (enter debugger), F8 (configure), F11/12 (save-state), Pause, etc
-			// - this can cause Apple II SSI263 detection code to fail (when either timing one or a sequence of phonemes)
-			// When the AppleWin code restarts and reads the ring-buffer position it'll be at a random point, and maybe nearly full (>50% full)
-			// - so the code waits until it drains (nNumSamples=0 each time)
-			// - but it takes a large number of calls to this func to drain to an acceptable level
-			m_byteOffset = (uint32_t)-1;
-#if defined(DBG_SSI263_UPDATE)
-			double fTicksSecs = (double)GetTickCount() / 1000.0;
-			LogOutput("%010.3f: [SSUpdt%1d]    Reset ring-buffer\n", fTicksSecs, m_device);
-#endif
-		}
 #ifdef DBG_SSI263_UPDATE_RETURN
 		LogOutput("SSI263::Update() early return: nNumSamples == 0\n");
 #endif
@@ -610,53 +601,28 @@ void SSI263::Update()
 	bool bSpeechIRQ = false;
 
 	{
-		const BYTE DUR = (m_currentMode.function == (MODE_FRAME_IMMEDIATE_INFLECTION >> DURATION_MODE_SHIFT)) ? 3	// Frame timing mode
-						: m_durationPhoneme >> DURATION_MODE_SHIFT;	// Phoneme timing mode
-		const BYTE numSamplesToAvg = (DUR <= 1) ? 1 :
-									 (DUR == 2) ? 2 :
-												  4;
-
 		short* pMixBuffer = &m_mixBufferSSI263[0];
 		UINT zeroSize = nNumSamples;
 
-		// NB. If SSI263.CONTROL=1 (Power-down) then zeroSize == nNumSamples, and eventually the ring-buffer gets filled with zero samples
+		// NB. If SSI263.CONTROL=1 (Power-down) then zeroSize == nNumSamples, and eventually the FIFO gets filled with zero samples
 
-		if (m_phonemeLengthRemaining && !prefillBufferOnInit)
+		if (m_phonemeLengthRemaining)
 		{
-			UINT samplesWritten = 0;
-			while (samplesWritten < (UINT)nNumSamples)
-			{
-				double sample = (double)*m_pPhonemeData * amplitude;
-				m_currSampleSum += (int)sample;
-				m_currNumSamples++;
+			SetPhonemeDUR(GetDUR());
 
-				m_pPhonemeData++;
-				m_phonemeLengthRemaining--;
+			const UINT samplesWritten = (m_phonemeLengthRemaining < nNumSamples) ? m_phonemeLengthRemaining : nNumSamples;
+			const short* pPhonemeData = &g_phonemeCache[m_phonemeDUR][m_phonemeIndex][m_phonemePos];
 
-				if (m_currNumSamples == numSamplesToAvg)
-				{
-					*pMixBuffer++ = (short)(m_currSampleSum / numSamplesToAvg);
-					samplesWritten++;
-					m_currSampleSum = 0;
-					m_currNumSamples = 0;
-				}
+			for (UINT i = 0; i < samplesWritten; i++)
+				*pMixBuffer++ = (short)((double)pPhonemeData[i] * amplitude);
 
-				m_currSampleMod4 = (m_currSampleMod4 + 1) & 3;
-				if (DUR == 1 && m_currSampleMod4 == 3 && m_phonemeLengthRemaining)
-				{
-					m_pPhonemeData++;
-					m_phonemeLengthRemaining--;
-				}
+			m_phonemePos += samplesWritten;
+			m_phonemeLengthRemaining -= samplesWritten;
 
-				if (!m_phonemeLengthRemaining)
-				{
-					bSpeechIRQ = true;
-					break;
-				}
-			}
+			if (!m_phonemeLengthRemaining)
+				bSpeechIRQ = true;
 
 			zeroSize = nNumSamples - samplesWritten;
-			_ASSERT(zeroSize >= 0);
 		}
 
 		if (zeroSize)
@@ -665,40 +631,12 @@ void SSI263::Update()
 
 			// Only dec m_phonemeLeadoutLength when m_phonemeAccurateLengthRemaining==0
 			// . otherwise when single-stepping can get into the situation where m_phonemeLengthRemaining==0 && m_phonemeAccurateLengthRemaining!=0
-			if (!prefillBufferOnInit && !m_phonemeAccurateLengthRemaining)
+			if (!m_phonemeAccurateLengthRemaining)
 				m_phonemeLeadoutLength -= (m_phonemeLeadoutLength > zeroSize) ? zeroSize : m_phonemeLeadoutLength;
 		}
 	}
 
-	//
-
-	DWORD dwDSLockedBufferSize0, dwDSLockedBufferSize1;
-	short *pDSLockedBuffer0, *pDSLockedBuffer1;
-
-	hr = DSGetLock(SSI263SingleVoice.lpDSBvoice,
-		m_byteOffset, (uint32_t)nNumSamples * sizeof(short) * m_kNumChannels,
-		&pDSLockedBuffer0, &dwDSLockedBufferSize0,
-		&pDSLockedBuffer1, &dwDSLockedBufferSize1);
-	if (FAILED(hr))
-	{
-		LogOutput("SSI263::Update() early return: DSGetLock() failed\n");
-		return;
-	}
-
-	memcpy(pDSLockedBuffer0, &m_mixBufferSSI263[0], dwDSLockedBufferSize0);
-	if (pDSLockedBuffer1)
-		memcpy(pDSLockedBuffer1, &m_mixBufferSSI263[dwDSLockedBufferSize0/sizeof(short)], dwDSLockedBufferSize1);
-
-	// Commit sound buffer
-	hr = SSI263SingleVoice.lpDSBvoice->Unlock((void*)pDSLockedBuffer0, dwDSLockedBufferSize0,
-											  (void*)pDSLockedBuffer1, dwDSLockedBufferSize1);
-	if (FAILED(hr))
-	{
-		LogOutput("SSI263::Update() early return: UnLock() failed\n");
-		return;
-	}
-
-	m_byteOffset = (m_byteOffset + (uint32_t)nNumSamples*sizeof(short)*m_kNumChannels) % m_kDSBufferByteSize;
+	PushSpeech(&m_mixBufferSSI263[0], nNumSamples);
 
 	//
 
@@ -871,58 +809,61 @@ void SSI263::SetCardMode(PHASOR_MODE mode)
 
 //-----------------------------------------------------------------------------
 
-// Cf. void MockingboardCardManager::UpdateSoundBuffer()
-bool SSI263::DSInit()
+// Called by:
+// . Update()
+void SSI263::PushSpeech(const short* pSamples, UINT numSamples)
 {
-	if (!SSI263SingleVoice.lpDSBvoice)
+	for (UINT i = 0; i < numSamples; i++)
 	{
-		if (g_bDisableDirectSound || g_bDisableDirectSoundMockingboard)
-			return false;
-
-		if (!Init())
-			return false;
-	}
+		if (m_speechFifoCount == kSpeechFifoSize)
+		{
+			// Overflow (eg. no Mockingboard sound buffer to mix into), so drop the oldest sample
+			m_speechFifoHead = (m_speechFifoHead + 1) % kSpeechFifoSize;
+			m_speechFifoCount--;
+		}
 
-	if (!SSI263SingleVoice.bActive)
-	{
-		bool bRes = DSZeroVoiceBuffer(&SSI263SingleVoice, m_kDSBufferByteSize);	// ... and Play()
-		LogFileOutput("SSI263: DSZeroVoiceBuffer(), res=%d\n", bRes ? 1 : 0);
-		if (!bRes)
-			return false;
+		m_speechFifo[(m_speechFifoHead + m_speechFifoCount) % kSpeechFifoSize] = pSamples[i];
+		m_speechFifoCount++;
 	}
-
-	return true;
 }
 
-// Cf. bool MockingboardCardManager::Init()
-bool SSI263::Init()
+// Called by:
+// . MockingboardCard::GetSpeechBuffer()
+// Linear interpolation from SAMPLE_RATE_SSI263 to the AYs' sample rate (the MB resampler then converts to the sound buffer's rate)
+// . NB. The result is added to pMixBuffer
+void SSI263::MixSpeech(int* pMixBuffer, UINT numSamples, double sampleRate)
 {
-	if (!DSAvailable())
-		return false;
-
-	HRESULT hr = DSGetSoundBuffer(&SSI263SingleVoice, m_kDSBufferByteSize, SAMPLE_RATE_SSI263, m_kNumChannels, "SSI263");
-	LogFileOutput("SSI263: DSGetSoundBuffer(), hr=0x%08X\n", hr);
-	if (FAILED(hr))
+	if (!m_speechFifoPrimed)
 	{
-		LogFileOutput("SSI263: DSGetSoundBuffer failed (%08X)\n", hr);
-		return false;
+		if (m_speechFifoCount < kSpeechFifoLatency)
+			return;
+		m_speechFifoPrimed = true;
 	}
 
-	// Don't DirectSoundBuffer::Play() via DSZeroVoiceBuffer() - instead wait until this SSI263 is actually first used
-	// . different to Speaker & Mockingboard ring buffers
-	// . NB. we have 2x SSI263 per MB card, and it's rare if 1 is used (and *extremely* rare if 2 are used!)
-	// . Not so rare, as TotalReplay (at boot) will try to detect an SSI263 (by playing a $00 phoneme).
+	const double step = (double)SAMPLE_RATE_SSI263 / sampleRate;
 
-	hr = SSI263SingleVoice.lpDSBvoice->SetVolume(SSI263SingleVoice.nVolume);
-	LogFileOutput("SSI263::DSInit: SetVolume(), hr=0x%08X\n", hr);
+	for (UINT i = 0; i < numSamples; i++)
+	{
+		if (m_speechFifoCount < 2)
+		{
+			// Underrun, so silence until there's enough buffered again
+			m_speechFifoPrimed = false;
+			m_speechFifoFrac = 0.0;
+			return;
+		}
 
-	return true;
-}
+		const int sample0 = m_speechFifo[m_speechFifoHead];
+		const int sample1 = m_speechFifo[(m_speechFifoHead + 1) % kSpeechFifoSize];
+		pMixBuffer[i] += sample0 + (int)((double)(sample1 - sample0) * m_speechFifoFrac);
 
-void SSI263::DSUninit()
-{
-	Stop();
-	DSReleaseSoundBuffer(&SSI263SingleVoice);
+		m_speechFifoFrac += step;
+		while (m_speechFifoFrac >= 1.0 && m_speechFifoCount)
+		{
+			m_speechFifoFrac -= 1.0;
+			m_speechFifoHead = (m_speechFifoHead + 1) % kSpeechFifoSize;
+			m_speechFifoCount--;
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -956,34 +897,6 @@ void SSI263::Reset(const bool powerCycle, const bool isPhasorCard)
 
 //-----------------------------------------------------------------------------
 
-void SSI263::Mute()
-{
-	if (SSI263SingleVoice.bActive && !SSI263SingleVoice.bMute)
-	{
-		SSI263SingleVoice.lpDSBvoice->SetVolume(DSBVOLUME_MIN);
-		SSI263SingleVoice.bMute = true;
-	}
-}
-
-void SSI263::Unmute()
-{
-	if (SSI263SingleVoice.bActive && SSI263SingleVoice.bMute)
-	{
-		SSI263SingleVoice.lpDSBvoice->SetVolume(SSI263SingleVoice.nVolume);
-		SSI263SingleVoice.bMute = false;
-	}
-}
-
-void SSI263::SetVolume(uint32_t dwVolume, uint32_t dwVolumeMax)
-{
-	SSI263SingleVoice.dwUserVolume = dwVolume;
-
-	SSI263SingleVoice.nVolume = NewVolume(dwVolume, dwVolumeMax);
-
-	if (SSI263SingleVoice.bActive && !SSI263SingleVoice.bMute)
-		SSI263SingleVoice.lpDSBvoice->SetVolume(SSI263SingleVoice.nVolume);
-}
-
 //=============================================================================
 
 #define SS_YAML_KEY_SSI263 "SSI263"
@@ -11,13 +11,12 @@ public:
 		m_device = -1;	// undefined
 		m_cardMode = PH_Mockingboard;
 		m_hasSC01 = true;	// only for m_device==0
-		m_pPhonemeData00 = NULL;
 
+		InitPhonemeCache();
 		ResetState(true);
 	}
 	~SSI263()
 	{
-		delete [] m_pPhonemeData00;
 	}
 
 	void ResetState(const bool powerCycle)
@@ -36,7 +35,9 @@ public:
 		m_lastUpdateCycle = 0;
 		m_updateWasFullSpeed = false;
 
-		m_pPhonemeData = NULL;
+		m_phonemeIndex = 0;
+		m_phonemeDUR = 0;
+		m_phonemePos = 0;
 		m_phonemeLengthRemaining = 0;
 		m_phonemeAccurateLengthRemaining = 0;
 		m_phonemePlaybackAndDebugger = false;
@@ -45,11 +46,11 @@ public:
 
 		//
 
-		m_numSamplesError = 0;
-		m_byteOffset = (uint32_t)-1;
-		m_currSampleSum = 0;
-		m_currNumSamples = 0;
-		m_currSampleMod4 = 0;
+		m_numSamplesRemainder = 0.0;
+		m_speechFifoHead = 0;
+		m_speechFifoCount = 0;
+		m_speechFifoFrac = 0.0;
+		m_speechFifoPrimed = false;
 
 		//
 
@@ -80,19 +81,15 @@ public:
 	SSI263Type GetSC01() { return m_hasSC01 ? SC01 : SSI263Empty; }
 	void SetSC01(SSI263Type type) { m_hasSC01 = (type == SC01); }
 
-	void DSUninit();
-
 	void Reset(const bool powerCycle, const bool isPhasorCard);
 
 	BYTE Read(ULONG nExecutedCycles);
 	void Write(BYTE nReg, BYTE nValue);
 
-	void Mute();
-	void Unmute();
-	void SetVolume(uint32_t dwVolume, uint32_t dwVolumeMax);
-
 	void PeriodicUpdate(UINT executedCycles);
 	void Update();
+	bool IsSpeechBuffered() { return m_speechFifoPrimed || m_speechFifoCount >= kSpeechFifoLatency; }
+	void MixSpeech(int* pMixBuffer, UINT numSamples, double sampleRate);
 	void SetSpeechIRQ();
 
 	void Votrax_Write(BYTE nValue);
@@ -110,6 +107,9 @@ private:
 	}
 	void Play(unsigned int nPhoneme);
 	void Stop();
+	BYTE GetDUR();
+	void SetPhonemeDUR(BYTE DUR);
+	void PushSpeech(const short* pSamples, UINT numSamples);
 	void UpdateIRQ();
 	void RepeatPhoneme();
 	void UpdateAccurateLength();
@@ -119,18 +119,24 @@ private:
 	void UpdateIFR(BYTE nDevice, BYTE clr_mask, BYTE set_mask);
 	BYTE GetPCR(BYTE nDevice);
 
-	bool Init();
-	bool DSInit();
+	static void InitPhonemeCache();
 
 	void SC01_SaveSnapshot(YamlSaveHelper& yamlSaveHelper);
 	void SC01_LoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT version);
 
 	static const BYTE m_Votrax2SSI263[/*64*/];
 
-	static const unsigned short m_kNumChannels = 1;
-	static const uint32_t m_kDSBufferByteSize = MAX_SAMPLES * sizeof(short) * m_kNumChannels;
-	short m_mixBufferSSI263[m_kDSBufferByteSize / sizeof(short)];
-	VOICE SSI263SingleVoice;
+	short m_mixBufferSSI263[MAX_SAMPLES];
+
+	// Generated speech (at SAMPLE_RATE_SSI263), until it's mixed with the AYs (at their rate) by MockingboardCardManager
+	// . there's no separate sound buffer: both are driven by the emulated cycles, so the FIFO just absorbs their different update periods
+	static const UINT kSpeechFifoSize = 8192;		// ~0.37 sec
+	static const UINT kSpeechFifoLatency = 512;		// ~23 ms: buffered before mixing starts (and again after an underrun)
+	short m_speechFifo[kSpeechFifoSize];
+	UINT m_speechFifoHead;
+	UINT m_speechFifoCount;
+	double m_speechFifoFrac;	// Position between the head sample and the next one
+	bool m_speechFifoPrimed;
 
 	//
 
@@ -162,7 +168,6 @@ private:
 	BYTE m_device;	// SSI263 device# which is generating phoneme-complete IRQ (and only required whilst Mockingboard isn't a class)
 	PHASOR_MODE m_cardMode;
 	bool m_hasSC01;
-	short* m_pPhonemeData00;
 
 	// ctor/power-cycle: Set to -1
 	// Play(): Set to [$00-$3F] on a write to DURPHON register.
@@ -183,8 +188,10 @@ private:
 	UINT64 m_lastUpdateCycle;
 	bool m_updateWasFullSpeed;
 
-	const short* m_pPhonemeData;
-	UINT m_phonemeLengthRemaining;			// length in samples, decremented as space becomes available in the ring-buffer
+	UINT m_phonemeIndex;					// In the phoneme cache
+	BYTE m_phonemeDUR;						// The phoneme cache's duration mode that m_phonemePos is for
+	UINT m_phonemePos;						// In the phoneme cache
+	UINT m_phonemeLengthRemaining;			// length in (phoneme cache) samples, decremented as samples are generated
 	UINT m_phonemeAccurateLengthRemaining;	// length in samples, decremented by cycles executed
 	bool m_phonemePlaybackAndDebugger;
 	bool m_phonemeCompleteByFullSpeed;
@@ -192,11 +199,7 @@ private:
 
 	//
 
-	int m_numSamplesError;
-	uint32_t m_byteOffset;
-	int m_currSampleSum;
-	int m_currNumSamples;
-	UINT m_currSampleMod4;
+	double m_numSamplesRemainder;
 
 	// Regs:
 	BYTE m_durationPhoneme;
@@ -41,6 +41,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Pravets.h"
 #include "Speaker.h"
 #include "Speech.h"
+#include "Tape.h"
 #include "Harddisk.h"
 
 #include "Configuration/Config.h"
@@ -55,6 +56,9 @@ static std::string g_strSaveStatePath;
 
 static YamlHelper yamlHelper;
 
+// Card types in the last loaded save-state (only valid while yamlHelper has this save-state cached)
+static SS_CARDTYPE g_snapshotSlotType[NUM_SLOTS];
+
 #define SS_FILE_VER 2
 
 // Unit version history:
@@ -331,11 +335,17 @@ static void ParseSlots(YamlLoadHelper& yamlLoadHelper, UINT unitVersion)
 		{
 			SetExpansionMemType(type);	// calls GetCardMgr().Insert() & InsertAux()
 		}
+		else if (GetCardMgr().QuerySlot(slot) == type)	// only for a hot restore - see Snapshot_LoadState_v2()
+		{
+			GetCardMgr().GetRef(slot).InitializeForLoadingSnapshot();
+		}
 		else
 		{
 			GetCardMgr().Insert(slot, type);
 		}
 
+		g_snapshotSlotType[slot] = type;
+
 		bRes = GetCardMgr().GetRef(slot).LoadSnapshot(yamlLoadHelper, cardVersion);
 
 		yamlLoadHelper.PopMap();
@@ -397,7 +407,13 @@ static void Snapshot_LoadState_v2()
 
 	try
 	{
-		if (!yamlHelper.InitParser(g_strSaveStatePathname.c_str()))
+		// Hot restore: reloading the last loaded save-state, and the file hasn't changed since
+		// . replay the cached parse of the file (with memory already decoded), instead of re-parsing it
+		// . keep any card that's still in the same slot, instead of re-inserting it (eg. avoids re-opening its host resources)
+		const bool hotRestore = yamlHelper.InitReplay(g_strSaveStatePathname.c_str());
+		if (hotRestore)
+			LogFileOutput("Load State: hot restore (file unchanged since last loaded)\n");
+		else if (!yamlHelper.InitParser(g_strSaveStatePathname.c_str(), true))
 			throw std::runtime_error("Failed to initialize parser or open file: " + g_strSaveStatePathname);
 
 		if (yamlHelper.ParseFileHdr(SS_YAML_VALUE_AWSS) != SS_FILE_VER)
@@ -410,7 +426,13 @@ static void Snapshot_LoadState_v2()
 		//m_ConfigNew.m_bEnableTheFreezesF8Rom = ?;	// todo: when support saving config
 
 		for (UINT slot = SLOT0; slot < NUM_SLOTS; slot++)
-			GetCardMgr().Remove(slot);
+		{
+			// NB. slot-0 & aux are always re-inserted, as they also depend on the Apple II model (see SetExpansionMemType())
+			if (!hotRestore || slot == SLOT0 || GetCardMgr().QuerySlot(slot) != g_snapshotSlotType[slot])
+				GetCardMgr().Remove(slot);
+
+			g_snapshotSlotType[slot] = CT_Empty;
+		}
 		GetCardMgr().RemoveAux();
 
 		SetCopyProtectionDongleType(DT_EMPTY);
@@ -419,6 +441,7 @@ static void Snapshot_LoadState_v2()
 		GetPravets().Reset();
 
 		KeybReset();
+		TapeStop();							// Tape isn't saved, and its next edge's cycle would be wrong for the new state
 		GetVideo().SetVidHD(false);			// Set true later only if VidHDCard is instantiated
 		GetVideo().VideoResetState();
 		GetVideo().SetVideoRefreshRate(VR_60HZ);	// Default to 60Hz as older save-states won't contain refresh rate
@@ -442,6 +465,7 @@ static void Snapshot_LoadState_v2()
 		// Refresh the volume of any new Mockingboard card (and its SSI263 or SC01 chips)
 		mockingboardCardManager.SetVolume(mockingboardCardManager.GetVolume(), GetPropertySheet().GetVolumeMax());
 		mockingboardCardManager.SetCumulativeCycles();
+		GetCardMgr().RebaseUpdateCycles();	// g_nCumulativeCycles has jumped (either way), and a hot restore keeps cards
 
 		frame.SetLoadedSaveStateFlag(true);
 
@@ -503,6 +527,9 @@ void Snapshot_LoadState()
 void Snapshot_SaveState()
 {
 	LogFileOutput("Saving Save-State to %s\n", g_strSaveStatePathname.c_str());
+
+	yamlHelper.ClearCache();	// The file is being replaced, so free the cache now
+
 	try
 	{
 		YamlSaveHelper yamlSaveHelper(g_strSaveStatePathname);
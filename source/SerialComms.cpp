@@ -36,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "StdAfx.h"
 
 #include "SerialComms.h"
+#include "Core.h"
 #include "CPU.h"
 #include "Interface.h"
 #include "Log.h"
@@ -72,7 +73,8 @@ CSuperSerialCard::CSuperSerialCard(UINT slot) :
 	m_uTCPChoiceItemIdx(0),
 	m_bCfgSupportDCD(false),
 	m_pExpansionRom(NULL),
-	m_hFrameWindow(NULL)
+	m_hFrameWindow(NULL),
+	m_syncEvent(slot, 0, SyncEventCallback)	// use slot# as "unique" id for SSCs
 {
 	if (m_slot == SLOT0)
 		ThrowErrorInvalidSlot();
@@ -121,6 +123,11 @@ void CSuperSerialCard::InternalReset()
 	m_qComSerialBuffer[0].clear();
 	m_qComSerialBuffer[1].clear();
 	m_qTcpSerialBuffer.clear();
+	m_bTcpRxDataReady = false;
+	m_vTcpSerialTxBuffer.clear();
+
+	if (m_syncEvent.m_active)
+		g_SynchronousEventMgr.Remove(m_syncEvent.m_id);
 
 	m_uDTR = DTR_CONTROL_DISABLE;
 	m_uRTS = RTS_CONTROL_DISABLE;
@@ -131,6 +138,9 @@ CSuperSerialCard::~CSuperSerialCard()
 {
 	CloseComm();
 
+	if (m_syncEvent.m_active)
+		g_SynchronousEventMgr.Remove(m_syncEvent.m_id);
+
 	delete [] m_pExpansionRom;
 	m_pExpansionRom = NULL;
 }
@@ -357,6 +367,11 @@ void CSuperSerialCard::CommTcpSerialClose()
 	}
 
 	m_qTcpSerialBuffer.clear();
+	m_bTcpRxDataReady = false;
+	m_vTcpSerialTxBuffer.clear();
+
+	if (m_syncEvent.m_active)
+		g_SynchronousEventMgr.Remove(m_syncEvent.m_id);
 }
 
 //===========================================================================
@@ -379,22 +394,87 @@ void CSuperSerialCard::CommTcpSerialReceive()
 {
 	if (m_hCommAcceptSocket != INVALID_SOCKET)
 	{
-		char Data[0x80];
+		BYTE Data[0x1000];
 		int nReceived = 0;
-		while ((nReceived = recv(m_hCommAcceptSocket, Data, sizeof(Data), 0)) > 0)
+		while ((nReceived = recv(m_hCommAcceptSocket, (char*)Data, sizeof(Data), 0)) > 0)
 		{
-			for (int i = 0; i < nReceived; i++)
-			{
-				m_qTcpSerialBuffer.push_back(Data[i]);
-			}
+			m_qTcpSerialBuffer.insert(m_qTcpSerialBuffer.end(), Data, Data + nReceived);
 		}
 
-		if (m_bRxIrqEnabled && !m_qTcpSerialBuffer.empty())
+		CommTcpSerialPaceRx();
+	}
+}
+
+//===========================================================================
+
+// Time on the wire for one character: start bit + data bits + parity bit + stop bit(s)
+UINT CSuperSerialCard::GetCyclesPerChar()
+{
+	const double stopBits = (m_uStopBits == TWOSTOPBITS) ? 2.0 : (m_uStopBits == ONE5STOPBITS) ? 1.5 : 1.0;
+	const double bitsPerChar = 1.0 + m_uByteSize + ((m_uParity != NOPARITY) ? 1.0 : 0.0) + stopBits;
+	return (UINT)(g_fCurrentCLK6502 * bitsPerChar / m_uBaudRate);
+}
+
+// A TCP connection has no line rate, so data is moved into the ACIA's RX data register at the baud rate:
+// . the next byte becomes available (RX_FULL and RX IRQ) one character time after the previous one was read
+void CSuperSerialCard::CommTcpSerialPaceRx()
+{
+	if (m_bTcpRxDataReady || m_syncEvent.m_active || m_qTcpSerialBuffer.empty())
+		return;
+
+	m_syncEvent.SetCycles(GetCyclesPerChar());
+	g_SynchronousEventMgr.Insert(&m_syncEvent);
+}
+
+int CSuperSerialCard::SyncEventCallback(int id, int /*cycles*/, ULONG /*uExecutedCycles*/)
+{
+	CSuperSerialCard* pSSC = (CSuperSerialCard*) MemGetSlotParameters(id);
+
+	if (!pSSC->m_qTcpSerialBuffer.empty())
+	{
+		pSSC->m_bTcpRxDataReady = true;
+
+		if (pSSC->m_bRxIrqEnabled)
 		{
 			CpuIrqAssert(IS_SSC);
-			m_vbRxIrqPending = true;
+			pSSC->m_vbRxIrqPending = true;
 		}
 	}
+
+	return 0;	// Don't repeat event
+}
+
+//===========================================================================
+
+// Send as much of the TX buffer as the socket will take, with a single send()
+void CSuperSerialCard::CommTcpSerialFlushTx()
+{
+	if (m_vTcpSerialTxBuffer.empty())
+		return;
+
+	if (m_hCommAcceptSocket == INVALID_SOCKET)
+	{
+		m_vTcpSerialTxBuffer.clear();
+	}
+	else
+	{
+		const int sent = send(m_hCommAcceptSocket, (const char*)&m_vTcpSerialTxBuffer[0], (int)m_vTcpSerialTxBuffer.size(), 0);
+		if (sent > 0)
+			m_vTcpSerialTxBuffer.erase(m_vTcpSerialTxBuffer.begin(), m_vTcpSerialTxBuffer.begin() + sent);
+		else if (sent == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK)
+			m_vTcpSerialTxBuffer.clear();	// Connection has gone (and FD_CLOSE will follow)
+	}
+
+	if (!m_vbTxEmpty && m_vTcpSerialTxBuffer.size() < m_kTcpTxBufferSize)
+		TransmitDone();
+
+	if (!m_vTcpSerialTxBuffer.empty())
+		ScheduleUpdateNow();	// Retry at the end of the next execution period
+}
+
+void CSuperSerialCard::Update(const ULONG /*nExecutedCycles*/)
+{
+	CommTcpSerialFlushTx();
 }
 
 //===========================================================================
@@ -658,7 +738,7 @@ BYTE __stdcall CSuperSerialCard::CommReceive(WORD, WORD, BYTE, BYTE, ULONG)
 
 	BYTE result = 0;
 
-	if (!m_qTcpSerialBuffer.empty())
+	if (m_bTcpRxDataReady)
 	{
 		// NB. See CommTcpSerialReceive() above, for a note explaining why there's no need for a critical section here
 
@@ -669,12 +749,9 @@ BYTE __stdcall CSuperSerialCard::CommReceive(WORD, WORD, BYTE, BYTE, ULONG)
 
 		result = m_qTcpSerialBuffer.front();
 		m_qTcpSerialBuffer.pop_front();
+		m_bTcpRxDataReady = false;
 
-		if (m_bRxIrqEnabled && !m_qTcpSerialBuffer.empty())
-		{
-			CpuIrqAssert(IS_SSC);
-			m_vbRxIrqPending = true;
-		}
+		CommTcpSerialPaceRx();	// Next byte (and RX IRQ) after another character time
 	}
 	else if (m_hCommHandle != INVALID_HANDLE_VALUE)
 	{
@@ -751,13 +828,17 @@ BYTE __stdcall CSuperSerialCard::CommTransmit(WORD, WORD, BYTE, BYTE value, ULON
 		{
 			data &= ~(1 << m_uByteSize);
 		}
-		int sent = send(m_hCommAcceptSocket, (const char*)&data, 1, 0);
-		_ASSERT(sent == 1);
-		if (sent == 1)
+		m_vbTxEmpty = false;
+		m_vTcpSerialTxBuffer.push_back(data);
+
+		if (m_vTcpSerialTxBuffer.size() < m_kTcpTxBufferSize)
 		{
-			m_vbTxEmpty = false;
-			// Assume that send() completes immediately
 			TransmitDone();
+			ScheduleUpdateNow();	// Update() sends everything transmitted during this execution period
+		}
+		else
+		{
+			CommTcpSerialFlushTx();	// NB. TX_EMPTY stays clear until the socket takes some data
 		}
 	}
 	else if (m_hCommHandle != INVALID_HANDLE_VALUE)
@@ -867,7 +948,7 @@ BYTE __stdcall CSuperSerialCard::CommStatus(WORD, WORD, BYTE, BYTE, ULONG)
 	//
 
 	BYTE TX_EMPTY = m_vbTxEmpty ? ST_TX_EMPTY : 0;
-	BYTE RX_FULL  = (!bComSerialBufferEmpty || !m_qTcpSerialBuffer.empty()) ? ST_RX_FULL : 0;
+	BYTE RX_FULL  = (!bComSerialBufferEmpty || m_bTcpRxDataReady) ? ST_RX_FULL : 0;
 
 	//
 
@@ -985,6 +1066,19 @@ void CSuperSerialCard::Reset(const bool /* powerCycle */)
 	InternalReset();
 }
 
+// Unlike Reset(), keep the COM port or TCP socket open
+void CSuperSerialCard::InitializeForLoadingSnapshot()
+{
+	// The comm thread also accesses the Rx buffers
+	if (m_hCommThread)
+		EnterCriticalSection(&m_CriticalSection);
+
+	InternalReset();
+
+	if (m_hCommThread)
+		LeaveCriticalSection(&m_CriticalSection);
+}
+
 //===========================================================================
 
 // Had this error when sizeof(m_RecvBuffer)==1 was used
@@ -1190,7 +1284,7 @@ bool CSuperSerialCard::CommThInit()
 
 		if ((m_hCommEvent[0] == NULL) || (m_hCommEvent[1] == NULL) || (m_hCommEvent[2] == NULL))
 		{
-			if(g_fh) fprintf(g_fh, "Comm: CreateEvent failed\n");
+			LogFileOutput("Comm: CreateEvent failed\n");
 			return false;
 		}
 	}
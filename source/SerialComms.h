@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Card.h"
+#include "SynchronousEventManager.h"
 
 enum {COMMEVT_WAIT=0, COMMEVT_ACK, COMMEVT_TERM, COMMEVT_MAX};
 enum eFWMODE {FWMODE_CIC=0, FWMODE_SIC_P8, FWMODE_PPC, FWMODE_SIC_P8A};	// NB. CIC = SSC
@@ -27,9 +28,10 @@ class CSuperSerialCard : public Card
 public:
 	CSuperSerialCard(UINT slot);
 	virtual ~CSuperSerialCard();
-	virtual void Update(const ULONG nExecutedCycles) {}
+	virtual void Update(const ULONG nExecutedCycles);
 	virtual void InitializeIO(LPBYTE pCxRomPeripheral);
 	virtual void Reset(const bool powerCycle);
+	virtual void InitializeForLoadingSnapshot();
 	virtual void Destroy() {}
 	static const std::string& GetSnapshotCardName();
 	virtual void	SaveSnapshot(YamlSaveHelper& yamlSaveHelper);
@@ -69,6 +71,10 @@ private:
 	UINT	BaudRateToIndex(UINT uBaudRate);
 	void	UpdateCommState();
 	void	TransmitDone();
+	UINT	GetCyclesPerChar();
+	void	CommTcpSerialPaceRx();
+	void	CommTcpSerialFlushTx();
+	static int	SyncEventCallback(int id, int cycles, ULONG uExecutedCycles);
 	bool	CheckComm();
 	void	CloseComm();
 	void	CheckCommEvent(DWORD dwEvtMask);
@@ -119,6 +125,9 @@ private:
 	std::deque<BYTE>	m_qComSerialBuffer[2];
 	volatile UINT		m_vuRxCurrBuffer;	// Written to on COM recv. SSC reads from other one
 	std::deque<BYTE>	m_qTcpSerialBuffer;
+	bool				m_bTcpRxDataReady;		// Head of m_qTcpSerialBuffer has been paced into the ACIA's RX data register
+	std::vector<BYTE>	m_vTcpSerialTxBuffer;	// Sent to the socket in bulk, from Update()
+	static const size_t	m_kTcpTxBufferSize = 4096;	// When full, then TX_EMPTY isn't set until the socket has taken some of it
 
 	//
 
@@ -145,4 +154,6 @@ private:
 	volatile DWORD m_dwModemStatus;	// Updated by CommThread when any of RLSD|DSR|CTS changes / Read by main thread - CommStatus()& CommDipSw()
 
 	UINT m_uRTS;
+
+	SyncEvent m_syncEvent;	// Paces TCP receive data at the baud rate
 };
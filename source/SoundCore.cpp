@@ -198,7 +198,7 @@ bool DSVoiceStop(PVOICE Voice)
 	HRESULT hr = Voice->lpDSBvoice->Stop();
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSStop failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSStop failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
@@ -223,7 +223,7 @@ bool DSZeroVoiceBuffer(PVOICE Voice, uint32_t dwBufferSize)
 	HRESULT hr = DSGetLock(Voice->lpDSBvoice, 0, 0, &pDSLockedBuffer, &dwDSLockedBufferSize, NULL, 0);
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSGetLock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSGetLock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
@@ -233,14 +233,14 @@ bool DSZeroVoiceBuffer(PVOICE Voice, uint32_t dwBufferSize)
 	hr = Voice->lpDSBvoice->Unlock((void*)pDSLockedBuffer, dwDSLockedBufferSize, NULL, 0);
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSUnlock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSUnlock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
 	hr = Voice->lpDSBvoice->Play(0,0,DSBPLAY_LOOPING);
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSPlay failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSPlay failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
@@ -263,7 +263,7 @@ bool DSZeroVoiceWritableBuffer(PVOICE Voice, uint32_t dwBufferSize)
 							&pDSLockedBuffer1, &dwDSLockedBufferSize1);
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSGetLock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSGetLock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
@@ -275,7 +275,7 @@ bool DSZeroVoiceWritableBuffer(PVOICE Voice, uint32_t dwBufferSize)
 									(void*)pDSLockedBuffer1, dwDSLockedBufferSize1);
 	if(FAILED(hr))
 	{
-		if(g_fh) fprintf(g_fh, "%s: DSUnlock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
+		LogFileOutput("%s: DSUnlock failed (%08X)\n", Voice->name.c_str(), (uint32_t)hr);
 		return false;
 	}
 
@@ -479,7 +479,7 @@ int SoundCore_GetErrorInc()
 void SoundCore_SetErrorInc(const int nErrorInc)
 {
 	g_nErrorInc = nErrorInc < g_nErrorMax ? nErrorInc : g_nErrorMax;
-	if(g_fh) fprintf(g_fh, "Speaker/MB Error Inc = %d\n", g_nErrorInc);
+	LogFileOutput("Speaker/MB Error Inc = %d\n", g_nErrorInc);
 }
 
 int SoundCore_GetErrorMax()
@@ -490,7 +490,7 @@ int SoundCore_GetErrorMax()
 void SoundCore_SetErrorMax(const int nErrorMax)
 {
 	g_nErrorMax = nErrorMax < MAX_SAMPLES ? nErrorMax : MAX_SAMPLES;
-	if(g_fh) fprintf(g_fh, "Speaker/MB Error Max = %d\n", g_nErrorMax);
+	LogFileOutput("Speaker/MB Error Max = %d\n", g_nErrorMax);
 }
 
 //=============================================================================
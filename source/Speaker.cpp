@@ -37,6 +37,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "SoundCore.h"
 #include "YamlHelper.h"
 #include "Riff.h"
+#include "Capture.h"
 
 #include "Debugger/Debug.h"	// For uint32_t extbench
 
@@ -68,19 +69,16 @@ const short		SPKR_DATA_INIT = (short)0x8000;
 short		g_nSpeakerData	= SPKR_DATA_INIT;
 static UINT		g_nBufferIdx	= 0;		// Frame index (ie. not sample index, as each frame contains g_nSPKR_NumChannels samples)
 
-static short*	g_pRemainderBuffer = NULL;
-static UINT		g_nRemainderBufferSize;		// Setup in SpkrInitialize()
-static UINT		g_nRemainderBufferIdx;		// Setup in SpkrInitialize()
-
 // Application-wide globals:
 double		    g_fClksPerSpkrSample;		// Setup in SetClksPerSpkrSample()
+static UINT		g_nClksPerSpkrSample = 23;	// Setup in SetClksPerSpkrSample()
 
 // Allow temporary quietening of speaker (8 bit DAC)
 bool			g_bQuieterSpeaker = false;
 
 // Globals
 static unsigned __int64	g_nSpkrQuietCycleCount = 0;
-static unsigned __int64 g_nSpkrLastCycle = 0;
+static unsigned __int64 g_nSpkrLastCycle = 0;		// Cycle at the start of the next sample to be output (ie. g_nBlepBuffer[0])
 static bool g_bSpkrToggleFlag = false;
 static VOICE SpeakerVoice;
 static bool g_bSpkrAvailable = false;
@@ -201,6 +199,15 @@ static uint32_t BytesToFrames(uint32_t bytes)
 	return bytes / (sizeof(short) * g_nSPKR_NumChannels);
 }
 
+// Samples written to the sound buffer also go to any .wav file & capture
+static void SpkrOutputSamples(const short* pSamples, uint32_t numFrames)
+{
+	if (g_bSpkrOutputToRiff)
+		RiffPutSamples(pSamples, numFrames);
+
+	Capture_PutSamples(CAPTURE_VOICE_SPEAKER, pSamples, numFrames, g_nSPKR_NumChannels);
+}
+
 static void PadNFrames(short* dest, uint32_t sizeBytes)
 {
 	if (sizeBytes)
@@ -211,8 +218,7 @@ static void PadNFrames(short* dest, uint32_t sizeBytes)
 		{
 			QueueOneFrame(dest, index, g_nSpeakerData);
 		}
-		if (g_bSpkrOutputToRiff)
-			RiffPutSamples(dest, numFrames);
+		SpkrOutputSamples(dest, numFrames);
 	}
 }
 
@@ -226,24 +232,197 @@ static void SetClksPerSpkrSample()
 	// Use integer value: Better for MJ Mahon's RT.SYNTH.DSK (integer multiples of 1.023MHz Clk)
 	// . 23 clks @ 1.023MHz
 	g_fClksPerSpkrSample = (double) (UINT) (g_fCurrentCLK6502 / (double)SPKR_SAMPLE_RATE);
+
+	g_nClksPerSpkrSample = (UINT) g_fClksPerSpkrSample;
+	if (g_nClksPerSpkrSample == 0)
+		g_nClksPerSpkrSample = 1;
 }
 
 //=============================================================================
+//
+// Band-limited step (BLEP) synthesis
+//
+// The speaker output is a series of steps (toggles of $C030, or level changes from SAM's 8-bit DAC),
+// each at an exact 6502 cycle. Instead of averaging the level over every cycle of every sample, each
+// step adds a precomputed band-limited impulse (a windowed sinc), scaled by the step's delta and
+// selected by the step's sub-sample phase, into an accumulation buffer. Samples are then output in
+// bulk (at SpkrUpdate() time) by integrating this buffer.
+// So the cost is proportional to the number of steps, and edges aren't quantised to whole samples.
+//
+// . The kernel is BLEP_TAPS samples wide, so the output lags by BLEP_TAPS/2 samples (~0.2ms @ 44.1KHz).
+// . The kernel is integer, and each phase sums to exactly BLEP_UNITY, so the integrated level can't drift.
+//
+
+static const UINT BLEP_PHASES = 32;						// Sub-sample resolution of a step
+static const UINT BLEP_TAPS = 16;						// Kernel width (in samples)
+static const int  BLEP_UNITY = 1 << 13;					// NB. 0xFFFF (max delta) * BLEP_UNITY fits in an int
+static const UINT BLEP_BUFFER_SIZE = 1024 + BLEP_TAPS;	// (in samples) Output early if a step would overflow it
+
+static int		g_nBlepKernel[BLEP_PHASES][BLEP_TAPS];
+static bool		g_bBlepKernelInit = false;
+
+static int		g_nBlepBuffer[BLEP_BUFFER_SIZE];		// Deltas, indexed by sample (relative to g_nSpkrLastCycle)
+static UINT		g_nBlepBufferUsed = 0;					// Deltas beyond this are all 0
+static int		g_nBlepSum = 0;							// Integrated level (* BLEP_UNITY) at g_nSpkrLastCycle
+static short	g_nBlepLevel = SPKR_DATA_INIT;			// Level after the last step added to the buffer
+static unsigned __int64 g_nBlepLastStepCycle = 0;
+static bool		g_bBlepDCFilterResetPending = false;	// Defer ResetDCFilter() until the step's sample is output
+static unsigned __int64 g_nBlepDCFilterResetCycle = 0;	// Cycle of the last step since samples were output
 
-static void InitRemainderBuffer()
+static void InitBlepKernel()
 {
-	delete [] g_pRemainderBuffer;
+	if (g_bBlepKernelInit)
+		return;
+
+	const double PI = 3.14159265358979323846;
+	const double fCutoff = 0.9;		// Fraction of Nyquist: leave some room for the window's transition band
+
+	for (UINT phase = 0; phase < BLEP_PHASES; phase++)
+	{
+		double fTap[BLEP_TAPS];
+		double fSum = 0.0;
+
+		for (UINT i = 0; i < BLEP_TAPS; i++)
+		{
+			// Distance (in samples) of this tap from the step, with the kernel centred on the step
+			const double x = (double)i - (double)(BLEP_TAPS - 1) / 2.0 - (double)phase / (double)BLEP_PHASES;
+			const double sinc = (x == 0.0) ? 1.0 : sin(PI * fCutoff * x) / (PI * fCutoff * x);
+			const double w = 2.0 * PI * x / (double)BLEP_TAPS;	// Blackman window, over [-BLEP_TAPS/2, +BLEP_TAPS/2]
+			const double window = 0.42 + 0.5 * cos(w) + 0.08 * cos(2.0 * w);
+			fTap[i] = sinc * window;
+			fSum += fTap[i];
+		}
+
+		// Normalise, then put any rounding error into the largest tap, so each phase sums to exactly BLEP_UNITY
+		int nSum = 0;
+		UINT nLargest = 0;
+		for (UINT i = 0; i < BLEP_TAPS; i++)
+		{
+			g_nBlepKernel[phase][i] = (int) floor(fTap[i] * BLEP_UNITY / fSum + 0.5);
+			nSum += g_nBlepKernel[phase][i];
+			if (g_nBlepKernel[phase][i] > g_nBlepKernel[phase][nLargest])
+				nLargest = i;
+		}
+
+		g_nBlepKernel[phase][nLargest] += BLEP_UNITY - nSum;
+	}
 
+	g_bBlepKernelInit = true;
+}
+
+static void InitBlepBuffer()
+{
 	SetClksPerSpkrSample();
+	InitBlepKernel();
+
+	memset(g_nBlepBuffer, 0, sizeof(g_nBlepBuffer));
+	g_nBlepBufferUsed = 0;
+	g_nBlepLevel = g_nSpeakerData;
+	g_nBlepSum = (int)g_nBlepLevel * BLEP_UNITY;
+	g_nBlepLastStepCycle = g_nSpkrLastCycle;
+	g_bBlepDCFilterResetPending = false;
+}
+
+static inline bool IsSpkrOutputEnabled()
+{
+	return !g_bFullSpeed || SoundCore_GetTimerState();
+}
 
-	g_nRemainderBufferSize = (UINT) g_fClksPerSpkrSample;
-	if ((double)g_nRemainderBufferSize < g_fClksPerSpkrSample)
-		g_nRemainderBufferSize++;
+static inline short BlepGetSample()
+{
+	int sample = g_nBlepSum / BLEP_UNITY;	// NB. Don't ">>" as -ve (see DCFilter())
 
-	g_pRemainderBuffer = new short [g_nRemainderBufferSize];
-	memset(g_pRemainderBuffer, 0, g_nRemainderBufferSize);
+	// The band-limited edges can overshoot (Gibbs), so clip
+	if (sample > SHRT_MAX)
+		sample = SHRT_MAX;
+	else if (sample < SHRT_MIN)
+		sample = SHRT_MIN;
 
-	g_nRemainderBufferIdx = 0;
+	return (short)sample;
+}
+
+// Output all the (whole) samples before 'cycle'
+// . If output is disabled (eg. full-speed) then they're just discarded
+static void BlepOutputSamples(unsigned __int64 cycle)
+{
+	if (cycle <= g_nSpkrLastCycle)
+		return;
+
+	const UINT64 nNumSamples64 = (cycle - g_nSpkrLastCycle) / g_nClksPerSpkrSample;
+	const UINT nNumSamples = (UINT) std::min<UINT64>(nNumSamples64, SPKR_SAMPLE_RATE);	// NB. g_pSpeakerBuffer holds at most 1 second
+	if (nNumSamples == 0)
+		return;
+
+	const bool bOutputEnabled = IsSpkrOutputEnabled();
+	const UINT nNumDeltas = std::min<UINT>(nNumSamples, g_nBlepBufferUsed);
+
+	UINT nDCFilterResetSample = UINT_MAX;
+	if (g_bBlepDCFilterResetPending)
+		nDCFilterResetSample = (g_nBlepDCFilterResetCycle > g_nSpkrLastCycle) ? (UINT) std::min<UINT64>((g_nBlepDCFilterResetCycle - g_nSpkrLastCycle) / g_nClksPerSpkrSample, UINT_MAX) : 0;
+
+	for (UINT i = 0; i < nNumSamples; i++)
+	{
+		if (i < nNumDeltas)
+			g_nBlepSum += g_nBlepBuffer[i];
+		else if (!bOutputEnabled || g_nBufferIdx >= SPKR_SAMPLE_RATE - 1)
+			break;	// Nothing more to integrate or output
+
+		if (i == nDCFilterResetSample)
+		{
+			ResetDCFilter();
+			g_bBlepDCFilterResetPending = false;
+		}
+
+		if (bOutputEnabled && g_nBufferIdx < SPKR_SAMPLE_RATE - 1)
+			QueueOneFrame(g_pSpeakerBuffer, g_nBufferIdx, BlepGetSample());
+	}
+
+	if (g_bBlepDCFilterResetPending && nDCFilterResetSample < nNumSamples)
+	{
+		ResetDCFilter();
+		g_bBlepDCFilterResetPending = false;
+	}
+
+	// Move the remaining deltas down to the new start of the buffer
+	const UINT nRemaining = g_nBlepBufferUsed - nNumDeltas;
+	memmove(&g_nBlepBuffer[0], &g_nBlepBuffer[nNumDeltas], nRemaining * sizeof(g_nBlepBuffer[0]));
+	memset(&g_nBlepBuffer[nRemaining], 0, nNumDeltas * sizeof(g_nBlepBuffer[0]));
+	g_nBlepBufferUsed = nRemaining;
+
+	g_nSpkrLastCycle += nNumSamples64 * g_nClksPerSpkrSample;
+}
+
+static void BlepAddStep(unsigned __int64 cycle, int delta)
+{
+	UINT64 nCycleOffset = (cycle > g_nSpkrLastCycle) ? cycle - g_nSpkrLastCycle : 0;
+
+	if (nCycleOffset / g_nClksPerSpkrSample + BLEP_TAPS > BLEP_BUFFER_SIZE)
+	{
+		// Make room: all samples before this step are now final
+		BlepOutputSamples(cycle);
+		nCycleOffset = (cycle > g_nSpkrLastCycle) ? cycle - g_nSpkrLastCycle : 0;
+		_ASSERT(nCycleOffset < g_nClksPerSpkrSample);
+	}
+
+	const UINT nSample = (UINT) (nCycleOffset / g_nClksPerSpkrSample);
+	const UINT nPhase = (UINT) (nCycleOffset % g_nClksPerSpkrSample) * BLEP_PHASES / g_nClksPerSpkrSample;
+
+	const int* pKernel = g_nBlepKernel[nPhase];
+	int* pDelta = &g_nBlepBuffer[nSample];
+	for (UINT i = 0; i < BLEP_TAPS; i++)
+		pDelta[i] += delta * pKernel[i];
+
+	g_nBlepBufferUsed = std::max<UINT>(g_nBlepBufferUsed, nSample + BLEP_TAPS);
+}
+
+// Add a step for any change in g_nSpeakerData since the last step
+static void BlepUpdateLevel(unsigned __int64 cycle)
+{
+	if (g_nSpeakerData == g_nBlepLevel)
+		return;
+
+	BlepAddStep(cycle, (int)g_nSpeakerData - (int)g_nBlepLevel);
+	g_nBlepLevel = g_nSpeakerData;
 }
 
 //
@@ -259,10 +438,8 @@ void SpkrDestroy()
 	//
 
 	delete [] g_pSpeakerBuffer;
-	delete [] g_pRemainderBuffer;
 		
 	g_pSpeakerBuffer = NULL;
-	g_pRemainderBuffer = NULL;
 }
 
 //=============================================================================
@@ -294,7 +471,7 @@ void SpkrInitialize()
 
 	//
 
-	InitRemainderBuffer();
+	InitBlepBuffer();
 
 	g_pSpeakerBuffer = new short[SPKR_SAMPLE_RATE * g_nSPKR_NumChannels];	// Buffer can hold a max of 1 seconds worth of samples
 }
@@ -304,7 +481,7 @@ void SpkrInitialize()
 // NB. Called when /g_fCurrentCLK6502/ changes
 void SpkrReinitialize()
 {
-	InitRemainderBuffer();
+	InitBlepBuffer();
 }
 
 //=============================================================================
@@ -315,7 +492,7 @@ void SpkrReset()
 	g_nSpkrQuietCycleCount = 0;
 	g_bSpkrToggleFlag = false;
 
-	InitRemainderBuffer();
+	InitBlepBuffer();
 	Spkr_SubmitWaveBuffer(NULL, 0);
 	Spkr_SetActive(false);
 	Spkr_Unmute();
@@ -323,65 +500,12 @@ void SpkrReset()
 
 //=============================================================================
 
-static void ReinitRemainderBuffer(UINT nCyclesRemaining)
-{
-	if(nCyclesRemaining == 0)
-		return;
-
-	for(g_nRemainderBufferIdx=0; g_nRemainderBufferIdx<nCyclesRemaining; g_nRemainderBufferIdx++)
-		g_pRemainderBuffer[g_nRemainderBufferIdx] = g_nSpeakerData;
-
-	_ASSERT(g_nRemainderBufferIdx < g_nRemainderBufferSize);
-}
-
-static void UpdateRemainderBuffer(ULONG* pnCycleDiff)
-{
-	if(g_nRemainderBufferIdx)
-	{
-		while((g_nRemainderBufferIdx < g_nRemainderBufferSize) && *pnCycleDiff)
-		{
-			g_pRemainderBuffer[g_nRemainderBufferIdx] = g_nSpeakerData;
-			g_nRemainderBufferIdx++;
-			(*pnCycleDiff)--;
-		}
-
-		if(g_nRemainderBufferIdx == g_nRemainderBufferSize)
-		{
-			g_nRemainderBufferIdx = 0;
-			signed long nSampleMean = 0;
-			for(UINT i=0; i<g_nRemainderBufferSize; i++)
-				nSampleMean += (signed long) g_pRemainderBuffer[i];
-			nSampleMean /= (signed long) g_nRemainderBufferSize;
-
-			if (g_nBufferIdx < SPKR_SAMPLE_RATE - 1)
-			{
-				QueueOneFrame(g_pSpeakerBuffer, g_nBufferIdx, (short)nSampleMean);
-			}
-		}
-	}
-}
-
 static void UpdateSpkr()
 {
-  if(!g_bFullSpeed || SoundCore_GetTimerState())
-  {
-	  ULONG nCycleDiff = (ULONG) (g_nCumulativeCycles - g_nSpkrLastCycle);
-
-	  UpdateRemainderBuffer(&nCycleDiff);
-
-	  ULONG nNumSamples = (ULONG) ((double)nCycleDiff / g_fClksPerSpkrSample);
-
-	  ULONG nCyclesRemaining = (ULONG) ((double)nCycleDiff - (double)nNumSamples * g_fClksPerSpkrSample);
-
-	  while ((nNumSamples--) && (g_nBufferIdx < SPKR_SAMPLE_RATE - 1))
-	  {
-			QueueOneFrame(g_pSpeakerBuffer, g_nBufferIdx, (short)g_nSpeakerData);
-	  }
+	// Pick up any direct change to g_nSpeakerData (eg. from SAM's DAC), which happens at the same cycle as the last step
+	BlepUpdateLevel(g_nBlepLastStepCycle);
 
-	  ReinitRemainderBuffer(nCyclesRemaining);	// Partially fill 1Mhz sample buffer
-  }
-
-  g_nSpkrLastCycle = g_nCumulativeCycles;
+	BlepOutputSamples(g_nCumulativeCycles);
 }
 
 //=============================================================================
@@ -404,21 +528,30 @@ BYTE __stdcall SpkrToggle(WORD, WORD, BYTE, BYTE, ULONG nExecutedCycles)
 
 	CpuCalcCycles(nExecutedCycles);
 
-	UpdateSpkr();
+	BlepUpdateLevel(g_nBlepLastStepCycle);	// Any direct change to g_nSpeakerData since the last step (see UpdateSpkr())
 
 	short speakerDriveLevel = SPKR_DATA_INIT;
 	if (g_bQuieterSpeaker)	// quieten the speaker if 8 bit DAC in use
 		speakerDriveLevel /= 4;	// NB. Don't shift -ve number right: undefined behaviour (MSDN says: implementation-dependent)
 
 	// When full-speed: Don't ResetDCFilter(), otherwise get occasional clicks when speaker toggled
+	// . Samples up to this step haven't been output yet, so defer it until this step's sample is output
+	// . A later step in the same batch moves the reset to its own sample (ie. the reset is at the batch's last step)
 	if (!g_bFullSpeed)
-		ResetDCFilter();
+	{
+		g_bBlepDCFilterResetPending = true;
+		g_nBlepDCFilterResetCycle = g_nCumulativeCycles;
+	}
 
 	if (g_nSpeakerData == speakerDriveLevel)
 		g_nSpeakerData = ~speakerDriveLevel;
 	else
 		g_nSpeakerData = speakerDriveLevel;
 
+	// NB. Only add the step to the buffer: samples are output in bulk by SpkrUpdate()
+	g_nBlepLastStepCycle = g_nCumulativeCycles;
+	BlepUpdateLevel(g_nBlepLastStepCycle);
+
 	return MemReadFloatingBus(nExecutedCycles);
 }
 
@@ -598,15 +731,13 @@ static ULONG Spkr_SubmitWaveBuffer_FullSpeed(short* pSpeakerBuffer, ULONG nNumSa
 			}
 			
 			memcpy(pDSLockedBuffer0, &pSpeakerBuffer[0], dwBufferSize0);
-			if (g_bSpkrOutputToRiff)
-				RiffPutSamples(pDSLockedBuffer0, BytesToFrames(dwBufferSize0));
+			SpkrOutputSamples(pDSLockedBuffer0, BytesToFrames(dwBufferSize0));
 			nNumSamples = BytesToFrames(dwBufferSize0);
 
 			if(pDSLockedBuffer1 && dwBufferSize1)
 			{
 				memcpy(pDSLockedBuffer1, &pSpeakerBuffer[dwDSLockedBufferSize0/sizeof(short)], dwBufferSize1);
-				if (g_bSpkrOutputToRiff)
-					RiffPutSamples(pDSLockedBuffer1, BytesToFrames(dwBufferSize1));
+				SpkrOutputSamples(pDSLockedBuffer1, BytesToFrames(dwBufferSize1));
 				nNumSamples += BytesToFrames(dwBufferSize1);
 			}
 		}
@@ -742,14 +873,12 @@ static ULONG Spkr_SubmitWaveBuffer(short* pSpeakerBuffer, ULONG nNumSamples)
 		}
 
 		memcpy(pDSLockedBuffer0, &pSpeakerBuffer[0], dwDSLockedBufferSize0);
-		if (g_bSpkrOutputToRiff)
-			RiffPutSamples(pDSLockedBuffer0, BytesToFrames(dwDSLockedBufferSize0));
+		SpkrOutputSamples(pDSLockedBuffer0, BytesToFrames(dwDSLockedBufferSize0));
 
 		if(pDSLockedBuffer1)
 		{
 			memcpy(pDSLockedBuffer1, &pSpeakerBuffer[dwDSLockedBufferSize0/sizeof(short)], dwDSLockedBufferSize1);
-			if (g_bSpkrOutputToRiff)
-				RiffPutSamples(pDSLockedBuffer1, BytesToFrames(dwDSLockedBufferSize1));
+			SpkrOutputSamples(pDSLockedBuffer1, BytesToFrames(dwDSLockedBufferSize1));
 		}
 
 		// Commit sound buffer
@@ -923,6 +1052,7 @@ void SpkrLoadSnapshot(YamlLoadHelper& yamlLoadHelper)
 		return;
 
 	g_nSpkrLastCycle = yamlLoadHelper.LoadUint64(SS_YAML_KEY_LASTCYCLE);
+	InitBlepBuffer();
 
 	yamlLoadHelper.PopMap();
 }
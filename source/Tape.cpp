@@ -26,26 +26,562 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  * Author: Various
  *
  * In comments, UTAIIe is an abbreviation for a reference to "Understanding the Apple //e" by James Sather
+ *
+ * Tape input (see command line: -tape-in <file>):
+ * . The tape is held as a list of half-cycle (ie. edge to edge) durations, in ticks (a .wav's are interpolated to 1/256 sample).
+ * . It starts playing on the first read of TAPEIN after it's inserted, and each edge is driven by a sync event.
+ *   Reads of TAPEIN also catch up to their exact cycle, so the edge timing is cycle-accurate.
+ * . Fast-load (-tape-fast-load): when the Monitor's READ routine starts to poll TAPEIN, the block is decoded
+ *   directly from the tape, copied to memory, and READ returns without any time passing.
+ *
+ * Tape output (see command line: -tape-out <file>):
+ * . Each TAPEOUT toggle is captured, to a .wav (44.1KHz 16-bit mono) or to the pulse-length format.
+ *
+ * Pulse-length format (.a2t):
+ * . Header: "A2TAPE", 0x1A, version (1), then ticks per second (UINT32)
+ * . Then each half-cycle's duration in ticks (UINT16); 0 means 65536 ticks without an edge (so add it to the next)
  */
 
 #include "StdAfx.h"
 
 #include "Core.h"
 #include "Tape.h"
+#include "CPU.h"
+#include "Log.h"
 #include "Memory.h"
 #include "Pravets.h"
+#include "Riff.h"
+#include "SynchronousEventManager.h"
+
+static const BYTE kA2tMagic[8] = { 'A', '2', 'T', 'A', 'P', 'E', 0x1A, 1 };
+static const UINT kTapeOutWavSampleRate = 44100;
+
+// Tape input
+static std::vector<UINT32> g_tapeHalfCycles;	// In ticks
+static double g_tapeTicksPerSec = 0.0;
+static size_t g_tapeEdgeIndex = 0;				// The next edge is at the end of this half-cycle
+static double g_tapeNextEdgeCycle = 0.0;		// Absolute cycle of the next edge
+static bool g_tapeLevel = false;
+static bool g_bTapePlaying = false;
+static bool g_bTapeFastLoad = false;
+static bool g_bTapeFastLoadTried = false;		// For this call of READ
+
+static const int kTapeSyncEventId = 0x100;		// Not a slot#
+static int TapeSyncEventCallback(int id, int cycles, ULONG uExecutedCycles);
+static SyncEvent g_tapeSyncEvent(kTapeSyncEventId, 0, TapeSyncEventCallback);
+
+// Tape output
+static FILE* g_hTapeOutFile = NULL;
+static bool g_bTapeOutWav = false;
+static bool g_tapeOutLevel = false;
+static bool g_bTapeOutStarted = false;
+static UINT64 g_tapeOutStartCycle = 0;
+static UINT64 g_tapeOutLastEdgeCycle = 0;
+static UINT64 g_tapeOutWavFrames = 0;
+
+//---------------------------------------------------------------------------
+
+static bool HasExtension(const std::string& strFilename, const char* pszExt)
+{
+	const size_t len = strlen(pszExt);
+	return strFilename.length() > len && _stricmp(strFilename.c_str() + strFilename.length() - len, pszExt) == 0;
+}
+
+static UINT32 GetUint32(const BYTE* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((UINT32)p[3] << 24);
+}
+
+static UINT16 GetUint16(const BYTE* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static double HalfCycleToCycles(size_t index)
+{
+	return (double)g_tapeHalfCycles[index] * g_fCurrentCLK6502 / g_tapeTicksPerSec;
+}
+
+static double HalfCycleToUsecs(size_t index)
+{
+	return (double)g_tapeHalfCycles[index] * 1000000.0 / g_tapeTicksPerSec;
+}
+
+//---------------------------------------------------------------------------
+
+// Convert the first channel of a PCM .wav to half-cycles, by finding the (interpolated) crossings of its mean level
+static bool TapeLoadWav(const std::vector<BYTE>& file)
+{
+	if (file.size() < 12 || memcmp(&file[0], "RIFF", 4) != 0 || memcmp(&file[8], "WAVE", 4) != 0)
+		return false;
+
+	UINT format = 0, numChannels = 0, sampleRate = 0, bitsPerSample = 0;
+	const BYTE* pData = NULL;
+	size_t dataSize = 0;
+
+	for (size_t pos = 12; pos + 8 <= file.size(); )
+	{
+		const UINT32 chunkSize = GetUint32(&file[pos + 4]);
+		const size_t chunkEnd = std::min<size_t>(file.size(), pos + 8 + (size_t)chunkSize);
+
+		if (memcmp(&file[pos], "fmt ", 4) == 0 && chunkSize >= 16 && pos + 8 + 16 <= file.size())
+		{
+			format = GetUint16(&file[pos + 8]);
+			numChannels = GetUint16(&file[pos + 10]);
+			sampleRate = GetUint32(&file[pos + 12]);
+			bitsPerSample = GetUint16(&file[pos + 22]);
+		}
+		else if (memcmp(&file[pos], "data", 4) == 0)
+		{
+			pData = &file[pos + 8];
+			dataSize = chunkEnd - (pos + 8);
+		}
+
+		pos = chunkEnd + (chunkSize & 1);	// Chunks are word aligned
+	}
+
+	if (format != 1 || !numChannels || !sampleRate || (bitsPerSample != 8 && bitsPerSample != 16) || !pData)
+		return false;
+
+	const UINT frameSize = numChannels * bitsPerSample / 8;
+	const size_t numFrames = dataSize / frameSize;
+	if (!numFrames)
+		return false;
+
+	std::vector<int> samples(numFrames);
+	for (size_t i = 0; i < numFrames; i++)
+	{
+		const BYTE* p = pData + i * frameSize;
+		samples[i] = (bitsPerSample == 8) ? ((int)p[0] - 128) * 256 : (int)(short)GetUint16(p);
+	}
+
+	// Hysteresis, relative to the signal's peak, so that noise around the mean isn't seen as edges
+	double mean = 0.0;
+	for (size_t i = 0; i < numFrames; i++)
+		mean += samples[i];
+	mean /= (double)numFrames;
+
+	double peak = 0.0;
+	for (size_t i = 0; i < numFrames; i++)
+		peak = std::max<double>(peak, fabs(samples[i] - mean));
+	const double hysteresis = peak * 0.1;
+
+	const UINT kSubSamples = 256;
+	g_tapeTicksPerSec = (double)sampleRate * kSubSamples;
+	g_tapeHalfCycles.clear();
+
+	bool level = samples[0] > mean;
+	UINT64 lastEdgeTick = 0;
+	size_t lastCrossing = 0;	// Sample before the most recent crossing of the mean
+
+	for (size_t i = 1; i < numFrames; i++)
+	{
+		if ((samples[i - 1] > mean) != (samples[i] > mean))
+			lastCrossing = i - 1;
+
+		const double delta = samples[i] - mean;
+		if (level ? (delta >= -hysteresis) : (delta <= hysteresis))
+			continue;
+
+		// Edge: interpolate where the signal crossed the mean
+		const double s0 = samples[lastCrossing] - mean;
+		const double s1 = samples[lastCrossing + 1] - mean;
+		const double frac = (s0 != s1) ? s0 / (s0 - s1) : 0.0;
+		const UINT64 edgeTick = std::max<UINT64>(lastEdgeTick + 1, (UINT64)(((double)lastCrossing + frac) * kSubSamples));
+
+		g_tapeHalfCycles.push_back((UINT32)(edgeTick - lastEdgeTick));
+		lastEdgeTick = edgeTick;
+		level = !level;
+	}
+
+	return true;
+}
+
+static bool TapeLoadA2t(const std::vector<BYTE>& file)
+{
+	if (file.size() < sizeof(kA2tMagic) + 4 || memcmp(&file[0], kA2tMagic, sizeof(kA2tMagic)) != 0)
+		return false;
+
+	g_tapeTicksPerSec = GetUint32(&file[sizeof(kA2tMagic)]);
+	if (g_tapeTicksPerSec == 0.0)
+		return false;
+
+	g_tapeHalfCycles.clear();
+
+	UINT32 ticks = 0;
+	for (size_t pos = sizeof(kA2tMagic) + 4; pos + 2 <= file.size(); pos += 2)
+	{
+		const UINT16 duration = GetUint16(&file[pos]);
+		if (duration == 0)
+		{
+			ticks += 0x10000;
+			continue;
+		}
+
+		g_tapeHalfCycles.push_back(ticks + duration);
+		ticks = 0;
+	}
+
+	return true;
+}
+
+bool TapeInsert(const std::string& strFilename)
+{
+	TapeEject();
+
+	FILE* hFile = fopen(strFilename.c_str(), "rb");
+	if (!hFile)
+	{
+		LogFileOutput("TapeInsert: Failed to open: %s\n", strFilename.c_str());
+		return false;
+	}
+
+	std::vector<BYTE> file;
+	BYTE buffer[64 * 1024];
+	size_t size;
+	while ((size = fread(buffer, 1, sizeof(buffer), hFile)) != 0)
+		file.insert(file.end(), buffer, buffer + size);
+	fclose(hFile);
+
+	const bool bRes = HasExtension(strFilename, ".wav") ? TapeLoadWav(file) : TapeLoadA2t(file);
+	if (!bRes || g_tapeHalfCycles.empty())
+	{
+		LogFileOutput("TapeInsert: Not a PCM .wav or .a2t tape: %s\n", strFilename.c_str());
+		g_tapeHalfCycles.clear();
+		return false;
+	}
+
+	LogFileOutput("TapeInsert: %s (%u half-cycles)\n", strFilename.c_str(), (UINT)g_tapeHalfCycles.size());
+	return true;
+}
+
+void TapeEject()
+{
+	TapeStop();
+	g_tapeHalfCycles.clear();
+	g_tapeEdgeIndex = 0;
+	g_tapeLevel = false;
+}
+
+void TapeSetFastLoad(bool bEnable)
+{
+	g_bTapeFastLoad = bEnable;
+}
+
+// Pause (eg. before a restart, on a power-cycle or loading a save-state): it resumes from the same position on the next read of TAPEIN
+// . NB. the next edge's cycle isn't valid after a power-cycle or save-state load, so it must be re-started by TapePlay()
+void TapeStop()
+{
+	if (g_tapeSyncEvent.m_active)
+		g_SynchronousEventMgr.Remove(g_tapeSyncEvent.m_id);
+
+	g_bTapePlaying = false;
+	g_bTapeFastLoadTried = false;
+}
 
 //---------------------------------------------------------------------------
 
-BYTE __stdcall TapeRead(WORD, WORD address, BYTE, BYTE, ULONG nExecutedCycles)	// $C060 TAPEIN
+static void TapeScheduleNextEdge()
+{
+	if (g_tapeSyncEvent.m_active)
+		g_SynchronousEventMgr.Remove(g_tapeSyncEvent.m_id);
+
+	if (!g_bTapePlaying)
+		return;
+
+	const double cycles = g_tapeNextEdgeCycle - (double)g_nCumulativeCycles;
+	g_tapeSyncEvent.SetCycles(std::max<int>(1, (int)ceil(cycles)));
+	g_SynchronousEventMgr.Insert(&g_tapeSyncEvent);
+}
+
+static void TapePlay(UINT64 cycle)
+{
+	if (g_bTapePlaying || g_tapeEdgeIndex >= g_tapeHalfCycles.size())
+		return;
+
+	g_bTapePlaying = true;
+	g_tapeNextEdgeCycle = (double)cycle + HalfCycleToCycles(g_tapeEdgeIndex);
+	TapeScheduleNextEdge();
+}
+
+// Play all the edges up to (and including) this cycle
+static void TapeUpdate(UINT64 cycle)
+{
+	while (g_bTapePlaying && g_tapeNextEdgeCycle <= (double)cycle)
+	{
+		g_tapeLevel = !g_tapeLevel;
+
+		if (++g_tapeEdgeIndex >= g_tapeHalfCycles.size())
+		{
+			g_bTapePlaying = false;
+			LogFileOutput("Tape: end of tape\n");
+			break;
+		}
+
+		g_tapeNextEdgeCycle += HalfCycleToCycles(g_tapeEdgeIndex);
+	}
+}
+
+static int TapeSyncEventCallback(int id, int /*cycles*/, ULONG uExecutedCycles)
+{
+	CpuCalcCycles(uExecutedCycles);
+	TapeUpdate(g_nCumulativeCycles);
+
+	if (!g_bTapePlaying)
+		return 0;	// Don't repeat event
+
+	return std::max<int>(1, (int)ceil(g_tapeNextEdgeCycle - (double)g_nCumulativeCycles));
+}
+
+//---------------------------------------------------------------------------
+
+// Fast-load: decode the Monitor's tape format directly. Half-cycles are:
+// . header: 770Hz (~650us), then sync: ~200us + ~250us
+// . data bits (MSB first): '0' = 2 x 250us, '1' = 2 x 500us
+static const double kHeaderMinUsecs = 575.0;
+static const double kSyncMaxUsecs = 425.0;
+static const double kBitThresholdUsecs = 750.0;	// For a full-cycle
+static const UINT kMinHeaderHalfCycles = 64;
+
+static bool TapeDecodeByte(size_t& index, BYTE& byte)
+{
+	byte = 0;
+	for (UINT bit = 0; bit < 8; bit++)
+	{
+		if (index + 1 >= g_tapeHalfCycles.size())
+			return false;
+
+		const double usecs = HalfCycleToUsecs(index) + HalfCycleToUsecs(index + 1);
+		byte = (byte << 1) | (usecs > kBitThresholdUsecs ? 1 : 0);
+		index += 2;
+	}
+
+	return true;
+}
+
+// Check that READ ($FEFD) is the Monitor's, and that the TAPEIN read is its first call of RD2BIT->RDBIT
+static bool IsMonitorReadFirstPoll(WORD pc)
+{
+	static const BYTE kRead[] = { 0x20, 0xFA, 0xFC, 0xA9, 0x16, 0x20, 0xC9, 0xFC };	// FEFD: JSR RD2BIT; LDA #$16; JSR HEADR
+	static const BYTE kRdBit[] = { 0x88, 0xAD, 0x60, 0xC0 };						// FCFD: DEY; LDA TAPEIN
+	static const BYTE kPrErr[] = { 0xA9, 0xC5 };									// FF2D: LDA #$C5
+	static const BYTE kBell[] = { 0xA9, 0x87 };										// FF3A: LDA #$87
+
+	if (pc != 0xFD01)	// After LDA TAPEIN
+		return false;
+
+	// Stack: RDBIT's return to RD2BIT ($FCFC), then RD2BIT's return to READ ($FEFF)
+	const WORD sp = regs.sp;
+	if (ReadByteFromMemory(0x100 | ((sp + 1) & 0xFF)) != 0xFC || ReadByteFromMemory(0x100 | ((sp + 2) & 0xFF)) != 0xFC ||
+		ReadByteFromMemory(0x100 | ((sp + 3) & 0xFF)) != 0xFF || ReadByteFromMemory(0x100 | ((sp + 4) & 0xFF)) != 0xFE)
+		return false;
+
+	for (UINT i = 0; i < sizeof(kRead); i++)
+		if (ReadByteFromMemory(0xFEFD + i) != kRead[i]) return false;
+	for (UINT i = 0; i < sizeof(kRdBit); i++)
+		if (ReadByteFromMemory(0xFCFD + i) != kRdBit[i]) return false;
+	for (UINT i = 0; i < sizeof(kPrErr); i++)
+		if (ReadByteFromMemory(0xFF2D + i) != kPrErr[i]) return false;
+	for (UINT i = 0; i < sizeof(kBell); i++)
+		if (ReadByteFromMemory(0xFF3A + i) != kBell[i]) return false;
+
+	return true;
+}
+
+static bool TapeFastLoad(UINT64 cycle)
+{
+	const size_t numHalfCycles = g_tapeHalfCycles.size();
+	size_t index = g_tapeEdgeIndex;
+
+	// Find the end of a header
+	UINT numHeader = 0;
+	while (index < numHalfCycles && !(numHeader >= kMinHeaderHalfCycles && HalfCycleToUsecs(index) < kSyncMaxUsecs))
+	{
+		numHeader = (HalfCycleToUsecs(index) > kHeaderMinUsecs) ? numHeader + 1 : 0;
+		index++;
+	}
+
+	index += 2;	// Skip sync
+	if (index >= numHalfCycles)
+		return false;
+
+	// Monitor's A1 (start) & A2 (end) addresses: READ stores at A1, then increments it until it's past A2 (at least 1 byte)
+	WORD addr = ReadByteFromMemory(0x3C) | (ReadByteFromMemory(0x3D) << 8);
+	const WORD endAddr = ReadByteFromMemory(0x3E) | (ReadByteFromMemory(0x3F) << 8);
+	const UINT numBytes = (addr <= endAddr) ? (UINT)(endAddr - addr) + 1 : 1;
+
+	// Decode everything first, so nothing is changed if the tape runs out
+	std::vector<BYTE> data(numBytes + 1);	// Including the checksum
+	for (UINT i = 0; i < data.size(); i++)
+	{
+		if (!TapeDecodeByte(index, data[i]))
+			return false;
+	}
+
+	BYTE checksum = 0xFF;
+	for (UINT i = 0; i < numBytes; i++)
+	{
+		WriteByteToMemory(addr++, data[i]);
+		checksum ^= data[i];
+	}
+
+	WriteByteToMemory(0x3C, addr & 0xFF);
+	WriteByteToMemory(0x3D, addr >> 8);
+	WriteByteToMemory(0x2E, checksum);		// CHKSUM
+
+	// Return from RDBIT & RD2BIT, and continue READ at BELL (ok) or PRERR (checksum error)
+	const bool bOK = data[numBytes] == checksum;
+	regs.sp = 0x100 | ((regs.sp + 4) & 0xFF);
+	regs.pc = bOK ? 0xFF3A : 0xFF2D;
+
+	// Continue the tape from here, with no time having passed
+	// . each skipped half-cycle ends with an edge, so the level is as if they'd been played (see TapeUpdate())
+	if ((index - g_tapeEdgeIndex) & 1)
+		g_tapeLevel = !g_tapeLevel;
+	g_tapeEdgeIndex = index;
+	if (g_tapeEdgeIndex < numHalfCycles)
+	{
+		g_tapeNextEdgeCycle = (double)cycle + HalfCycleToCycles(g_tapeEdgeIndex);
+		TapeScheduleNextEdge();
+	}
+	else
+	{
+		TapeStop();
+	}
+
+	LogFileOutput("Tape: fast-load of %u bytes%s\n", numBytes, bOK ? "" : " (checksum error)");
+	return true;
+}
+
+//---------------------------------------------------------------------------
+
+BYTE __stdcall TapeRead(WORD pc, WORD address, BYTE, BYTE, ULONG nExecutedCycles)	// $C060 TAPEIN
 {
 	if (g_Apple2Type == A2TYPE_PRAVETS8A)
 		return GetPravets().GetKeycode( MemReadFloatingBus(nExecutedCycles) );
 
-	return MemReadFloatingBus(true, nExecutedCycles); // TAPEIN has high bit 1 when input is low or not connected (UTAIIe page 7-5, 7-6)
+	if (!g_tapeHalfCycles.empty())
+	{
+		CpuCalcCycles(nExecutedCycles);
+		TapePlay(g_nCumulativeCycles);
+		TapeUpdate(g_nCumulativeCycles);
+
+		if (g_bTapeFastLoad && g_bTapePlaying)
+		{
+			if (!IsMonitorReadFirstPoll(pc))
+				g_bTapeFastLoadTried = false;
+			else if (!g_bTapeFastLoadTried)
+			{
+				g_bTapeFastLoadTried = true;	// Only try once per READ, then it just reads in real-time
+				TapeFastLoad(g_nCumulativeCycles);
+			}
+		}
+	}
+
+	return MemReadFloatingBus(!g_tapeLevel, nExecutedCycles); // TAPEIN has high bit 1 when input is low or not connected (UTAIIe page 7-5, 7-6)
+}
+
+//---------------------------------------------------------------------------
+
+static void TapeOutputWavSamples(UINT64 cycle)
+{
+	const UINT64 endFrame = (UINT64)((double)(cycle - g_tapeOutStartCycle) * kTapeOutWavSampleRate / g_fCurrentCLK6502);
+	const short sample = g_tapeOutLevel ? 0x4000 : -0x4000;
+
+	short buffer[1024];
+	for (UINT i = 0; i < sizeof(buffer) / sizeof(buffer[0]); i++)
+		buffer[i] = sample;
+
+	while (g_tapeOutWavFrames < endFrame)
+	{
+		const UINT numFrames = (UINT)std::min<UINT64>(endFrame - g_tapeOutWavFrames, sizeof(buffer) / sizeof(buffer[0]));
+		fwrite(buffer, sizeof(short), numFrames, g_hTapeOutFile);
+		g_tapeOutWavFrames += numFrames;
+	}
+}
+
+static void TapeOutputA2tHalfCycle(UINT64 ticks)
+{
+	BYTE buffer[2] = { 0, 0 };
+
+	for (; ticks > 0xFFFF; ticks -= 0x10000)
+		fwrite(buffer, 1, 2, g_hTapeOutFile);
+
+	buffer[0] = (BYTE)(ticks & 0xFF);
+	buffer[1] = (BYTE)(ticks >> 8);
+	fwrite(buffer, 1, 2, g_hTapeOutFile);
+}
+
+bool TapeOutputStart(const std::string& strFilename)
+{
+	TapeOutputStop();
+
+	g_hTapeOutFile = fopen(strFilename.c_str(), "wb");
+	if (!g_hTapeOutFile)
+	{
+		LogFileOutput("TapeOutputStart: Failed to create: %s\n", strFilename.c_str());
+		return false;
+	}
+
+	g_bTapeOutWav = HasExtension(strFilename, ".wav");
+	g_bTapeOutStarted = false;
+	g_tapeOutLevel = false;
+	g_tapeOutWavFrames = 0;
+
+	if (g_bTapeOutWav)
+	{
+		RiffWriteHeader(g_hTapeOutFile, kTapeOutWavSampleRate, 1, 0);
+	}
+	else
+	{
+		BYTE header[sizeof(kA2tMagic) + 4];
+		memcpy(header, kA2tMagic, sizeof(kA2tMagic));
+		const UINT32 ticksPerSec = (UINT32)g_fCurrentCLK6502;	// Ticks are cycles
+		for (UINT i = 0; i < 4; i++)
+			header[sizeof(kA2tMagic) + i] = (BYTE)(ticksPerSec >> (i * 8));
+		fwrite(header, 1, sizeof(header), g_hTapeOutFile);
+	}
+
+	return true;
+}
+
+void TapeOutputStop()
+{
+	if (!g_hTapeOutFile)
+		return;
+
+	if (g_bTapeOutWav)
+		RiffWriteHeader(g_hTapeOutFile, kTapeOutWavSampleRate, 1, g_tapeOutWavFrames);
+
+	fclose(g_hTapeOutFile);
+	g_hTapeOutFile = NULL;
 }
 
 BYTE __stdcall TapeWrite(WORD, WORD address, BYTE, BYTE, ULONG nExecutedCycles)	// $C020 TAPEOUT
 {
+	if (g_hTapeOutFile)
+	{
+		CpuCalcCycles(nExecutedCycles);
+		const UINT64 cycle = g_nCumulativeCycles;
+
+		if (!g_bTapeOutStarted)
+		{
+			// Start at the first edge (ie. no leading silence)
+			g_bTapeOutStarted = true;
+			g_tapeOutStartCycle = cycle;
+		}
+		else if (g_bTapeOutWav)
+		{
+			TapeOutputWavSamples(cycle);
+		}
+		else
+		{
+			TapeOutputA2tHalfCycle(std::max<UINT64>(1, cycle - g_tapeOutLastEdgeCycle));
+		}
+
+		g_tapeOutLastEdgeCycle = cycle;
+		g_tapeOutLevel = !g_tapeOutLevel;	// Each access toggles the output
+	}
+
 	return 0;
 }
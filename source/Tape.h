@@ -2,3 +2,11 @@
 
 BYTE __stdcall TapeRead(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG nExecutedCycles);
 BYTE __stdcall TapeWrite(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG nExecutedCycles);
+
+bool TapeInsert(const std::string& strFilename);	// .wav or .a2t
+void TapeEject();
+void TapeStop();
+void TapeSetFastLoad(bool bEnable);
+
+bool TapeOutputStart(const std::string& strFilename);	// .wav or .a2t
+void TapeOutputStop();
@@ -0,0 +1,304 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2024, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: In-process loopback network backend - a learning virtual switch, with optional .pcap capture
+ *
+ * Author: Various
+ */
+
+#include "StdAfx.h"
+
+#include "LoopbackBackend.h"
+#include "../Core.h"
+#include "../CPU.h"
+#include "../Log.h"
+
+#include <map>
+#include <mutex>
+
+static const char kLoopbackPrefix[] = "loopback";
+
+// Ethernet header: Dest MAC + Source MAC + Ether Type
+static const int kEthHeaderSize = 6 + 6 + 2;
+
+//===========================================================================
+
+// Frames are forwarded like a (self-learning) Ethernet switch:
+// . the source MAC of each transmitted frame is learnt, so unicast frames only go to that MAC's port
+// . broadcast, multicast & unknown destinations are flooded to all the other ports
+class VirtualSwitch
+{
+public:
+	void Attach(LoopbackBackend* pPort)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_ports.push_back(pPort);
+	}
+
+	void Detach(LoopbackBackend* pPort)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (std::vector<LoopbackBackend*>::iterator it = m_ports.begin(); it != m_ports.end(); ++it)
+		{
+			if (*it == pPort)
+			{
+				m_ports.erase(it);
+				break;
+			}
+		}
+
+		std::map<uint64_t, LoopbackBackend*>::iterator it = m_macTable.begin();
+		while (it != m_macTable.end())
+		{
+			if (it->second == pPort)
+				it = m_macTable.erase(it);
+			else
+				++it;
+		}
+	}
+
+	void Forward(LoopbackBackend* pFrom, const LoopbackBackend::Frame& frame)
+	{
+		const uint8_t* pFrame = frame->data();
+		const uint64_t dest = MACToKey(pFrame + 0);
+		const uint64_t source = MACToKey(pFrame + 6);
+		const bool isGroup = (pFrame[0] & 1) != 0;	// broadcast or multicast
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!(pFrame[6] & 1))
+			m_macTable[source] = pFrom;
+
+		if (!isGroup)
+		{
+			std::map<uint64_t, LoopbackBackend*>::const_iterator it = m_macTable.find(dest);
+			if (it != m_macTable.end())
+			{
+				if (it->second != pFrom)
+					Enqueue(it->second, frame);
+				return;
+			}
+		}
+
+		for (size_t i = 0; i < m_ports.size(); i++)
+		{
+			if (m_ports[i] != pFrom)
+				Enqueue(m_ports[i], frame);
+		}
+	}
+
+	bool Dequeue(LoopbackBackend* pPort, LoopbackBackend::Frame& frame)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (pPort->m_rxQueue.empty())
+			return false;
+
+		frame = pPort->m_rxQueue.front();
+		pPort->m_rxQueue.pop_front();
+		return true;
+	}
+
+private:
+	static uint64_t MACToKey(const uint8_t* pMAC)
+	{
+		uint64_t key = 0;
+		for (int i = 0; i < 6; i++)
+			key = (key << 8) | pMAC[i];
+		return key;
+	}
+
+	static void Enqueue(LoopbackBackend* pPort, const LoopbackBackend::Frame& frame)
+	{
+		// Like a real switch: if the port isn't keeping up, then drop the frame
+		if (pPort->m_rxQueue.size() < kMaxQueuedFrames)
+			pPort->m_rxQueue.push_back(frame);
+	}
+
+	static const size_t kMaxQueuedFrames = 256;
+
+	std::mutex m_mutex;
+	std::vector<LoopbackBackend*> m_ports;
+	std::map<uint64_t, LoopbackBackend*> m_macTable;
+};
+
+// Switches are shared by name, and live for as long as they have a port
+static std::shared_ptr<VirtualSwitch> GetVirtualSwitch(const std::string& name)
+{
+	static std::mutex s_mutex;
+	static std::map<std::string, std::weak_ptr<VirtualSwitch>> s_switches;
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+
+	std::shared_ptr<VirtualSwitch> virtualSwitch = s_switches[name].lock();
+	if (!virtualSwitch)
+	{
+		virtualSwitch = std::make_shared<VirtualSwitch>();
+		s_switches[name] = virtualSwitch;
+	}
+
+	return virtualSwitch;
+}
+
+//===========================================================================
+
+// Capture to a libpcap file (LINKTYPE_ETHERNET)
+class PcapCapture
+{
+public:
+	PcapCapture() : m_file(NULL) {}
+	~PcapCapture() { Close(); }
+
+	void Open(const std::string& filename)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Close();
+		if (filename.empty())
+			return;
+
+		m_file = fopen(filename.c_str(), "wb");
+		if (!m_file)
+		{
+			LogFileOutput("Loopback: failed to open capture file: %s\n", filename.c_str());
+			return;
+		}
+
+		const uint32_t header[6] = {
+			0xa1b2c3d4,		// magic (microsecond timestamps)
+			0x00040002,		// version 2.4 (minor:major, as little-endian uint16s)
+			0,				// thiszone
+			0,				// sigfigs
+			65535,			// snaplen
+			1				// network: LINKTYPE_ETHERNET
+		};
+		fwrite(header, sizeof(header), 1, m_file);
+	}
+
+	void Write(const LoopbackBackend::Frame& frame)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (!m_file)
+			return;
+
+		// Emulated time, so that a capture is reproducible
+		const UINT64 usecs = (UINT64)((double)g_nCumulativeCycles * 1000000.0 / g_fCurrentCLK6502);
+		const uint32_t size = (uint32_t)frame->size();
+		const uint32_t recordHeader[4] = { (uint32_t)(usecs / 1000000), (uint32_t)(usecs % 1000000), size, size };
+		fwrite(recordHeader, sizeof(recordHeader), 1, m_file);
+		fwrite(frame->data(), size, 1, m_file);
+	}
+
+private:
+	void Close()
+	{
+		if (m_file)
+		{
+			fclose(m_file);
+			m_file = NULL;
+		}
+	}
+
+	std::mutex m_mutex;
+	FILE* m_file;
+};
+
+static PcapCapture& GetPcapCapture()
+{
+	static PcapCapture capture;
+	return capture;
+}
+
+//===========================================================================
+
+LoopbackBackend::LoopbackBackend(const std::string & interfaceName) : m_interfaceName(interfaceName)
+{
+	// "loopback" or "loopback:<switch>"
+	const size_t prefixLen = sizeof(kLoopbackPrefix) - 1;
+	const std::string switchName = (interfaceName.size() > prefixLen + 1) ? interfaceName.substr(prefixLen + 1) : "";
+
+	m_switch = GetVirtualSwitch(switchName);
+	m_switch->Attach(this);
+}
+
+LoopbackBackend::~LoopbackBackend()
+{
+	m_switch->Detach(this);
+}
+
+void LoopbackBackend::transmit(const int txlength, uint8_t *txframe)
+{
+	if (txlength < kEthHeaderSize || txlength > MAX_TXLENGTH)
+		return;
+
+	// The only copy: then shared by all the ports that it's forwarded to (and the capture)
+	const Frame frame = std::make_shared<const std::vector<uint8_t>>(txframe, txframe + txlength);
+
+	GetPcapCapture().Write(frame);
+	m_switch->Forward(this, frame);
+}
+
+int LoopbackBackend::receive(const int size, uint8_t * rxframe)
+{
+	Frame frame;
+	if (!m_switch->Dequeue(this, frame))
+		return -1;
+
+	const int len = std::min<int>(size, (int)frame->size());
+	memcpy(rxframe, frame->data(), len);
+	return len;
+}
+
+void LoopbackBackend::update(const ULONG /* nExecutedCycles */)
+{
+	// nothing to do: frames are forwarded when transmitted
+}
+
+void LoopbackBackend::getMACAddress(const uint32_t /* address */, MACAddress & mac)
+{
+	memset(mac.address, 0xff, sizeof(mac.address));
+}
+
+bool LoopbackBackend::isValid()
+{
+	return true;
+}
+
+const std::string & LoopbackBackend::getInterfaceName()
+{
+	return m_interfaceName;
+}
+
+bool LoopbackBackend::IsLoopbackInterface(const std::string & interfaceName)
+{
+	const size_t prefixLen = sizeof(kLoopbackPrefix) - 1;
+	return interfaceName.compare(0, prefixLen, kLoopbackPrefix) == 0 &&
+		(interfaceName.size() == prefixLen || interfaceName[prefixLen] == ':');
+}
+
+void LoopbackBackend::SetCaptureFilename(const std::string & filename)
+{
+	GetPcapCapture().Open(filename);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "NetworkBackend.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+class VirtualSwitch;
+
+// In-process network (interface name: "loopback" or "loopback:<switch>")
+// . all the Uthernet/Uthernet II cards in this process using the same switch name are connected to the same virtual switch
+// . frames are never copied between ports: each transmitted frame is shared by all the ports it's forwarded to
+// . no host interface or privileges needed (eg. for CI), and all traffic can be captured to a .pcap file
+class LoopbackBackend : public NetworkBackend
+{
+public:
+	LoopbackBackend(const std::string & interfaceName);
+
+	virtual ~LoopbackBackend();
+
+	// transmit a packet
+	virtual void transmit(
+		const int txlength,		/* Frame length */
+		uint8_t *txframe		/* Pointer to the frame to be transmitted */
+	);
+
+	// receive a single packet, return size (>0) or missing (-1)
+	virtual int receive(const int size, uint8_t * rxframe);
+
+	// process pending packets
+	virtual void update(const ULONG nExecutedCycles);
+
+	// get MAC for IPRAW: there's no ARP, so broadcast (ie. to all the other ports on the switch)
+	virtual void getMACAddress(const uint32_t address, MACAddress & mac);
+
+	// if the backend is usable
+	virtual bool isValid();
+
+	// get interface name
+	virtual const std::string & getInterfaceName();
+
+	static bool IsLoopbackInterface(const std::string & interfaceName);
+
+	// Capture all loopback traffic (all switches) to a .pcap file, timestamped in emulated time ("" = stop capturing)
+	static void SetCaptureFilename(const std::string & filename);
+
+	typedef std::shared_ptr<const std::vector<uint8_t>> Frame;
+
+private:
+	friend class VirtualSwitch;
+
+	const std::string m_interfaceName;
+	std::shared_ptr<VirtualSwitch> m_switch;
+	std::deque<Frame> m_rxQueue;	// guarded by the switch
+};
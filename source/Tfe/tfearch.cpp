@@ -90,7 +90,7 @@ void TfePcapFreeLibrary()
 {
     if (pcap_library) {
         if (!FreeLibrary(pcap_library)) {
-            if(g_fh) fprintf(g_fh, "FreeLibrary WPCAP.DLL failed!\n");
+            LogFileOutput("FreeLibrary WPCAP.DLL failed!\n");
         }
         pcap_library = NULL;
 
@@ -111,7 +111,7 @@ void TfePcapFreeLibrary()
 #define GET_PROC_ADDRESS_AND_TEST( _name_ ) \
     p_##_name_ = (_name_##_t) GetProcAddress(pcap_library, #_name_ ); \
     if (!p_##_name_ ) { \
-        if(g_fh) fprintf(g_fh, "GetProcAddress " #_name_ " failed!\n"); \
+        LogFileOutput("GetProcAddress " #_name_ " failed!\n"); \
         TfePcapFreeLibrary(); \
         return FALSE; \
     } 
@@ -144,7 +144,7 @@ bool TfePcapLoadLibrary()
     if (!pcap_library)
     {
         tfe_cannot_use = 1;
-        if(g_fh) fprintf(g_fh, "LoadLibrary WPCAP.DLL failed!\n" );
+        LogFileOutput("LoadLibrary WPCAP.DLL failed!\n" );
         return false;
     }
 
@@ -265,12 +265,12 @@ bool tfe_arch_enumadapter_open()
 
     if ((*p_pcap_findalldevs)(&TfePcapAlldevs, TfePcapErrbuf) == -1)
     {
-        if(g_fh) fprintf(g_fh, "ERROR in TfeEnumAdapterOpen: pcap_findalldevs: '%s'\n", TfePcapErrbuf);
+        LogFileOutput("ERROR in TfeEnumAdapterOpen: pcap_findalldevs: '%s'\n", TfePcapErrbuf);
         return false;
     }
 
 	if (!TfePcapAlldevs) {
-        if(g_fh) fprintf(g_fh, "ERROR in TfeEnumAdapterOpen, finding all pcap devices - "
+        LogFileOutput("ERROR in TfeEnumAdapterOpen, finding all pcap devices - "
 			"Do we have the necessary privilege rights?\n");
 		return false;
 	}
@@ -346,27 +346,27 @@ pcap_t * TfePcapOpenAdapter(const std::string & interface_name)
     pcap_t * TfePcapFP = (*p_pcap_open_live)(TfePcapDevice->name, 1700, 1, 20, TfePcapErrbuf);
     if ( TfePcapFP == NULL)
     {
-        if(g_fh) fprintf(g_fh, "ERROR opening adapter: '%s'\n", TfePcapErrbuf);
+        LogFileOutput("ERROR opening adapter: '%s'\n", TfePcapErrbuf);
         tfe_arch_enumadapter_close();
         return NULL;
     }
 
     if ((*p_pcap_setnonblock)(TfePcapFP, 1, TfePcapErrbuf)<0)
     {
-        if(g_fh) fprintf(g_fh, "WARNING: Setting PCAP to non-blocking failed: '%s'\n", TfePcapErrbuf);
+        LogFileOutput("WARNING: Setting PCAP to non-blocking failed: '%s'\n", TfePcapErrbuf);
     }
 
 	/* Check the link layer. We support only Ethernet for simplicity. */
 	if((*p_pcap_datalink)(TfePcapFP) != DLT_EN10MB)
 	{
-		if(g_fh) fprintf(g_fh, "ERROR: TFE works only on Ethernet networks.\n");
+		LogFileOutput("ERROR: TFE works only on Ethernet networks.\n");
 		tfe_arch_enumadapter_close();
         (*p_pcap_close)(TfePcapFP);
         TfePcapFP = NULL;
         return NULL;
 	}
 
-    if(g_fh) fprintf(g_fh, "PCAP: Successfully opened adapter: '%s' (%s)\n", TfePcapDevice->name, TfePcapDevice->description);
+    LogFileOutput("PCAP: Successfully opened adapter: '%s' (%s)\n", TfePcapDevice->name, TfePcapDevice->description);
 
     tfe_arch_enumadapter_close();
     return TfePcapFP;
@@ -386,7 +386,7 @@ void TfePcapCloseAdapter(pcap_t * TfePcapFP)
 void tfe_arch_set_mac( const BYTE mac[6] )
 {
 #if defined(TFE_DEBUG_ARCH) || defined(TFE_DEBUG_FRAMES)
-    if(g_fh) fprintf( g_fh, "New MAC address set: %02X:%02X:%02X:%02X:%02X:%02X.\n",
+    LogFileOutput("New MAC address set: %02X:%02X:%02X:%02X:%02X:%02X.\n",
         mac[0], mac[1], mac[2], mac[3], mac[4], mac[5] );
 #endif
 }
@@ -394,7 +394,7 @@ void tfe_arch_set_mac( const BYTE mac[6] )
 void tfe_arch_set_hashfilter(const uint32_t hash_mask[2])
 {
 #if defined(TFE_DEBUG_ARCH) || defined(TFE_DEBUG_FRAMES)
-    if(g_fh) fprintf( g_fh, "New hash filter set: %08X:%08X.\n",
+    LogFileOutput("New hash filter set: %08X:%08X.\n",
         hash_mask[1], hash_mask[0]);
 #endif
 }
@@ -404,7 +404,7 @@ void tfe_arch_set_hashfilter(const uint32_t hash_mask[2])
 void tfe_arch_receive_remove_committed_frame()
 {
 #ifdef TFE_DEBUG_ARCH
-    if(g_fh) fprintf( g_fh, "tfe_arch_receive_remove_committed_frame().\n" );
+    LogFileOutput("tfe_arch_receive_remove_committed_frame().\n" );
 #endif
 }
 */
@@ -421,14 +421,14 @@ void tfe_arch_recv_ctl( bool bBroadcast,   /* broadcast */
 {
 #if defined(TFE_DEBUG_ARCH) || defined(TFE_DEBUG_FRAMES)
 	if(g_fh) {
-		fprintf( g_fh, "tfe_arch_recv_ctl() called with the following parameters:" );
-		fprintf( g_fh, "\tbBroadcast   = %s", _b2psz(bBroadcast) );
-		fprintf( g_fh, "\tbIA          = %s", _b2psz(bIA) );
-		fprintf( g_fh, "\tbMulticast   = %s", _b2psz(bMulticast) );
-		fprintf( g_fh, "\tbCorrect     = %s", _b2psz(bCorrect) );
-		fprintf( g_fh, "\tbPromiscuous = %s", _b2psz(bPromiscuous) );
-		fprintf( g_fh, "\tbIAHash      = %s", _b2psz(bIAHash) );
-		fprintf( g_fh, "\n" );
+		LogFileOutput( "tfe_arch_recv_ctl() called with the following parameters:" );
+		LogFileOutput( "\tbBroadcast   = %s", _b2psz(bBroadcast) );
+		LogFileOutput( "\tbIA          = %s", _b2psz(bIA) );
+		LogFileOutput( "\tbMulticast   = %s", _b2psz(bMulticast) );
+		LogFileOutput( "\tbCorrect     = %s", _b2psz(bCorrect) );
+		LogFileOutput( "\tbPromiscuous = %s", _b2psz(bPromiscuous) );
+		LogFileOutput( "\tbIAHash      = %s", _b2psz(bIAHash) );
+		LogFileOutput( "\n" );
 	}
 #endif
 }
@@ -437,10 +437,10 @@ void tfe_arch_line_ctl(bool bEnableTransmitter, bool bEnableReceiver)
 {
 #if defined(TFE_DEBUG_ARCH) || defined(TFE_DEBUG_FRAMES)
 	if(g_fh) {
-		fprintf( g_fh, "tfe_arch_line_ctl() called with the following parameters:" );
-		fprintf( g_fh, "\tbEnableTransmitter = %s", _b2psz(bEnableTransmitter) );
-		fprintf( g_fh, "\tbEnableReceiver    = %s", _b2psz(bEnableReceiver) );
-		fprintf( g_fh, "\n" );
+		LogFileOutput( "tfe_arch_line_ctl() called with the following parameters:" );
+		LogFileOutput( "\tbEnableTransmitter = %s", _b2psz(bEnableTransmitter) );
+		LogFileOutput( "\tbEnableReceiver    = %s", _b2psz(bEnableReceiver) );
+		LogFileOutput( "\n" );
 	}
 #endif
 }
@@ -497,7 +497,7 @@ int tfe_arch_receive_frame(pcap_t * TfePcapFP, TFE_PCAP_INTERNAL *pinternal)
     }
 
 #ifdef TFE_DEBUG_ARCH
-    if(g_fh) fprintf( g_fh, "tfe_arch_receive_frame() called, returns %d (%s).\n", ret, error );
+    LogFileOutput("tfe_arch_receive_frame() called, returns %d (%s).\n", ret, error );
 #endif
 
     return ret;
@@ -509,7 +509,7 @@ void tfe_arch_transmit(pcap_t * TfePcapFP,
                       )
 {
 #ifdef TFE_DEBUG_ARCH
-    if(g_fh) fprintf( g_fh, "tfe_arch_transmit() called, with: txlength=%u\n", txlength);
+    LogFileOutput("tfe_arch_transmit() called, with: txlength=%u\n", txlength);
 #endif
 
 #ifdef TFE_DEBUG_PKTDUMP
@@ -517,7 +517,7 @@ void tfe_arch_transmit(pcap_t * TfePcapFP,
 #endif // #ifdef TFE_DEBUG_PKTDUMP
 
     if ((*p_pcap_sendpacket)(TfePcapFP, txframe, txlength) == -1) {
-        if(g_fh) fprintf(g_fh, "WARNING! Could not send packet!\n");
+        LogFileOutput("WARNING! Could not send packet!\n");
     }
 }
 
@@ -554,7 +554,7 @@ int tfe_arch_receive(pcap_t * TfePcapFP,
     TFE_PCAP_INTERNAL internal = { static_cast<unsigned int>(size), pbuffer, 0 };
 
 #ifdef TFE_DEBUG_ARCH
-    if(g_fh) fprintf( g_fh, "tfe_arch_receive() called, with size=%u.\n", size );
+    LogFileOutput("tfe_arch_receive() called, with size=%u.\n", size );
 #endif
 
     assert((size & 1)==0);
@@ -136,15 +136,15 @@ std::string debug_outbuffer(size_t length, const unsigned char* buffer)
 void Uthernet1::tfe_debug_output_general( const char *what, WORD (Uthernet1::*getFunc)(int), int count )
 {
 	if (!g_fh) return;
-	fprintf(g_fh, "%s contents:\n", what);
+	LogFileOutput("%s contents:\n", what);
 	for (int i = 0; i < count; i += 2*NUMBER_PER_LINE)
 	{
-		fprintf(g_fh, "%04X:  ", i);
+		std::string line = StrFormat("%04X:  ", i);
 		for (int j = 0; j < NUMBER_PER_LINE; j++) 
 		{
-			fprintf(g_fh, "%04X, ", (this->*getFunc)(i+j+j));
+			line += StrFormat("%04X, ", (this->*getFunc)(i+j+j));
 		}
-		fputc('\n', g_fh);
+		LogFileOutput("%s\n", line.c_str());
 	}
 }
 
@@ -186,7 +186,11 @@ Uthernet1::Uthernet1(UINT slot) : Card(CT_Uthernet, slot)
     if (m_slot == SLOT0)
         ThrowErrorInvalidSlot();
 
+    rx_pool.resize(kRxPoolFrames);
+    tx_pool.resize(kTxPoolFrames);
+
     Init();
+    ScheduleUpdateNow();
 }
 
 void Uthernet1::Init()
@@ -217,6 +221,10 @@ void Uthernet1::Init()
 
     tfe_packetpage_ptr   = 0;
 
+    rx_pool_head         = 0;
+    rx_pool_count        = 0;
+    tx_pool_count        = 0;
+
     /* according to page 19 unless stated otherwise */
     SET_PP_32(TFE_PP_ADDR_PRODUCTID,      0x0700630E ); /* p.41: 0E630007 for Rev. B; reversed order! */
     SET_PP_16(TFE_PP_ADDR_IOBASE,         0x0300);
@@ -276,7 +284,7 @@ void Uthernet1::tfe_sideeffects_write_pp_on_txframe(WORD ppaddress)
             ||  (txlen<MIN_TXLENGTH)
            ) {
 #ifdef TFE_DEBUG_WARN
-            if(g_fh) fprintf(g_fh, "WARNING! Should send %u octets: Not allowed, thus ignoring!\n", txlen);
+            LogFileOutput("WARNING! Should send %u octets: Not allowed, thus ignoring!\n", txlen);
 #endif
         }
         else {
@@ -284,7 +292,7 @@ void Uthernet1::tfe_sideeffects_write_pp_on_txframe(WORD ppaddress)
             SET_PP_16(TFE_PP_ADDR_SE_BUSST, busst & ~0x180);
 
 #ifdef TFE_DEBUG_FRAMES
-            if(g_fh) fprintf(g_fh, "tfe_arch_transmit() called with:                 "
+            LogFileOutput("tfe_arch_transmit() called with:                 "
                 "length=%4u and buffer %s", txlen,
                 debug_outbuffer(txlen, &tfe_packetpage[TFE_PP_ADDR_TX_FRAMELOC]).c_str()
                 );
@@ -352,6 +360,7 @@ void Uthernet1::tfe_sideeffects_write_pp(WORD ppaddress, int oddaddress)
                            tfe_recv_promiscuous,
 						   tfe_recv_hashfilter
                          );
+        rx_pool_count = 0;  /* the queued frames were accepted with the old settings */
         break;
 
     case TFE_PP_ADDR_CC_LINECTL:
@@ -362,13 +371,13 @@ void Uthernet1::tfe_sideeffects_write_pp(WORD ppaddress, int oddaddress)
 
     case TFE_PP_ADDR_SE_RXEVENT:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Written read-only register TFE_PP_ADDR_SE_RXEVENT: IGNORED\n");
+        LogFileOutput("WARNING! Written read-only register TFE_PP_ADDR_SE_RXEVENT: IGNORED\n");
 #endif
         break;
 
     case TFE_PP_ADDR_SE_BUSST:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Written read-only register TFE_PP_ADDR_SE_BUSST: IGNORED\n");
+        LogFileOutput("WARNING! Written read-only register TFE_PP_ADDR_SE_BUSST: IGNORED\n");
 #endif
         break;
 
@@ -379,7 +388,7 @@ void Uthernet1::tfe_sideeffects_write_pp(WORD ppaddress, int oddaddress)
 #ifdef TFE_DEBUG_WARN
         /* check if we had a TXCMD, but not all octets were written */
         if (tfe_started_tx && !oddaddress) {
-            if(g_fh) fprintf(g_fh, "WARNING! Early abort of transmitted frame\n");
+            LogFileOutput("WARNING! Early abort of transmitted frame\n");
         }
         tfe_started_tx = true;
 #endif
@@ -419,6 +428,7 @@ void Uthernet1::tfe_sideeffects_write_pp(WORD ppaddress, int oddaddress)
 			*p |= GET_PP_8(ppaddress+oddaddress) << pos;
 
 			tfe_arch_set_hashfilter(tfe_hash_mask);
+			rx_pool_count = 0;  /* the queued frames were accepted with the old settings */
 		}
 		break;
 
@@ -429,6 +439,7 @@ void Uthernet1::tfe_sideeffects_write_pp(WORD ppaddress, int oddaddress)
         tfe_ia_mac[ppaddress-TFE_PP_ADDR_MAC_ADDR+oddaddress] =
             GET_PP_8(ppaddress+oddaddress);
         tfe_arch_set_mac(tfe_ia_mac);
+        rx_pool_count = 0;  /* the queued frames were accepted with the old settings */
 		break;
     }
 }
@@ -463,13 +474,13 @@ void Uthernet1::tfe_sideeffects_read_pp(WORD ppaddress)
 
     case TFE_PP_ADDR_TXCMD:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Read write-only register TFE_PP_ADDR_TXCMD: IGNORED\n");
+        LogFileOutput("WARNING! Read write-only register TFE_PP_ADDR_TXCMD: IGNORED\n");
 #endif
         break;
 
     case TFE_PP_ADDR_TXLENGTH:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Read write-only register TFE_PP_ADDR_TXLENGTH: IGNORED\n");
+        LogFileOutput("WARNING! Read write-only register TFE_PP_ADDR_TXLENGTH: IGNORED\n");
 #endif
         break;
     }
@@ -555,7 +566,7 @@ BYTE Uthernet1::tfe_read(WORD ioaddress)
     case TFE_ADDR_TXLENGTH:
     case TFE_ADDR_TXLENGTH+1:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Reading write-only TFE register $%02X!\n", ioaddress);
+        LogFileOutput("WARNING! Reading write-only TFE register $%02X!\n", ioaddress);
 #endif
         /* @SRT TODO: Verify with reality */
         retval = GET_TFE_8(ioaddress);
@@ -566,7 +577,7 @@ BYTE Uthernet1::tfe_read(WORD ioaddress)
     case TFE_ADDR_PP_DATA2:
     case TFE_ADDR_PP_DATA2+1:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Reading not supported TFE register $%02X!\n", ioaddress);
+        LogFileOutput("WARNING! Reading not supported TFE register $%02X!\n", ioaddress);
 #endif
         /* @SRT TODO */
         retval = GET_TFE_8(ioaddress);
@@ -587,7 +598,7 @@ BYTE Uthernet1::tfe_read(WORD ioaddress)
 
 
 #ifdef TFE_DEBUG_LOAD
-        if(g_fh) fprintf(g_fh, "reading PP Ptr: $%04X => $%04X.",
+        LogFileOutput("reading PP Ptr: $%04X => $%04X.",
             tfe_packetpage_ptr, GET_PP_16(tfe_packetpage_ptr) );
 #endif
 
@@ -615,7 +626,7 @@ BYTE Uthernet1::tfe_read(WORD ioaddress)
     };
 
 #ifdef TFE_DEBUG_LOAD
-    if(g_fh) fprintf(g_fh, "read [$%02X] => $%02X.", ioaddress, retval);
+    LogFileOutput("read [$%02X] => $%02X.", ioaddress, retval);
 #endif
     return retval;
 }
@@ -635,7 +646,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
     case TFE_ADDR_INTSTQUEUE:
     case TFE_ADDR_INTSTQUEUE+1:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Writing read-only TFE register $%02X!\n", ioaddress);
+        LogFileOutput("WARNING! Writing read-only TFE register $%02X!\n", ioaddress);
 #endif
         /* @SRT TODO: Verify with reality */
         /* do nothing */
@@ -646,7 +657,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
     case TFE_ADDR_PP_DATA2:
     case TFE_ADDR_PP_DATA2+1:
 #ifdef TFE_DEBUG_WARN
-        if(g_fh) fprintf(g_fh, "WARNING! Writing not supported TFE register $%02X!\n", ioaddress);
+        LogFileOutput("WARNING! Writing not supported TFE register $%02X!\n", ioaddress);
 #endif
         /* do nothing */
         return;
@@ -691,7 +702,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
     }
 
 #ifdef TFE_DEBUG_STORE
-    if(g_fh) fprintf(g_fh, "store [$%02X] <= $%02X.", ioaddress, (int)byte);
+    LogFileOutput("store [$%02X] <= $%02X.", ioaddress, (int)byte);
 #endif
 
     /* now check if we have to do any side-effects */
@@ -702,14 +713,13 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
         tfe_packetpage_ptr = GET_TFE_16(TFE_ADDR_PP_PTR);
 
 #ifdef TFE_DEBUG_STORE
-        if(g_fh) fprintf(g_fh, "set PP Ptr to $%04X.", tfe_packetpage_ptr);
+        LogFileOutput("set PP Ptr to $%04X.", tfe_packetpage_ptr);
 #endif
 
         if ((tfe_packetpage_ptr & 1) != 0) {
 
 #ifdef TFE_DEBUG_WARN
-            if(g_fh) fprintf(g_fh,
-                "WARNING! PacketPage register set to odd address $%04X (not allowed!)\n",
+            LogFileOutput("WARNING! PacketPage register set to odd address $%04X (not allowed!)\n",
                 tfe_packetpage_ptr );
 #endif /* #ifdef TFE_DEBUG_WARN */
 
@@ -736,7 +746,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
             WORD ppaddress = tfe_packetpage_ptr & (MAX_PACKETPAGE_ARRAY-1);
 
 #ifdef TFE_DEBUG_STORE
-            if(g_fh) fprintf(g_fh, "before writing to PP Ptr: $%04X <= $%04X.",
+            LogFileOutput("before writing to PP Ptr: $%04X <= $%04X.",
                 ppaddress, GET_PP_16(ppaddress) );
 #endif
             {
@@ -749,7 +759,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
             tfe_sideeffects_write_pp(ppaddress, ioaddress-TFE_ADDR_PP_DATA);
 
 #ifdef TFE_DEBUG_STORE
-            if(g_fh) fprintf(g_fh, "after  writing to PP Ptr: $%04X <= $%04X.",
+            LogFileOutput("after  writing to PP Ptr: $%04X <= $%04X.",
                 ppaddress, GET_PP_16(ppaddress) );
 #endif
         }
@@ -765,7 +775,7 @@ void Uthernet1::tfe_store(WORD ioaddress, BYTE byte)
     { \
         int retval = _x_; \
         \
-        if(g_fh) fprintf(g_fh, "%s correct_mac=%u, broadcast=%u, multicast=%u, hashed=%u, hash_index=%u", (retval? "+++ ACCEPTED":"--- rejected"), *pcorrect_mac, *pbroadcast, *pmulticast, *phashed, *phash_index); \
+        LogFileOutput("%s correct_mac=%u, broadcast=%u, multicast=%u, hashed=%u, hash_index=%u", (retval? "+++ ACCEPTED":"--- rejected"), *pcorrect_mac, *pbroadcast, *pmulticast, *phashed, *phash_index); \
         \
         return retval; \
     }
@@ -793,7 +803,7 @@ bool Uthernet1::tfe_should_accept(unsigned char *buffer, int length, int *phashe
     *pmulticast   = 0;
 
 #ifdef TFE_DEBUG_FRAMES
-    if(g_fh) fprintf(g_fh, "tfe_should_accept called with %02X:%02X:%02X:%02X:%02X:%02X, length=%4u and buffer %s",
+    LogFileOutput("tfe_should_accept called with %02X:%02X:%02X:%02X:%02X:%02X, length=%4u and buffer %s",
         tfe_ia_mac[0], tfe_ia_mac[1], tfe_ia_mac[2],
         tfe_ia_mac[3], tfe_ia_mac[4], tfe_ia_mac[5],
         length,
@@ -864,97 +874,125 @@ bool Uthernet1::tfe_should_accept(unsigned char *buffer, int length, int *phashe
 #endif
 
 
-WORD Uthernet1::tfe_receive()
+/*
+ Move the pending frames from the backend into the RX pool (as many as there are free frames).
+ Frames are filtered here, so only accepted frames take up a place in the pool.
+*/
+void Uthernet1::tfe_fill_rx_pool()
 {
-    WORD ret_val = 0x0004;
+    while (rx_pool_count < kRxPoolFrames) {
+        RxFrame &frame = rx_pool[(rx_pool_head + rx_pool_count) % kRxPoolFrames];
 
-    BYTE buffer[MAX_RXLENGTH];
+        const int len = networkBackend->receive(
+            sizeof(frame.data), /* size of buffer */
+            frame.data          /* where to store a frame */
+            );
 
-    int  multicast = 0;
+        if (len <= 0)
+            break;
 
-    int  ready;
+        assert((len&1) == 0); /* length has to be even! */
 
-#ifdef TFE_DEBUG_FRAMES
-    if(g_fh) fprintf( g_fh, "");
-#endif
+        /* determine ourself the type of frame */
+        if (!tfe_should_accept(frame.data,
+            len, &frame.hashed, &frame.hash_index, &frame.correct_mac, &frame.broadcast, &frame.multicast)) {
 
-    do {
-        ready = 1 ; /* assume we will find a good frame */
+            /* if we should not accept this frame, just do nothing
+             * now, look for another one */
+            continue;
+        }
 
-        int len = networkBackend->receive(
-            sizeof(buffer), /* size of buffer */
-            buffer          /* where to store a frame */
-            );
+        frame.len = len;
+        ++rx_pool_count;
+    }
+}
 
-        if (len > 0) {
-            assert((len&1) == 0); /* length has to be even! */
+void Uthernet1::tfe_flush_tx_pool()
+{
+    for (UINT i = 0; i < tx_pool_count; i++) {
+        networkBackend->transmit(tx_pool[i].len, tx_pool[i].data);
+    }
+    tx_pool_count = 0;
+}
 
-            int  hashed = 0;
-            int  hash_index = 0;
-            int  broadcast = 0;
-            int  correct_mac = 0;
-            int  crc_error = 0;
+WORD Uthernet1::tfe_receive()
+{
+    WORD ret_val = 0x0004;
 
-            int  rx_ok = 1;
+#ifdef TFE_DEBUG_FRAMES
+    LogFileOutput("");
+#endif
 
-            /* determine ourself the type of frame */
-            if (!tfe_should_accept(buffer,
-                len, &hashed, &hash_index, &correct_mac, &broadcast, &multicast)) {
+    if (rx_pool_count == 0) {
+        /* the guest is waiting for a frame: so don't wait for Update() */
+        tfe_flush_tx_pool();
+        tfe_fill_rx_pool();
+    }
 
-                /* if we should not accept this frame, just do nothing
-                    * now, look for another one */
-                ready = 0; /* try another frame */
-                continue;
-            }
+    if (rx_pool_count > 0) {
+        const RxFrame &frame = rx_pool[rx_pool_head];
+        rx_pool_head = (rx_pool_head + 1) % kRxPoolFrames;
+        --rx_pool_count;
 
-            /* we did receive a frame, return that status */
-            ret_val |= rx_ok     ? 0x0100 : 0;
-            ret_val |= multicast ? 0x0200 : 0;
+        int  len = frame.len;
+        const BYTE *buffer = frame.data;
 
-            if (!multicast) {
-                ret_val |= hashed ? 0x0040 : 0;
-            }
+        const int  hashed = frame.hashed;
+        const int  hash_index = frame.hash_index;
+        const int  broadcast = frame.broadcast;
+        const int  correct_mac = frame.correct_mac;
+        const int  multicast = frame.multicast;
+        const int  crc_error = 0;
 
-            if (hashed && rx_ok) {
-                /* we have the 2nd, special format with hash index: */
-                assert(hash_index < 64);
-                ret_val |= hash_index << 9;
-            }
-            else {
-                /* we have the regular format */
-                ret_val |= correct_mac        ? 0x0400 : 0;
-                ret_val |= broadcast          ? 0x0800 : 0;
-                ret_val |= crc_error          ? 0x1000 : 0;
-                ret_val |= (len<MIN_RXLENGTH) ? 0x2000 : 0;
-                ret_val |= (len>MAX_RXLENGTH) ? 0x4000 : 0;
-            }
+        const int  rx_ok = 1;
 
-            /* discard any octets that are beyond the MAX_RXLEN */
-            if (len>MAX_RXLENGTH) {
-                len = MAX_RXLENGTH;
-            }
+        /* we did receive a frame, return that status */
+        ret_val |= rx_ok     ? 0x0100 : 0;
+        ret_val |= multicast ? 0x0200 : 0;
 
-            if (rx_ok) {
-                int i;
+        if (!multicast) {
+            ret_val |= hashed ? 0x0040 : 0;
+        }
 
-                /* set relevant parts of the PP area to correct values */
-                SET_PP_16(TFE_PP_ADDR_RXLENGTH, len);
+        if (hashed && rx_ok) {
+            /* we have the 2nd, special format with hash index: */
+            assert(hash_index < 64);
+            ret_val |= hash_index << 9;
+        }
+        else {
+            /* we have the regular format */
+            ret_val |= correct_mac        ? 0x0400 : 0;
+            ret_val |= broadcast          ? 0x0800 : 0;
+            ret_val |= crc_error          ? 0x1000 : 0;
+            ret_val |= (len<MIN_RXLENGTH) ? 0x2000 : 0;
+            ret_val |= (len>MAX_RXLENGTH) ? 0x4000 : 0;
+        }
 
-                for (i=0;i<len; i++) {
-                    SET_PP_8(TFE_PP_ADDR_RX_FRAMELOC+i, buffer[i]);
-                }
+        /* discard any octets that are beyond the MAX_RXLEN */
+        if (len>MAX_RXLENGTH) {
+            len = MAX_RXLENGTH;
+        }
+
+        if (rx_ok) {
+            int i;
 
-                /* set rx_buffer to where start reading *
-                 * According to 4.10.9 (pp. 76-77), we start with RxStatus and RxLength!
-                 */
-                rx_buffer = TFE_PP_ADDR_RXSTATUS;
+            /* set relevant parts of the PP area to correct values */
+            SET_PP_16(TFE_PP_ADDR_RXLENGTH, len);
+
+            for (i=0;i<len; i++) {
+                SET_PP_8(TFE_PP_ADDR_RX_FRAMELOC+i, buffer[i]);
             }
+
+            /* set rx_buffer to where start reading *
+             * According to 4.10.9 (pp. 76-77), we start with RxStatus and RxLength!
+             */
+            rx_buffer = TFE_PP_ADDR_RXSTATUS;
         }
-    } while (!ready);
+    }
 
 #ifdef TFE_DEBUG_FRAMES
     if (ret_val != 0x0004)
-        if(g_fh) fprintf( g_fh, "+++ tfe_receive(): ret_val=%04X", ret_val);
+        LogFileOutput("+++ tfe_receive(): ret_val=%04X", ret_val);
 #endif
 
     return ret_val;
@@ -970,7 +1008,14 @@ void Uthernet1::tfe_transmit(
 )
 {
     // non eof the existing backends do anything with these flags
-	networkBackend->transmit(txlength, txframe);
+
+    /* post the frame: it's sent by Update() (so the guest's write to TXLENGTH doesn't wait for the backend) */
+    if (tx_pool_count == kTxPoolFrames)
+        tfe_flush_tx_pool();
+
+    TxFrame &frame = tx_pool[tx_pool_count++];
+    frame.len = std::min<int>(txlength, sizeof(frame.data));
+    memcpy(frame.data, txframe, frame.len);
 }
 
 
@@ -1041,6 +1086,9 @@ void Uthernet1::Reset(const bool powerCycle)
 void Uthernet1::Update(const ULONG nExecutedCycles)
 {
     networkBackend->update(nExecutedCycles);
+    tfe_flush_tx_pool();
+    tfe_fill_rx_pool();
+    ScheduleUpdateIn(kNetworkPollCycles);
 }
 
 /* ------------------------------------------------------------------------- */
@@ -1124,6 +1172,8 @@ bool Uthernet1::LoadSnapshot(class YamlLoadHelper& yamlLoadHelper, UINT version)
 
     tfe_packetpage_ptr = GET_TFE_16(TFE_ADDR_PP_PTR);
 
+    tx_pool_count = 0;  /* don't send the old state's pending frames (the RX pool is cleared by setting the filters below) */
+
     tfe_sideeffects_write_pp(TFE_PP_ADDR_CC_RXCTL, 0);  // set the 6 tfe_recv_* vars
 
     for (UINT i = 0; i < 8; i++)
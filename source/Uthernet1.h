@@ -136,6 +136,7 @@ public:
 	static const std::string& GetSnapshotCardName();
 
 private:
+	static const ULONG kNetworkPollCycles = 1000;	// Update() period
 
 	void Init();
 
@@ -145,6 +146,8 @@ private:
 	void tfe_proceed_rx_buffer(int oddaddress);
 
 	WORD tfe_receive();
+	void tfe_fill_rx_pool();
+	void tfe_flush_tx_pool();
 	bool tfe_should_accept(unsigned char *buffer, int length, int *phashed, int *phash_index,
                            int *pcorrect_mac, int *pbroadcast, int *pmulticast) const;
 
@@ -207,4 +210,35 @@ private:
 
 	BYTE tfe_packetpage[MAX_PACKETPAGE_ARRAY];
 	WORD tfe_packetpage_ptr;
+
+	/* Pools of pre-allocated frames (not part of the save-state)
+	   . RX: accepted frames (ie. already passed tfe_should_accept()), filled in batches from the backend by Update()
+	   . TX: frames posted by the guest, sent in batches by Update() (or when the guest waits for a frame)
+	*/
+	struct RxFrame
+	{
+		int  len;
+		int  hashed;
+		int  hash_index;
+		int  correct_mac;
+		int  broadcast;
+		int  multicast;
+		BYTE data[MAX_RXLENGTH];
+	};
+
+	struct TxFrame
+	{
+		int  len;
+		BYTE data[MAX_TXLENGTH];
+	};
+
+	static const UINT kRxPoolFrames = 32;
+	static const UINT kTxPoolFrames = 16;
+
+	std::vector<RxFrame> rx_pool;
+	UINT rx_pool_head;
+	UINT rx_pool_count;
+
+	std::vector<TxFrame> tx_pool;
+	UINT tx_pool_count;
 };
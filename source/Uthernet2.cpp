@@ -74,6 +74,9 @@ typedef int socklen_t;
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -83,15 +86,20 @@ typedef int socklen_t;
 // Dest MAC + Source MAC + Ether Type
 #define ETH_MINIMUM_SIZE (6 + 6 + 2)
 
-// #define U2_LOG_VERBOSE
-// #define U2_LOG_TRAFFIC
-// #define U2_LOG_STATE
-// #define U2_LOG_UNKNOWN
+// Each category is compiled in (comment it out to remove it), then filtered at runtime by the log level of
+// the Uthernet II subsystem (see command line: -log-level uthernet2=<level>), shown after each category
+#define U2_LOG_VERBOSE	// debug
+#define U2_LOG_TRAFFIC	// trace
+#define U2_LOG_STATE	// info
+#define U2_LOG_UNKNOWN	// warning
+
+#define U2_LOG(level, ...) LOG_SUBSYSTEM_FILE(LOG_SUBSYSTEM_UTHERNET2, level, __VA_ARGS__)
 
 #define MAC_FMT "%02X:%02X:%02X:%02X:%02X:%02X"
 #define MAC_DEST(p) p[0], p[1], p[2], p[3], p[4], p[5]
 #define MAC_SOURCE(p) p[6], p[7], p[8], p[9], p[10], p[11]
 
+#include "CPU.h"
 #include "Memory.h"
 #include "Log.h"
 
@@ -179,6 +187,184 @@ namespace
         writeData(socket, memory, data, len);
     }
 
+    // TCP has no header, so recv() straight into the RX ring (2 calls if it wraps)
+    ssize_t receiveStreamIntoRing(Socket &socket, std::vector<uint8_t> &memory, const size_t len)
+    {
+        size_t total = 0;
+        while (total < len)
+        {
+            const size_t contiguous = std::min<size_t>(len - total, socket.receiveSize - socket.sn_rx_wr);
+            uint8_t *dest = memory.data() + socket.receiveBase + socket.sn_rx_wr;
+            const ssize_t data = recv(socket.getFD(), reinterpret_cast<char *>(dest), (int)contiguous, 0);
+            if (data <= 0)
+            {
+                // report EOF or error next time (once the data already received has been consumed)
+                return total ? static_cast<ssize_t>(total) : data;
+            }
+
+            socket.sn_rx_wr = (socket.sn_rx_wr + data) % socket.receiveSize;
+            socket.sn_rx_rsr += static_cast<uint16_t>(data);
+            total += data;
+
+            if (static_cast<size_t>(data) < contiguous)
+                break;  // drained
+        }
+        return static_cast<ssize_t>(total);
+    }
+
+    // Readiness of all the Uthernet II host sockets in this process
+    // . a socket is only serviced (connect completion, recv) once the OS has reported it ready,
+    //   instead of a speculative syscall per socket on every update
+    // . level-triggered: epoll on Linux, poll() elsewhere, select() on Windows (WSAPoll() doesn't report a failed connect)
+    // . refreshed at most once per cycle, so all cards updated in the same execution period share the syscall
+    class SocketPoller
+    {
+    public:
+        enum { kReadable = 1, kWritable = 2, kError = 4 };
+
+        SocketPoller()
+            : myLastPollCycle(0)
+            , myHasPolled(false)
+        {
+#ifdef __linux__
+            myEpollFD = epoll_create1(EPOLL_CLOEXEC);   // if it fails, then fallback to poll()
+#endif
+        }
+
+        void setInterest(const Socket::socket_t fd, const unsigned interest)
+        {
+            myReady.erase(fd);
+            if (interest)
+                myInterest[fd] = interest;
+            else
+                myInterest.erase(fd);
+
+#ifdef __linux__
+            if (myEpollFD >= 0)
+            {
+                epoll_event event = {};
+                event.events = ((interest & kReadable) ? EPOLLIN : 0) | ((interest & kWritable) ? EPOLLOUT : 0);
+                event.data.fd = fd;
+                if (!interest)
+                    epoll_ctl(myEpollFD, EPOLL_CTL_DEL, fd, &event);
+                else if (epoll_ctl(myEpollFD, EPOLL_CTL_MOD, fd, &event) != 0 && errno == ENOENT)
+                    epoll_ctl(myEpollFD, EPOLL_CTL_ADD, fd, &event);
+            }
+#endif
+        }
+
+        void poll(const UINT64 cycle)
+        {
+            if (myHasPolled && cycle == myLastPollCycle)
+                return;
+
+            myHasPolled = true;
+            myLastPollCycle = cycle;
+            myReady.clear();
+
+            if (myInterest.empty())
+                return; // no sockets: no syscall
+
+#ifdef __linux__
+            if (myEpollFD >= 0)
+            {
+                epoll_event events[kMaxEvents];
+                const int num = epoll_wait(myEpollFD, events, kMaxEvents, 0);
+                for (int e = 0; e < num; ++e)
+                {
+                    const uint32_t revents = events[e].events;
+                    setReady(events[e].data.fd, (revents & EPOLLIN) != 0, (revents & EPOLLOUT) != 0, (revents & (EPOLLERR | EPOLLHUP)) != 0);
+                }
+                return;
+            }
+#endif
+
+#ifdef _WIN32
+            FD_SET readfds, writefds, exceptfds;
+            FD_ZERO(&readfds);
+            FD_ZERO(&writefds);
+            FD_ZERO(&exceptfds);
+            for (const auto &it : myInterest)
+            {
+                if (it.second & kReadable)
+                    FD_SET(it.first, &readfds);
+                if (it.second & kWritable)
+                {
+                    FD_SET(it.first, &writefds);
+                    FD_SET(it.first, &exceptfds);   // a failed connect
+                }
+            }
+
+            timeval timeout = {0, 0}; // non const for old versions of msys2 / mxe
+            if (select(0, &readfds, &writefds, &exceptfds, &timeout) > 0)
+            {
+                for (const auto &it : myInterest)
+                {
+                    setReady(it.first, FD_ISSET(it.first, &readfds) != 0, FD_ISSET(it.first, &writefds) != 0, FD_ISSET(it.first, &exceptfds) != 0);
+                }
+            }
+#else
+            myPollFDs.clear();
+            for (const auto &it : myInterest)
+            {
+                pollfd pfd = {};
+                pfd.fd = it.first;
+                pfd.events = ((it.second & kReadable) ? POLLIN : 0) | ((it.second & kWritable) ? POLLOUT : 0);
+                myPollFDs.push_back(pfd);
+            }
+
+            if (::poll(myPollFDs.data(), myPollFDs.size(), 0) > 0)
+            {
+                for (const pollfd &pfd : myPollFDs)
+                {
+                    setReady(pfd.fd, (pfd.revents & POLLIN) != 0, (pfd.revents & POLLOUT) != 0, (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
+                }
+            }
+#endif
+        }
+
+        unsigned getReady(const Socket::socket_t fd) const
+        {
+            const auto it = myReady.find(fd);
+            return it != myReady.end() ? it->second : 0;
+        }
+
+        void clearReady(const Socket::socket_t fd, const unsigned ready)
+        {
+            const auto it = myReady.find(fd);
+            if (it != myReady.end())
+                it->second &= ~ready;
+        }
+
+    private:
+        void setReady(const Socket::socket_t fd, const bool readable, const bool writable, const bool error)
+        {
+            const unsigned ready = (readable ? kReadable : 0) | (writable ? kWritable : 0) | (error ? kError : 0);
+            if (ready)
+                myReady[fd] = ready;
+        }
+
+        std::map<Socket::socket_t, unsigned> myInterest;
+        std::map<Socket::socket_t, unsigned> myReady;   // from the last poll()
+        UINT64 myLastPollCycle;
+        bool myHasPolled;
+
+#ifdef __linux__
+        static const int kMaxEvents = 64;
+        int myEpollFD;
+#endif
+#ifndef _WIN32
+        std::vector<pollfd> myPollFDs;
+#endif
+    };
+
+    SocketPoller &getSocketPoller()
+    {
+        // Never destroyed: a Socket can be closed by a card's dtor during static destruction
+        static SocketPoller *poller = new SocketPoller;
+        return *poller;
+    }
+
 }
 
 Socket::Socket()
@@ -199,6 +385,7 @@ void Socket::clearFD()
 {
     if (myFD != INVALID_SOCKET)
     {
+        getSocketPoller().setInterest(myFD, 0);
 #ifdef _WIN32
         closesocket(myFD);
 #else
@@ -231,6 +418,15 @@ void Socket::setStatus(const uint8_t status)
         myHeaderSize = 0;
         break;
     }
+
+    if (myFD != INVALID_SOCKET)
+    {
+        // only wait for what can happen in this state
+        const unsigned interest = (mySocketStatus == W5100_SN_SR_SOCK_SYNSENT) ? SocketPoller::kWritable
+            : isOpen() ? SocketPoller::kReadable
+            : 0;
+        getSocketPoller().setInterest(myFD, interest);
+    }
 }
 
 void Socket::setFD(const socket_t fd, const uint8_t status)
@@ -270,18 +466,7 @@ void Socket::process()
 {
     if (myFD != INVALID_SOCKET && mySocketStatus == W5100_SN_SR_SOCK_SYNSENT)
     {
-#ifdef _WIN32
-        FD_SET writefds, exceptfds;
-        FD_ZERO(&writefds);
-        FD_ZERO(&exceptfds);
-        FD_SET(myFD, &writefds);
-        FD_SET(myFD, &exceptfds);
-        timeval timeout = {0, 0}; // non const for old versions of msys2 / mxe
-        if (select(0, NULL, &writefds, &exceptfds, &timeout) > 0)
-#else
-        pollfd pfd = {.fd = myFD, .events = POLLOUT};
-        if (poll(&pfd, 1, 0) > 0)
-#endif
+        if (getSocketPoller().getReady(myFD) & (SocketPoller::kWritable | SocketPoller::kError))
         {
             int err = 0;
             socklen_t elen = sizeof(err);
@@ -291,14 +476,14 @@ void Socket::process()
             {
                 setStatus(W5100_SN_SR_ESTABLISHED);
 #ifdef U2_LOG_STATE
-                LogFileOutput("U2: TCP[]: Connected\n");
+                U2_LOG(LOG_LEVEL_INFO, "U2: TCP[]: Connected\n");
 #endif
             }
             else
             {
                 clearFD();
 #ifdef U2_LOG_STATE
-                LogFileOutput("U2: TCP[]: Connection error: %d - %" ERROR_FMT "\n", res, STRERROR(err));
+                U2_LOG(LOG_LEVEL_INFO, "U2: TCP[]: Connection error: %d - %" ERROR_FMT "\n", res, STRERROR(err));
 #endif
             }
         }
@@ -385,6 +570,7 @@ Uthernet2::Uthernet2(UINT slot) : Card(CT_Uthernet2, slot)
 
     myVirtualDNSEnabled = GetRegistryVirtualDNS(slot);
     Reset(true);
+    ScheduleUpdateNow();
 }
 
 Uthernet2::~Uthernet2()
@@ -405,35 +591,35 @@ void Uthernet2::setSocketModeRegister(const size_t i, const uint16_t address, co
     {
     case W5100_SN_MR_CLOSED:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Mode[%" SIZE_T_FMT "]: closed\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Mode[%" SIZE_T_FMT "]: closed\n", i);
 #endif
         break;
     case W5100_SN_MR_TCP:
     case W5100_SN_MR_TCP_DNS:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Mode[%" SIZE_T_FMT "]: TCP\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Mode[%" SIZE_T_FMT "]: TCP\n", i);
 #endif
         break;
     case W5100_SN_MR_UDP:
     case W5100_SN_MR_UDP_DNS:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Mode[%" SIZE_T_FMT "]: UDP\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Mode[%" SIZE_T_FMT "]: UDP\n", i);
 #endif
         break;
     case W5100_SN_MR_IPRAW:
     case W5100_SN_MR_IPRAW_DNS:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Mode[%" SIZE_T_FMT "]: IPRAW\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Mode[%" SIZE_T_FMT "]: IPRAW\n", i);
 #endif
         break;
     case W5100_SN_MR_MACRAW:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Mode[%" SIZE_T_FMT "]: MACRAW\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Mode[%" SIZE_T_FMT "]: MACRAW\n", i);
 #endif
         break;
 #ifdef U2_LOG_UNKNOWN
     default:
-        LogFileOutput("U2: Unknown protocol: %02x\n", protocol);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Unknown protocol: %02x\n", protocol);
 #endif
     }
 }
@@ -540,7 +726,7 @@ void Uthernet2::updateRSR(const size_t i)
 #ifdef U2_LOG_TRAFFIC
     if (socket.sn_rx_rsr != dataPresent)
     {
-        LogFileOutput("U2: Recv[%" SIZE_T_FMT "]: %d -> %d bytes\n", i, socket.sn_rx_rsr, dataPresent);
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Recv[%" SIZE_T_FMT "]: %d -> %d bytes\n", i, socket.sn_rx_rsr, dataPresent);
     }
 #endif
     socket.sn_rx_rsr = dataPresent;
@@ -666,7 +852,7 @@ void Uthernet2::receiveOnePacketMacRaw(const size_t i, const int size, uint8_t *
     {
         writeDataMacRaw(socket, myMemory, data, size);
 #ifdef U2_LOG_TRAFFIC
-        LogFileOutput("U2: Read MACRAW[%" SIZE_T_FMT "]: " MAC_FMT " -> " MAC_FMT ": +%d+%d -> %d bytes\n", i, MAC_SOURCE(data), MAC_DEST(data),
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Read MACRAW[%" SIZE_T_FMT "]: " MAC_FMT " -> " MAC_FMT ": +%d+%d -> %d bytes\n", i, MAC_SOURCE(data), MAC_DEST(data),
             socket.getHeaderSize(), size, socket.sn_rx_rsr);
 #endif
     }
@@ -674,7 +860,7 @@ void Uthernet2::receiveOnePacketMacRaw(const size_t i, const int size, uint8_t *
     {
         // drop it
 #ifdef U2_LOG_TRAFFIC
-        LogFileOutput("U2: Skip MACRAW[%" SIZE_T_FMT "]: %d bytes\n", i, size);
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Skip MACRAW[%" SIZE_T_FMT "]: %d bytes\n", i, size);
 #endif
     }
 }
@@ -687,7 +873,7 @@ void Uthernet2::receiveOnePacketIPRaw(const size_t i, const size_t lengthOfPaylo
     {
         writeDataIPRaw(socket, myMemory, payload, lengthOfPayload, source);
 #ifdef U2_LOG_TRAFFIC
-        LogFileOutput("U2: Read IPRAW[%" SIZE_T_FMT "]: +%d+%" SIZE_T_FMT " (%d) -> %d bytes\n", i, socket.getHeaderSize(),
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Read IPRAW[%" SIZE_T_FMT "]: +%d+%" SIZE_T_FMT " (%d) -> %d bytes\n", i, socket.getHeaderSize(),
             lengthOfPayload, len, socket.sn_rx_rsr);
 #endif
     }
@@ -695,7 +881,7 @@ void Uthernet2::receiveOnePacketIPRaw(const size_t i, const size_t lengthOfPaylo
     {
         // drop it
 #ifdef U2_LOG_TRAFFIC
-        LogFileOutput("U2: Skip IPRAW[%" SIZE_T_FMT "]: %" SIZE_T_FMT " (%d) bytes \n", i, lengthOfPayload, len);
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Skip IPRAW[%" SIZE_T_FMT "]: %" SIZE_T_FMT " (%d) bytes \n", i, lengthOfPayload, len);
 #endif
     }
 }
@@ -706,21 +892,37 @@ void Uthernet2::receiveOnePacketFromSocket(const size_t i)
     Socket &socket = mySockets[i];
     if (socket.isOpen())
     {
+        SocketPoller &poller = getSocketPoller();
+        if (!(poller.getReady(socket.getFD()) & (SocketPoller::kReadable | SocketPoller::kError)))
+            return; // nothing pending: avoid a speculative recv
+
         const uint16_t freeRoom = socket.getFreeRoom();
         if (freeRoom > 32) // avoid meaningless reads
         {
-            std::vector<uint8_t> buffer(freeRoom - 1); // do not fill the buffer completely
-            sockaddr_in source = {0};
-            socklen_t len = sizeof(sockaddr_in);
-            const ssize_t data = recvfrom(socket.getFD(), reinterpret_cast<char *>(buffer.data()), (int)buffer.size(), 0, (struct sockaddr *)&source, &len);
+            const size_t wanted = freeRoom - 1; // do not fill the buffer completely
+            ssize_t data;
+            if (socket.getStatus() == W5100_SN_SR_ESTABLISHED)
+            {
+                data = receiveStreamIntoRing(socket, myMemory, wanted);
+                if (data >= 0 && static_cast<size_t>(data) < wanted)
+                    poller.clearReady(socket.getFD(), SocketPoller::kReadable); // drained
+            }
+            else
+            {
+                myReceiveBuffer.resize(wanted);
+                sockaddr_in source = {0};
+                socklen_t len = sizeof(sockaddr_in);
+                data = recvfrom(socket.getFD(), reinterpret_cast<char *>(myReceiveBuffer.data()), (int)wanted, 0, (struct sockaddr *)&source, &len);
+                if (data > 0)
+                    writeDataForProtocol(socket, myMemory, myReceiveBuffer.data(), data, source);
+            }
 #ifdef U2_LOG_TRAFFIC
             const char *proto = socket.getStatus() == W5100_SN_SR_SOCK_UDP ? "UDP" : "TCP";
 #endif
             if (data > 0)
             {
-                writeDataForProtocol(socket, myMemory, buffer.data(), data, source);
 #ifdef U2_LOG_TRAFFIC
-                LogFileOutput("U2: Read %s[%" SIZE_T_FMT "]: +%d+%" SIZE_T_FMT " -> %d bytes\n", proto, i, socket.getHeaderSize(),
+                U2_LOG(LOG_LEVEL_TRACE, "U2: Read %s[%" SIZE_T_FMT "]: +%d+%" SIZE_T_FMT " -> %d bytes\n", proto, i, socket.getHeaderSize(),
                     data, socket.sn_rx_rsr);
 #endif
             }
@@ -732,10 +934,14 @@ void Uthernet2::receiveOnePacketFromSocket(const size_t i)
             else // data < 0;
             {
                 const int error = sock_error();
-                if (error != SOCK_EAGAIN && error != SOCK_EWOULDBLOCK)
+                if (error == SOCK_EAGAIN || error == SOCK_EWOULDBLOCK)
+                {
+                    poller.clearReady(socket.getFD(), SocketPoller::kReadable);
+                }
+                else
                 {
 #ifdef U2_LOG_TRAFFIC
-                    LogFileOutput("U2: %s[%" SIZE_T_FMT "]: recvfrom error %" ERROR_FMT "\n", proto, i, STRERROR(error));
+                    U2_LOG(LOG_LEVEL_TRACE, "U2: %s[%" SIZE_T_FMT "]: recvfrom error %" ERROR_FMT "\n", proto, i, STRERROR(error));
 #endif
                     socket.clearFD();
                 }
@@ -759,12 +965,12 @@ void Uthernet2::receiveOnePacket(const size_t i)
         break;
     case W5100_SN_SR_CLOSED:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Read[%" SIZE_T_FMT "]: reading from a closed socket\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Read[%" SIZE_T_FMT "]: reading from a closed socket\n", i);
 #endif
         break;
 #ifdef U2_LOG_UNKNOWN
     default:
-        LogFileOutput("U2: Read[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, socket.getStatus());
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Read[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, socket.getStatus());
 #endif
     };
 }
@@ -786,7 +992,7 @@ void Uthernet2::sendDataIPRaw(const size_t i, std::vector<uint8_t> &payload)
     std::vector<uint8_t> packet = createETH2Frame(payload, sourceMac, destinationMac, ttl, tos, protocol, source, dest);
 
 #ifdef U2_LOG_TRAFFIC
-    LogFileOutput("U2: Send IPRAW[%" SIZE_T_FMT "]: %" SIZE_T_FMT " (%" SIZE_T_FMT ") bytes\n", i, payload.size(), packet.size());
+    U2_LOG(LOG_LEVEL_TRACE, "U2: Send IPRAW[%" SIZE_T_FMT "]: %" SIZE_T_FMT " (%" SIZE_T_FMT ") bytes\n", i, payload.size(), packet.size());
 #endif
 
     myNetworkBackend->transmit((int)packet.size(), packet.data());
@@ -798,12 +1004,12 @@ void Uthernet2::sendDataMacRaw(const size_t i, std::vector<uint8_t> &packet) con
     if (packet.size() >= 12)
     {
         const uint8_t * data = packet.data();
-        LogFileOutput("U2: Send MACRAW[%" SIZE_T_FMT "]: " MAC_FMT " -> " MAC_FMT ": %" SIZE_T_FMT " bytes\n", i, MAC_SOURCE(data), MAC_DEST(data), packet.size());
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Send MACRAW[%" SIZE_T_FMT "]: " MAC_FMT " -> " MAC_FMT ": %" SIZE_T_FMT " bytes\n", i, MAC_SOURCE(data), MAC_DEST(data), packet.size());
     }
     else
     {
         // this is not a valid Ethernet Frame
-        LogFileOutput("U2: Send MACRAW[%" SIZE_T_FMT "]: XX:XX:XX:XX:XX:XX -> XX:XX:XX:XX:XX:XX: %" SIZE_T_FMT " bytes\n", i, packet.size());
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Send MACRAW[%" SIZE_T_FMT "]: XX:XX:XX:XX:XX:XX -> XX:XX:XX:XX:XX:XX: %" SIZE_T_FMT " bytes\n", i, packet.size());
     }
 #endif
     myNetworkBackend->transmit((int)packet.size(), packet.data());
@@ -825,7 +1031,7 @@ void Uthernet2::sendDataToSocket(const size_t i, std::vector<uint8_t> &data)
         const ssize_t res = sendto(socket.getFD(), reinterpret_cast<const char *>(data.data()), (int)data.size(), 0, (const struct sockaddr *)&destination, sizeof(destination));
 #ifdef U2_LOG_TRAFFIC
         const char *proto = socket.getStatus() == W5100_SN_SR_SOCK_UDP ? "UDP" : "TCP";
-        LogFileOutput("U2: Send %s[%" SIZE_T_FMT "]: %" SIZE_T_FMT " of %" SIZE_T_FMT " bytes\n", proto, i, res, data.size());
+        U2_LOG(LOG_LEVEL_TRACE, "U2: Send %s[%" SIZE_T_FMT "]: %" SIZE_T_FMT " of %" SIZE_T_FMT " bytes\n", proto, i, res, data.size());
 #endif
         if (res < 0)
         {
@@ -833,7 +1039,7 @@ void Uthernet2::sendDataToSocket(const size_t i, std::vector<uint8_t> &data)
             if (error != SOCK_EAGAIN && error != SOCK_EWOULDBLOCK)
             {
 #ifdef U2_LOG_TRAFFIC
-                LogFileOutput("U2: %s[%" SIZE_T_FMT "]: sendto error %" ERROR_FMT "\n", proto, i, STRERROR(error));
+                U2_LOG(LOG_LEVEL_TRACE, "U2: %s[%" SIZE_T_FMT "]: sendto error %" ERROR_FMT "\n", proto, i, STRERROR(error));
 #endif
                 socket.clearFD();
             }
@@ -884,12 +1090,12 @@ void Uthernet2::sendData(const size_t i)
         break;
     case W5100_SN_SR_CLOSED:
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Send[%" SIZE_T_FMT "]: sending to a closed socket\n", i);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Send[%" SIZE_T_FMT "]: sending to a closed socket\n", i);
 #endif
         break;
 #ifdef U2_LOG_UNKNOWN
     default:
-        LogFileOutput("U2: Send[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, socket.getStatus());
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Send[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, socket.getStatus());
 #endif
     }
 }
@@ -916,7 +1122,7 @@ void Uthernet2::openSystemSocket(const size_t i, const int type, const int proto
     {
 #ifdef U2_LOG_STATE
         const char *proto = (status == W5100_SN_SR_SOCK_UDP) ? "UDP" : "TCP";
-        LogFileOutput("U2: %s[%" SIZE_T_FMT "]: socket error: %" ERROR_FMT "\n", proto, i, STRERROR(sock_error()));
+        U2_LOG(LOG_LEVEL_INFO, "U2: %s[%" SIZE_T_FMT "]: socket error: %" ERROR_FMT "\n", proto, i, STRERROR(sock_error()));
 #endif
         s.clearFD();
     }
@@ -933,7 +1139,7 @@ void Uthernet2::openSystemSocket(const size_t i, const int type, const int proto
         {
 #ifdef U2_LOG_STATE
             const char *proto = (status == W5100_SN_SR_SOCK_UDP) ? "UDP" : "TCP";
-            LogFileOutput("U2: %s[%" SIZE_T_FMT "]: socket error: %" ERROR_FMT "\n", proto, i, STRERROR(sock_error()));
+            U2_LOG(LOG_LEVEL_INFO, "U2: %s[%" SIZE_T_FMT "]: socket error: %" ERROR_FMT "\n", proto, i, STRERROR(sock_error()));
 #endif
             s.clearFD();
         }
@@ -957,7 +1163,7 @@ void Uthernet2::openSocket(const size_t i)
     if (virtual_dns && !myVirtualDNSEnabled)
     {
 #ifdef U2_LOG_STATE
-        LogFileOutput("U2: Open[%" SIZE_T_FMT "]: virtual DNS not supported: %02x\n", i, mr);
+        U2_LOG(LOG_LEVEL_INFO, "U2: Open[%" SIZE_T_FMT "]: virtual DNS not supported: %02x\n", i, mr);
 #endif
         return;
     }
@@ -981,7 +1187,7 @@ void Uthernet2::openSocket(const size_t i)
         break;
 #ifdef U2_LOG_UNKNOWN
     default:
-        LogFileOutput("U2: Open[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, mr);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Open[%" SIZE_T_FMT "]: unknown mode: %02x\n", i, mr);
 #endif
     }
 
@@ -996,7 +1202,7 @@ void Uthernet2::openSocket(const size_t i)
 
     resetRXTXBuffers(i); // needed?
 #ifdef U2_LOG_STATE
-    LogFileOutput("U2: Open[%" SIZE_T_FMT "]: SR = %02x\n", i, socket.getStatus());
+    U2_LOG(LOG_LEVEL_INFO, "U2: Open[%" SIZE_T_FMT "]: SR = %02x\n", i, socket.getStatus());
 #endif
 }
 
@@ -1005,7 +1211,7 @@ void Uthernet2::closeSocket(const size_t i)
     Socket &socket = mySockets[i];
     socket.clearFD();
 #ifdef U2_LOG_STATE
-    LogFileOutput("U2: Close[%" SIZE_T_FMT "]\n", i);
+    U2_LOG(LOG_LEVEL_INFO, "U2: Close[%" SIZE_T_FMT "]\n", i);
 #endif
 }
 
@@ -1030,7 +1236,7 @@ void Uthernet2::resolveDNS(const size_t i)
             *dest = getHostByName(name);
             myDNSCache[name] = *dest;
 #ifdef U2_LOG_STATE
-            LogFileOutput("U2: DNS[%" SIZE_T_FMT "]: %s = %s\n", i, name.c_str(), formatIP(*dest));
+            U2_LOG(LOG_LEVEL_INFO, "U2: DNS[%" SIZE_T_FMT "]: %s = %s\n", i, name.c_str(), formatIP(*dest));
 #endif
         }
     }
@@ -1055,7 +1261,7 @@ void Uthernet2::connectSocket(const size_t i)
         socket.setStatus(W5100_SN_SR_ESTABLISHED);
 #ifdef U2_LOG_STATE
         const uint16_t port = readNetworkWord(myMemory.data() + socket.registerAddress + W5100_SN_DPORT0);
-        LogFileOutput("U2: TCP[%" SIZE_T_FMT "]: CONNECT to %s:%d\n", i, formatIP(dest), port);
+        U2_LOG(LOG_LEVEL_INFO, "U2: TCP[%" SIZE_T_FMT "]: CONNECT to %s:%d\n", i, formatIP(dest), port);
 #endif
     }
     else
@@ -1068,7 +1274,7 @@ void Uthernet2::connectSocket(const size_t i)
         else
         {
 #ifdef U2_LOG_STATE
-            LogFileOutput("U2: TCP[%" SIZE_T_FMT "]: connect error: %" ERROR_FMT "\n", i, STRERROR(error));
+            U2_LOG(LOG_LEVEL_INFO, "U2: TCP[%" SIZE_T_FMT "]: connect error: %" ERROR_FMT "\n", i, STRERROR(error));
 #endif
         }
     }
@@ -1096,7 +1302,7 @@ void Uthernet2::setCommandRegister(const size_t i, const uint8_t value)
         break;
 #ifdef U2_LOG_UNKNOWN
     default:
-        LogFileOutput("U2: Unknown command[%" SIZE_T_FMT "]: %02x\n", i, value);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Unknown command[%" SIZE_T_FMT "]: %02x\n", i, value);
 #endif
     }
 }
@@ -1143,7 +1349,7 @@ uint8_t Uthernet2::readSocketRegister(const uint16_t address)
         break;
     default:
 #ifdef U2_LOG_UNKNOWN
-        LogFileOutput("U2: Get unknown socket register[%d]: %04x\n", i, address);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Get unknown socket register[%d]: %04x\n", i, address);
 #endif
         value = myMemory[address];
         break;
@@ -1173,7 +1379,7 @@ uint8_t Uthernet2::readValueAt(const uint16_t address)
     else
     {
 #ifdef U2_LOG_UNKNOWN
-        LogFileOutput("U2: Read unknown location: %04x\n", address);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Read unknown location: %04x\n", address);
 #endif
         // this might not be 100% correct if address >= 0x8000
         // see top of page 13 Uthernet II
@@ -1210,7 +1416,7 @@ void Uthernet2::setIPProtocol(const size_t i, const uint16_t address, const uint
 {
     myMemory[address] = value;
 #ifdef U2_LOG_STATE
-    LogFileOutput("U2: IP PROTO[%" SIZE_T_FMT "] = %d\n", i, value);
+    U2_LOG(LOG_LEVEL_INFO, "U2: IP PROTO[%" SIZE_T_FMT "] = %d\n", i, value);
 #endif
 }
 
@@ -1218,7 +1424,7 @@ void Uthernet2::setIPTypeOfService(const size_t i, const uint16_t address, const
 {
     myMemory[address] = value;
 #ifdef U2_LOG_STATE
-    LogFileOutput("U2: IP TOS[%" SIZE_T_FMT "] = %d\n", i, value);
+    U2_LOG(LOG_LEVEL_INFO, "U2: IP TOS[%" SIZE_T_FMT "] = %d\n", i, value);
 #endif
 }
 
@@ -1226,7 +1432,7 @@ void Uthernet2::setIPTTL(const size_t i, const uint16_t address, const uint8_t v
 {
     myMemory[address] = value;
 #ifdef U2_LOG_STATE
-    LogFileOutput("U2: IP TTL[%" SIZE_T_FMT "] = %d\n", i, value);
+    U2_LOG(LOG_LEVEL_INFO, "U2: IP TTL[%" SIZE_T_FMT "] = %d\n", i, value);
 #endif
 }
 
@@ -1283,7 +1489,7 @@ void Uthernet2::writeSocketRegister(const uint16_t address, const uint8_t value)
         else
         {
 #ifdef U2_LOG_UNKNOWN
-            LogFileOutput("U2: Set unknown socket register[%d]: %04x\n", i, address);
+            U2_LOG(LOG_LEVEL_WARNING, "U2: Set unknown socket register[%d]: %04x\n", i, address);
 #endif
         }
         break;
@@ -1326,7 +1532,7 @@ void Uthernet2::writeCommonRegister(const uint16_t address, const uint8_t value)
 #ifdef U2_LOG_UNKNOWN
     else
     {
-        LogFileOutput("U2: Set unknown common register: %04x\n", address);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Set unknown common register: %04x\n", address);
     }
 #endif
 }
@@ -1348,7 +1554,7 @@ void Uthernet2::writeValueAt(const uint16_t address, const uint8_t value)
 #ifdef U2_LOG_UNKNOWN
     else
     {
-        LogFileOutput("U2: Write to unknown location: %02x to %04x\n", value, address);
+        U2_LOG(LOG_LEVEL_WARNING, "U2: Write to unknown location: %02x to %04x\n", value, address);
     }
 #endif
 }
@@ -1458,7 +1664,7 @@ BYTE Uthernet2::IO_C0(WORD programcounter, WORD address, BYTE write, BYTE value,
 #ifdef U2_LOG_VERBOSE
     const char *mode = write ? "WRITE" : "READ ";
     const char c = std::isprint(res) ? res : '.';
-    LogFileOutput("U2: %04x: %s %04x[%04x] %02x -> %02x, '%c' (%d -> %d)\n", programcounter, mode, address, oldAddress, value, res, c, value, res);
+    U2_LOG(LOG_LEVEL_DEBUG, "U2: %04x: %s %04x[%04x] %02x -> %02x, '%c' (%d -> %d)\n", programcounter, mode, address, oldAddress, value, res, c, value, res);
 #endif
 
     return res;
@@ -1527,10 +1733,14 @@ void Uthernet2::getMACAddress(const uint32_t address, const MACAddress * & mac)
 void Uthernet2::Update(const ULONG nExecutedCycles)
 {
     myNetworkBackend->update(nExecutedCycles);
-    for (Socket &socket : mySockets)
+
+    getSocketPoller().poll(g_nCumulativeCycles);
+    for (size_t i = 0; i < mySockets.size(); ++i)
     {
-        socket.process();
+        mySockets[i].process();
+        receiveOnePacketFromSocket(i);  // only recv's if ready
     }
+    ScheduleUpdateIn(kNetworkPollCycles);
 }
 
 // Unit version history:
@@ -83,6 +83,8 @@ public:
     static bool GetRegistryVirtualDNS(UINT slot);
 
 private:
+    static const ULONG kNetworkPollCycles = 1000; // Update() period
+
     bool myVirtualDNSEnabled; // extended virtualisation of DNS (not present in the real U II card)
 
 #ifdef _WIN32
@@ -91,6 +93,7 @@ private:
 
     std::vector<uint8_t> myMemory;
     std::vector<Socket> mySockets;
+    std::vector<uint8_t> myReceiveBuffer;   // UDP datagram (before its header is added)
     uint8_t myModeRegister;
     uint16_t myDataAddress;
     std::shared_ptr<NetworkBackend> myNetworkBackend;
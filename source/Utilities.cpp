@@ -43,6 +43,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Keyboard.h"
 #include "Interface.h"
 #include "SoundCore.h"
+#include "Tape.h"
 #include "CopyProtectionDongles.h"
 
 #include "Configuration/IPropertySheet.h"
@@ -552,6 +553,7 @@ void ResetMachineState()
 	KeybReset();
 	JoyReset();
 	SpkrReset();
+	TapeStop();
 	SetActiveCpu(GetMainCpu());
 #ifdef USE_SPEECH_API
 	g_Speech.Reset();
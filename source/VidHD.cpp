@@ -127,48 +127,71 @@ bgra_t ConvertIIgs2RGB(Color color)
 	return rgb;
 }
 
-void VidHDCard::UpdateSHRCell(bool is640Mode, bool isColorFillMode, uint16_t addrPalette, bgra_t* pVideoAddress, uint32_t a)
+void VidHDCard::ResolveSHRScanline(UINT line, SHRScanline& scanline)
 {
-	_ASSERT(!is640Mode);		// to do: test this mode
+	BYTE c = *MemGetAuxPtr(0x9D00 + line);	// scan-line control byte
 
-	Color* palette = (Color*) MemGetAuxPtr(addrPalette);
+	scanline.is640Mode = !!(c & 0x80);
+	scanline.isColorFillMode = !!(c & 0x20);
 
-	for (UINT i = 0; i < 4; i++)
+	const UINT paletteSelectCode = c & 0xf;
+	const UINT kColorsPerPalette = 16;
+	const UINT kColorSize = 2;
+	Color* palette = (Color*) MemGetAuxPtr(0x9E00 + paletteSelectCode * kColorsPerPalette * kColorSize);
+
+	for (UINT i = 0; i < kColorsPerPalette; i++)
+	{
+		scanline.palette[i] = ConvertIIgs2RGB(palette[i]);
+
+		const uint32_t color = *(uint32_t*)&scanline.palette[i];
+		scanline.paletteDoubled[i] = ((uint64_t)color << 32) | color;
+	}
+}
+
+void VidHDCard::UpdateSHRCell(const SHRScanline& scanline, bgra_t* pVideoAddress, uint32_t a)
+{
+	_ASSERT(!scanline.is640Mode);		// to do: test this mode
+
+	const bgra_t* palette = scanline.palette;
+
+	if (!scanline.is640Mode) // 320 mode
 	{
-		if (!is640Mode) // 320 mode
+		if (!scanline.isColorFillMode)
+		{
+			// Each byte is 2 pixels, each drawn 2 framebuffer pixels wide
+			uint64_t* pDst = (uint64_t*) pVideoAddress;
+			for (UINT i = 0; i < 4; i++, a >>= 8)
+			{
+				*pDst++ = scanline.paletteDoubled[(a >> 4) & 0xf];
+				*pDst++ = scanline.paletteDoubled[a & 0xf];
+			}
+			return;
+		}
+
+		for (UINT i = 0; i < 4; i++, a >>= 8)
 		{
 			BYTE pixel1 = (a >> 4) & 0xf;
-			bgra_t color1 = ConvertIIgs2RGB(palette[pixel1]);
-			if (isColorFillMode && pixel1 == 0) color1 = *(pVideoAddress - 1);
+			bgra_t color1 = palette[pixel1];
+			if (pixel1 == 0) color1 = *(pVideoAddress - 1);
 			*pVideoAddress++ = color1;
 			*pVideoAddress++ = color1;
 
 			BYTE pixel2 = a & 0xf;
-			bgra_t color2 = ConvertIIgs2RGB(palette[pixel2]);
-			if (isColorFillMode && pixel2 == 0) color2 = color1;
+			bgra_t color2 = palette[pixel2];
+			if (pixel2 == 0) color2 = color1;
 			*pVideoAddress++ = color2;
 			*pVideoAddress++ = color2;
 		}
-		else // 640 mode - see IIgs Hardware Ref, Pg.96, Table4-21 'Color Selection in 640 mode'
+	}
+	else // 640 mode - see IIgs Hardware Ref, Pg.96, Table4-21 'Color Selection in 640 mode'
+	{
+		for (UINT i = 0; i < 4; i++, a >>= 8)
 		{
-			BYTE pixel1 = (a >> 6) & 0x3;
-			bgra_t color1 = ConvertIIgs2RGB(palette[0x8 + pixel1]);
-			*pVideoAddress++ = color1;
-
-			BYTE pixel2 = (a >> 4) & 0x3;
-			bgra_t color2 = ConvertIIgs2RGB(palette[0xC + pixel2]);
-			*pVideoAddress++ = color2;
-
-			BYTE pixel3 = (a >> 2) & 0x3;
-			bgra_t color3 = ConvertIIgs2RGB(palette[0x0 + pixel3]);
-			*pVideoAddress++ = color3;
-
-			BYTE pixel4 = a & 0x3;
-			bgra_t color4 = ConvertIIgs2RGB(palette[0x4 + pixel4]);
-			*pVideoAddress++ = color4;
+			*pVideoAddress++ = palette[0x8 + ((a >> 6) & 0x3)];
+			*pVideoAddress++ = palette[0xC + ((a >> 4) & 0x3)];
+			*pVideoAddress++ = palette[0x0 + ((a >> 2) & 0x3)];
+			*pVideoAddress++ = palette[0x4 + (a & 0x3)];
 		}
-
-		a >>= 8;
 	}
 }
 
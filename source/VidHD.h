@@ -27,6 +27,11 @@ public:
 
 	virtual void Destroy() {}
 	virtual void Reset(const bool powerCycle);
+	virtual void InitializeForLoadingSnapshot()
+	{
+		Reset(false);
+		GetVideo().SetVidHD(true);	// Snapshot_LoadState() clears this, as if the card was about to be re-inserted
+	}
 	virtual void Update(const ULONG nExecutedCycles) {}
 	virtual void InitializeIO(LPBYTE pCxRomPeripheral);
 
@@ -38,7 +43,19 @@ public:
 	bool IsDHGRBlackAndWhite() const { return !!(m_NEWVIDEO & (1 << 5)); }
 	bool IsWriteAux() const;
 
-	static void UpdateSHRCell(bool is640Mode, bool isColorFillMode, uint16_t addrPalette, bgra_t* pVideoAddress, uint32_t a);
+
+	// A scan-line's control byte & palette, resolved once per scan-line
+	// (cf. the IIgs VGC, which fetches these during horizontal blanking)
+	struct SHRScanline
+	{
+		bool is640Mode;
+		bool isColorFillMode;
+		bgra_t palette[16];
+		uint64_t paletteDoubled[16];	// 320 mode: each pixel is 2 framebuffer pixels wide
+	};
+
+	static void ResolveSHRScanline(UINT line, SHRScanline& scanline);
+	static void UpdateSHRCell(const SHRScanline& scanline, bgra_t* pVideoAddress, uint32_t a);
 
 	static const std::string& GetSnapshotCardName();
 	virtual void SaveSnapshot(YamlSaveHelper& yamlSaveHelper);
@@ -34,6 +34,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Utilities.h"
 #include "CmdLine.h"
 #include "Debug.h"
+#include "DiskImageIndexer.h"
 #include "Keyboard.h"
 #include "Log.h"
 #include "Memory.h"
@@ -42,6 +43,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "ParallelPrinter.h"
 #include "Registry.h"
 #include "Riff.h"
+#include "Capture.h"
+#include "Tape.h"
+#include "Tfe/LoopbackBackend.h"
+#include "Tfe/PCapBackend.h"
 #include "SaveState.h"
 #include "SerialComms.h"
 #include "Speaker.h"
@@ -265,6 +270,8 @@ static void ContinueExecution()
 			GetFrame().VideoRedrawScreenDuringFullSpeed(g_dwCyclesThisFrame);
 		else
 			GetFrame().VideoPresentScreen(); // Just copy the output of our Apple framebuffer to the system Back Buffer
+
+		Capture_PutVideoFrame();
 	}
 
 #ifdef LOG_PERF_TIMINGS
@@ -510,6 +517,7 @@ static void ExceptionHandler(const char* pError)
 				MB_ICONEXCLAMATION | MB_SETFOREGROUND);
 
 	LogFileOutput("Runtime Exception: %s\n", pError);
+	LogFlush();
 }
 
 //---------------------------------------------------------------------------
@@ -529,6 +537,9 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 	if (!ProcessCmdLine(lpCmdLine))
 		return 0;
 
+	if (!g_cmdLine.indexImagesDir.empty())	// batch mode: no emulator or UI
+		return DiskImageIndexer_Run(g_cmdLine.indexImagesDir, g_cmdLine.indexImagesFilename) ? 0 : 1;
+
 	LogFileOutput("g_sStartDir = %s\n", g_sStartDir.c_str());
 	GetAppleWinVersion();
 	OneTimeInitialization(passinstance);
@@ -559,6 +570,8 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 					LogFileOutput("Main: CMouseInterface::dtor\n");
 				}
 
+				TapeStop();	// removes event from g_SynchronousEventMgr (resumes on the next read of TAPEIN)
+
 				_ASSERT(g_SynchronousEventMgr.GetHead() == NULL);
 				g_SynchronousEventMgr.Reset();
 			}
@@ -637,6 +650,30 @@ static void OneTimeInitialization(HINSTANCE passinstance)
 			GetCardMgr().GetMockingboardCardMgr().OutputToRiff();
 	}
 
+	// Tape persists across a restart
+	if (!g_cmdLine.tapeInFilename.empty())
+	{
+		bool res = TapeInsert(g_cmdLine.tapeInFilename);
+		LogFileOutput("Init: TapeInsert(), res=%d\n", res ? 1 : 0);
+		TapeSetFastLoad(g_cmdLine.tapeFastLoad);
+	}
+
+	if (!g_cmdLine.tapeOutFilename.empty())
+	{
+		bool res = TapeOutputStart(g_cmdLine.tapeOutFilename);
+		LogFileOutput("Init: TapeOutputStart(), res=%d\n", res ? 1 : 0);
+	}
+
+	if (!g_cmdLine.loopbackCaptureFilename.empty())
+		LoopbackBackend::SetCaptureFilename(g_cmdLine.loopbackCaptureFilename);
+
+	// Use lock-free ring buffers (and a null or wav-file backend) instead of DirectSound
+	if (g_cmdLine.audioRingBackend != AUDIO_RING_NONE)
+	{
+		bool res = AudioRing_Init(g_cmdLine.audioRingBackend, g_cmdLine.audioRingWavFile);
+		LogFileOutput("Init: AudioRing_Init(), res=%d\n", res ? 1 : 0);
+	}
+
 	// Initialize COM - so we can use CoCreateInstance
 	// . DSInit() & DIMouse::DirectInputInit are done when g_hFrameWindow is created (WM_CREATE)
 	// . DDInit() is done in RepeatInitialization() by GetVideo().Initialize()
@@ -770,6 +807,14 @@ static void RepeatInitialization()
 		GetCardMgr().GetParallelPrinterCard()->SetEnableDumpToRealPrinter(true);
 	}
 
+	if (GetCardMgr().IsParallelPrinterCardInstalled())
+	{
+		ParallelPrinterCard* pPrinterCard = GetCardMgr().GetParallelPrinterCard();
+		pPrinterCard->SetFlush(g_cmdLine.printerFlush);
+		pPrinterCard->SetPerJobFiles(g_cmdLine.printerPerJobFiles);
+		pPrinterCard->SetConvert(g_cmdLine.printerConvert);
+	}
+
 	for (UINT i = SLOT1; i < NUM_SLOTS; i++)
 	{
 		if (GetCardMgr().QuerySlot(i) == CT_Disk2 && g_cmdLine.slotInfo[i].isDiskII13)
@@ -811,6 +856,15 @@ static void RepeatInitialization()
 			if (type != SSI263Unknown)
 				dynamic_cast<MockingboardCard&>(GetCardMgr().GetRef(i)).SetSocketSC01(type);
 		}
+		else if (GetCardMgr().QuerySlot(i) == CT_Uthernet || GetCardMgr().QuerySlot(i) == CT_Uthernet2)
+		{
+			// NB. the card's network backend is (re)created by MemInitialize() -> InitializeIO()
+			if (!g_cmdLine.slotInfo[i].networkInterface.empty())
+			{
+				PCapBackend::SetRegistryInterface(i, g_cmdLine.slotInfo[i].networkInterface);
+				g_cmdLine.slotInfo[i].networkInterface.clear();	// Don't reapply after a restart
+			}
+		}
 	}
 
 	// Aux slot
@@ -983,6 +1037,13 @@ static void RepeatInitialization()
 		LogFileOutput("Main: Snapshot_Startup()\n");
 	}
 
+	if (!g_cmdLine.captureFilePrefix.empty())
+	{
+		bool res = Capture_Start(g_cmdLine.captureFilePrefix);
+		LogFileOutput("Main: Capture_Start(), res=%d\n", res ? 1 : 0);
+		g_cmdLine.captureFilePrefix.clear();	// Keep capturing across a restart
+	}
+
 	if (g_cmdLine.szScreenshotFilename)
 	{
 		GetFrame().Video_RedrawAndTakeScreenShot(g_cmdLine.szScreenshotFilename);
@@ -1021,6 +1082,15 @@ static void Shutdown()
 	CoUninitialize();
 	LogFileOutput("Exit: CoUninitialize()\n");
 
+	Capture_Stop();
+	LogFileOutput("Exit: Capture_Stop()\n");
+
+	TapeOutputStop();
+	LogFileOutput("Exit: TapeOutputStop()\n");
+
+	AudioRing_Uninit();
+	LogFileOutput("Exit: AudioRing_Uninit()\n");
+
 	LogDone();
 
 	RiffFinishWriteFile();
@@ -30,9 +30,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "DXSoundBuffer.h"
 
-#include "Core.h" // for g_fh
+#include "Core.h" // for LogFileOutput()
 #include "Interface.h"
 #include "SoundCore.h"
+#include "AudioRing.h"
 
 //-----------------------------------------------------------------------------
 
@@ -149,7 +150,7 @@ HRESULT DXSoundBuffer::Restore()
 
 bool DSAvailable()
 {
-	return g_bDSAvailable;
+	return g_bDSAvailable || AudioRing_IsEnabled();
 }
 
 static BOOL CALLBACK DSEnumProc(LPGUID lpGUID, LPCTSTR lpszDesc, LPCTSTR lpszDrvName, LPVOID lpContext)
@@ -163,7 +164,7 @@ static BOOL CALLBACK DSEnumProc(LPGUID lpGUID, LPCTSTR lpszDesc, LPCTSTR lpszDrv
 		memset(&sound_device_guid[i], 0, sizeof(GUID));
 	sound_devices[i] = lpszDesc;
 
-	if (g_fh) fprintf(g_fh, "%d: %s - %s\n", i, lpszDesc, lpszDrvName);
+	LogFileOutput("%d: %s - %s\n", i, lpszDesc, lpszDrvName);
 
 	num_sound_devices++;
 	return TRUE;
@@ -181,14 +182,11 @@ bool DSInit()
 	HRESULT hr = DirectSoundEnumerate((LPDSENUMCALLBACK)DSEnumProc, NULL);
 	if (FAILED(hr))
 	{
-		if (g_fh) fprintf(g_fh, "DSEnumerate failed (%08X)\n", (uint32_t)hr);
+		LogFileOutput("DSEnumerate failed (%08X)\n", (uint32_t)hr);
 		return false;
 	}
 
-	if (g_fh)
-	{
-		fprintf(g_fh, "Number of sound devices = %d\n", num_sound_devices);
-	}
+	LogFileOutput("Number of sound devices = %d\n", num_sound_devices);
 
 	bool bCreatedOK = false;
 	for (int x = 0; x < num_sound_devices; x++)
@@ -196,16 +194,16 @@ bool DSInit()
 		hr = DirectSoundCreate(&sound_device_guid[x], &g_lpDS, NULL);
 		if (SUCCEEDED(hr))
 		{
-			if (g_fh) fprintf(g_fh, "DSCreate succeeded for sound device #%d\n", x);
+			LogFileOutput("DSCreate succeeded for sound device #%d\n", x);
 			bCreatedOK = true;
 			break;
 		}
 
-		if (g_fh) fprintf(g_fh, "DSCreate failed for sound device #%d (%08X)\n", x, (uint32_t)hr);
+		LogFileOutput("DSCreate failed for sound device #%d (%08X)\n", x, (uint32_t)hr);
 	}
 	if (!bCreatedOK)
 	{
-		if (g_fh) fprintf(g_fh, "DSCreate failed for all sound devices\n");
+		LogFileOutput("DSCreate failed for all sound devices\n");
 		return false;
 	}
 
@@ -214,7 +212,7 @@ bool DSInit()
 	hr = g_lpDS->SetCooperativeLevel(hwnd, DSSCL_NORMAL);
 	if (FAILED(hr))
 	{
-		if (g_fh) fprintf(g_fh, "SetCooperativeLevel failed (%08X)\n", (uint32_t)hr);
+		LogFileOutput("SetCooperativeLevel failed (%08X)\n", (uint32_t)hr);
 		return false;
 	}
 
@@ -224,7 +222,7 @@ bool DSInit()
 	hr = g_lpDS->GetCaps(&DSCaps);
 	if (FAILED(hr))
 	{
-		if (g_fh) fprintf(g_fh, "GetCaps failed (%08X)\n", (uint32_t)hr);
+		LogFileOutput("GetCaps failed (%08X)\n", (uint32_t)hr);
 		// Not fatal: so continue...
 	}
 
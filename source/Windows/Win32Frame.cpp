@@ -10,7 +10,9 @@
 #include "CardManager.h"
 #include "Debugger/Debug.h"
 #include "Tfe/PCapBackend.h"
+#include "Tfe/LoopbackBackend.h"
 #include "DXSoundBuffer.h"
+#include "AudioRing.h"
 #include "../resource/resource.h"
 
 // Win32Frame methods are implemented in AppleWin, WinFrame and WinVideo.
@@ -385,7 +387,7 @@ void Win32Frame::Benchmark()
 			while (cycles > 0) {
 				uint32_t executedcycles = CpuExecute(103, true);
 				cycles -= executedcycles;
-				GetCardMgr().GetDisk2CardMgr().Update(executedcycles);
+				GetCardMgr().GetDisk2CardMgr().Update();
 			}
 		}
 		if (cycle & 1)
@@ -567,7 +569,7 @@ BOOL CALLBACK Win32Frame::DDEnumProc(LPGUID lpGUID, LPCTSTR lpszDesc, LPCTSTR lp
 		memcpy(&(obj->draw_device_guid[i]), lpGUID, sizeof(GUID));
 	obj->draw_devices[i] = _strdup(lpszDesc);
 
-	if (g_fh) fprintf(g_fh, "%d: %s - %s\n", i, lpszDesc, lpszDrvName);
+	LogFileOutput("%d: %s - %s\n", i, lpszDesc, lpszDrvName);
 
 	(obj->num_draw_devices)++;
 	return TRUE;
@@ -700,11 +702,17 @@ std::string Win32Frame::Video_GetScreenShotFolder() const
 
 std::shared_ptr<NetworkBackend> Win32Frame::CreateNetworkBackend(const std::string & interfaceName)
 {
+	if (LoopbackBackend::IsLoopbackInterface(interfaceName))
+		return std::make_shared<LoopbackBackend>(interfaceName);
+
 	std::shared_ptr<NetworkBackend> backend(new PCapBackend(interfaceName));
 	return backend;
 }
 
 std::shared_ptr<SoundBuffer> Win32Frame::CreateSoundBuffer(uint32_t dwBufferSize, uint32_t nSampleRate, int nChannels, const char* pszVoiceName)
 {
+	if (AudioRing_IsEnabled())
+		return AudioRing_CreateSoundBuffer(dwBufferSize, nSampleRate, nChannels, pszVoiceName);
+
 	return DXSoundBuffer::create(dwBufferSize, nSampleRate, nChannels);
 }
@@ -24,12 +24,23 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "StdAfx.h"
 
 #include "YamlHelper.h"
+#include "Common.h"
 #include "Log.h"
 
 #include <sstream>
 
-int YamlHelper::InitParser(const char* pPathname)
+int YamlHelper::InitParser(const char* pPathname, const bool bCache/*=false*/)
 {
+	if (bCache)
+	{
+		ClearCache();
+		if (GetFileSizeAndLastWriteTime(pPathname, m_cacheFileSize, m_cacheFileTime))
+		{
+			m_cachePathname = pPathname;
+			m_recording = true;
+		}
+	}
+
 	m_hFile = fopen(pPathname, "r");
 	if (m_hFile == NULL)
 	{
@@ -47,8 +58,29 @@ int YamlHelper::InitParser(const char* pPathname)
 	return 1;
 }
 
+bool YamlHelper::InitReplay(const char* pPathname)
+{
+	if (!m_cacheComplete || m_cachePathname != pPathname)
+		return false;
+
+	UINT64 size, time;
+	if (!GetFileSizeAndLastWriteTime(pPathname, size, time) || size != m_cacheFileSize || time != m_cacheFileTime)
+	{
+		ClearCache();	// file has changed
+		return false;
+	}
+
+	m_replaying = true;
+	m_replayIdx = 0;
+	return true;
+}
+
 void YamlHelper::FinaliseParser()
 {
+	m_recording = false;
+	m_replaying = false;
+	m_recordingSubMaps.clear();
+
 	if (m_hFile)
 		fclose(m_hFile);
 
@@ -58,6 +90,17 @@ void YamlHelper::FinaliseParser()
 	yaml_parser_delete(&m_parser);
 }
 
+void YamlHelper::ClearCache()
+{
+	for (size_t i = 0; i < m_cache.size(); i++)
+		FreeMap(m_cache[i].mapYaml);
+
+	m_cache.clear();
+	m_recordingSubMaps.clear();
+	m_cacheComplete = false;
+	m_cachePathname.clear();
+}
+
 UINT YamlHelper::ParseFileHdr(const char* tag)
 {
 	std::string scalar;
@@ -101,6 +144,15 @@ void YamlHelper::GetNextEvent()
 
 int YamlHelper::GetScalar(std::string& scalar)
 {
+	if (m_replaying)
+	{
+		if (m_replayIdx == m_cache.size())
+			return 0;
+
+		scalar = m_scalarName = m_cache[m_replayIdx++].scalarName;
+		return 1;
+	}
+
 	int res = 1;
 	bool bDone = false;
 
@@ -130,11 +182,17 @@ int YamlHelper::GetScalar(std::string& scalar)
 		}
 	}
 
+	if (!res && m_recording)
+		m_cacheComplete = true;	// parsed the whole file
+
 	return res;
 }
 
 void YamlHelper::GetMapStartEvent()
 {
+	if (m_replaying)
+		return;
+
 	GetNextEvent();
 
 	if (m_newEvent.type != YAML_MAPPING_START_EVENT)
@@ -144,6 +202,31 @@ void YamlHelper::GetMapStartEvent()
 	}
 }
 
+int YamlHelper::GetTopLevelMap(MapYaml& mapYaml)
+{
+	if (m_replaying)
+	{
+		_ASSERT(m_replayIdx > 0);
+		mapYaml.clear();
+		CopyMap(mapYaml, m_cache[m_replayIdx - 1].mapYaml);
+		m_replayMemoryIdx = 0;
+		return 1;
+	}
+
+	int res = ParseMap(mapYaml);
+
+	if (res && m_recording)
+	{
+		m_cache.push_back(CachedMap());
+		m_cache.back().scalarName = m_scalarName;
+		m_recordingSubMaps.clear();
+		m_recordingSubMaps[&mapYaml] = &m_cache.back().mapYaml;
+		CopyMap(m_cache.back().mapYaml, mapYaml, &m_recordingSubMaps);
+	}
+
+	return res;
+}
+
 int YamlHelper::ParseMap(MapYaml& mapYaml)
 {
 	mapYaml.clear();
@@ -256,6 +339,40 @@ void YamlHelper::GetMapRemainder(std::string& mapName, MapYaml& mapYaml)
 	mapYaml.clear();
 }
 
+void YamlHelper::CopyMap(MapYaml& dstMapYaml, const MapYaml& srcMapYaml, SubMapCopies* pSubMapCopies/*=NULL*/)
+{
+	for (MapYaml::const_iterator iter = srcMapYaml.begin(); iter != srcMapYaml.end(); ++iter)
+	{
+		MapValue mapValue;
+		mapValue.value = iter->second.value;
+		mapValue.subMap = NULL;
+
+		if (iter->second.subMap)
+		{
+			mapValue.subMap = new MapYaml;
+			CopyMap(*mapValue.subMap, *iter->second.subMap, pSubMapCopies);
+			if (pSubMapCopies)
+				(*pSubMapCopies)[iter->second.subMap] = mapValue.subMap;
+		}
+
+		dstMapYaml.insert(dstMapYaml.end(), MapYaml::value_type(iter->first, mapValue));	// NB. src is already sorted
+	}
+}
+
+void YamlHelper::FreeMap(MapYaml& mapYaml)
+{
+	for (MapYaml::iterator iter = mapYaml.begin(); iter != mapYaml.end(); ++iter)
+	{
+		if (iter->second.subMap)
+		{
+			FreeMap(*iter->second.subMap);
+			delete iter->second.subMap;
+		}
+	}
+
+	mapYaml.clear();
+}
+
 //
 
 void YamlHelper::MakeAsciiToHexTable()
@@ -274,6 +391,43 @@ void YamlHelper::MakeAsciiToHexTable()
 
 UINT YamlHelper::LoadMemory(MapYaml& mapYaml, const LPBYTE pMemBase, const size_t kAddrSpaceSize, const UINT offset)
 {
+	if (m_replaying)
+	{
+		// Replay the memory that was decoded when the file was parsed (NB. loading is deterministic, so the order is the same)
+		const CachedMap& cachedMap = m_cache[m_replayIdx - 1];
+		if (m_replayMemoryIdx >= cachedMap.memory.size())
+			throw std::runtime_error("Memory: not in the cache");
+
+		const CachedMemory& cachedMemory = cachedMap.memory[m_replayMemoryIdx++];
+		if (cachedMemory.addrSpaceSize != kAddrSpaceSize || cachedMemory.offset != offset)
+			throw std::runtime_error("Memory: doesn't match the cache");
+
+		for (size_t i = 0; i < cachedMemory.runs.size(); i++)
+			memcpy(pMemBase + cachedMemory.runs[i].addr, &cachedMemory.runs[i].data[0], cachedMemory.runs[i].data.size());
+
+		mapYaml.clear();
+		return cachedMemory.bytes;
+	}
+
+	CachedMemory* pCachedMemory = NULL;
+	if (m_recording)
+	{
+		SubMapCopies::iterator iter = m_recordingSubMaps.find(&mapYaml);
+		if (iter != m_recordingSubMaps.end())
+		{
+			FreeMap(*iter->second);	// don't also cache the hex data
+			m_cache.back().memory.push_back(CachedMemory());
+			pCachedMemory = &m_cache.back().memory.back();
+			pCachedMemory->addrSpaceSize = kAddrSpaceSize;
+			pCachedMemory->offset = offset;
+		}
+		else
+		{
+			ClearCache();	// not from the current top-level map, so can't be replayed
+			m_recording = false;
+		}
+	}
+
 	UINT bytes = 0;
 
 	for (MapYaml::iterator it = mapYaml.begin(); it != mapYaml.end(); ++it)
@@ -284,6 +438,7 @@ UINT YamlHelper::LoadMemory(MapYaml& mapYaml, const LPBYTE pMemBase, const size_
 			throw std::runtime_error("Memory: line address too big: " + it->first);
 
 		LPBYTE pDst = (LPBYTE) (pMemBase + addr);
+		const LPBYTE pDstStart = pDst;
 		const LPBYTE pDstEnd = (LPBYTE) (pMemBase + kAddrSpaceSize + offset);
 
 		if (it->second.subMap)
@@ -307,8 +462,22 @@ UINT YamlHelper::LoadMemory(MapYaml& mapYaml, const LPBYTE pMemBase, const size_
 			*pDst++ = (ah<<4) | al;
 			bytes++;
 		}
+
+		if (pCachedMemory && pDst != pDstStart)
+		{
+			std::vector<MemoryRun>& runs = pCachedMemory->runs;
+			if (runs.empty() || runs.back().addr + runs.back().data.size() != addr)	// lines are normally contiguous, so merge them
+			{
+				runs.push_back(MemoryRun());
+				runs.back().addr = addr;
+			}
+			runs.back().data.insert(runs.back().data.end(), pDstStart, pDst);
+		}
 	}
 
+	if (pCachedMemory)
+		pCachedMemory->bytes = bytes;
+
 	mapYaml.clear();
 
 	return bytes;
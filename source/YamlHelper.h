@@ -30,7 +30,14 @@ friend class YamlLoadHelper;	// YamlLoadHelper can access YamlHelper's private m
 
 public:
 	YamlHelper() :
-		m_hFile(NULL)
+		m_hFile(NULL),
+		m_recording(false),
+		m_replaying(false),
+		m_cacheComplete(false),
+		m_cacheFileSize(0),
+		m_cacheFileTime(0),
+		m_replayIdx(0),
+		m_replayMemoryIdx(0)
 	{
 		memset(&m_parser, 0, sizeof(m_parser));
 		memset(&m_newEvent, 0, sizeof(m_newEvent));
@@ -40,10 +47,13 @@ public:
 	~YamlHelper()
 	{
 		FinaliseParser();
+		ClearCache();
 	}
 
-	int InitParser(const char* pPathname);
+	int InitParser(const char* pPathname, const bool bCache=false);	// bCache: also cache the parsed top-level maps & decoded memory (see InitReplay())
+	bool InitReplay(const char* pPathname);	// Use the cache instead of re-parsing an unchanged file (fails if not cached)
 	void FinaliseParser();
+	void ClearCache();
 
 	UINT ParseFileHdr(const char* tag);
 
@@ -52,6 +62,7 @@ public:
 
 private:
 	void GetNextEvent();
+	int GetTopLevelMap(MapYaml& mapYaml);
 	int ParseMap(MapYaml& mapYaml);
 	std::string GetMapValue(MapYaml& mapYaml, const std::string &key, bool& bFound);
 	UINT LoadMemory(MapYaml& mapYaml, const LPBYTE pMemBase, const size_t kAddrSpaceSize, const UINT offset);
@@ -60,6 +71,10 @@ private:
 
 	void MakeAsciiToHexTable();
 
+	typedef std::map<const MapYaml*, MapYaml*> SubMapCopies;
+	static void CopyMap(MapYaml& dstMapYaml, const MapYaml& srcMapYaml, SubMapCopies* pSubMapCopies=NULL);
+	static void FreeMap(MapYaml& mapYaml);
+
 	yaml_parser_t m_parser;
 	yaml_event_t m_newEvent;
 
@@ -69,6 +84,40 @@ private:
 	char m_AsciiToHex[256];
 
 	MapYaml m_mapYaml;
+
+	// Cache of the last file's parsed top-level maps (which are consumed by loading, so each replay uses a copy)
+	// . memory maps are cached already decoded instead, in the order they were loaded, and replayed with a memcpy per run
+	struct MemoryRun
+	{
+		UINT addr;
+		std::vector<BYTE> data;
+	};
+
+	struct CachedMemory
+	{
+		size_t addrSpaceSize;
+		UINT offset;
+		UINT bytes;
+		std::vector<MemoryRun> runs;
+	};
+
+	struct CachedMap
+	{
+		std::string scalarName;
+		MapYaml mapYaml;	// minus the memory maps' hex data
+		std::vector<CachedMemory> memory;
+	};
+
+	bool m_recording;
+	bool m_replaying;
+	bool m_cacheComplete;
+	std::string m_cachePathname;
+	UINT64 m_cacheFileSize;
+	UINT64 m_cacheFileTime;
+	std::vector<CachedMap> m_cache;
+	SubMapCopies m_recordingSubMaps;	// the current top-level map's sub-maps -> their copies in the cache
+	size_t m_replayIdx;
+	size_t m_replayMemoryIdx;
 };
 
 // -----
@@ -84,7 +133,7 @@ public:
 		  m_currentMapName(m_topLevelMapName),
 		  m_bIteratingOverMap(false)
 	{
-		if (!m_yamlHelper.ParseMap(yamlHelper.m_mapYaml))
+		if (!m_yamlHelper.GetTopLevelMap(yamlHelper.m_mapYaml))
 		{
 			m_bDoGetMapRemainder = false;
 			throw std::runtime_error(m_currentMapName + ": Failed to parse map");
@@ -26,6 +26,7 @@
 
 #include "../StdAfx.h"
 
+#include "../Core.h"
 #include "../CPU.h"
 #include "../Memory.h"
 #include "../YamlHelper.h"
@@ -125,6 +126,93 @@ void z80_reset()
     return z80mem_read_limit_tab_ptr[addr >> 8];
 }
 
+/* ------------------------------------------------------------------------- */
+
+// [AppleWin-TC] Page table for the SoftCard's Z80 address space
+// . Each Z80 page maps directly to a 6502 page, so for RAM (and ROM) reads & RAM writes, then there's no need
+//   for the address translation, the g_nAppMode check & the T-states to 6502 cycles conversion on every byte.
+// . NULL entries take the slow path: I/O ($E000-EFFF = 6502 $C000-CFFF), $D800-DFFF (= 6502 $F800-FFFF, for IO_F8xx()),
+//   writes to ROM, VidHD aux writes, and everything when not in MODE_RUNNING (ie. for the debugger's heatmap).
+// . Rebuilt when the 6502 paging changes, which (for the Z80) can only occur from a slow path access, or between z80_mainloop() calls.
+
+static BYTE z80_apple_page[0x100];		// Z80 page -> 6502 page
+static BYTE *z80_read_page[0x100];		// Z80 page -> mem (or NULL)
+static BYTE *z80_write_page[0x100];		// Z80 page -> memwrite[] (or NULL)
+static UINT z80_paging_generation = 0;
+static LPBYTE z80_mem_vidhd = NULL;
+static bool z80_page_table_valid = false;
+
+static WORD z80_ConvertAddress(WORD Addr)
+{
+	switch (Addr / 0x1000)
+	{
+		default:	// $0000-AFFF
+			return Addr + 0x1000;
+		case 0xB:
+		case 0xC:
+		case 0xD:
+			return Addr + 0x2000;
+		case 0xE:
+			return Addr - 0x2000;	// I/O: $C000-CFFF
+		case 0xF:
+			return Addr - 0xF000;
+	}
+}
+
+static void z80_BuildPageTable()
+{
+	const bool running = (g_nAppMode == MODE_RUNNING) && GetIsMemCacheValid();
+
+	for (UINT page = 0; page < 0x100; page++)
+	{
+		const WORD addr = z80_ConvertAddress((WORD)(page << 8));
+		const BYTE applePage = (BYTE)(addr >> 8);
+		z80_apple_page[page] = applePage;
+
+		const bool slow = !running
+			|| (addr & 0xF000) == APPLE_IO_BEGIN	// I/O
+			|| addr >= 0xF800;						// IO_F8xx()
+
+		z80_read_page[page] = slow ? NULL : mem + (applePage << 8);
+		z80_write_page[page] = (slow || memVidHD) ? NULL : memwrite[applePage];
+	}
+
+	z80_paging_generation = MemGetPagingGeneration();
+	z80_mem_vidhd = memVidHD;
+	z80_page_table_valid = true;
+}
+
+// Called after any slow path access (eg. an I/O access may have changed the paging)
+static void z80_UpdatePageTable()
+{
+	if (!z80_page_table_valid
+		|| z80_paging_generation != MemGetPagingGeneration()
+		|| z80_mem_vidhd != memVidHD)
+		z80_BuildPageTable();
+}
+
+inline static BYTE z80_load(WORD addr)
+{
+	const BYTE *page = z80_read_page[addr >> 8];
+	if (page)
+		return page[addr & 0xff];
+
+	return z80_RDMEM(addr);
+}
+
+inline static void z80_store(WORD addr, BYTE value)
+{
+	BYTE *page = z80_write_page[addr >> 8];
+	if (page)
+	{
+		memdirty[z80_apple_page[addr >> 8]] = 0xFF;
+		page[addr & 0xff] = value;
+		return;
+	}
+
+	z80_WRMEM(addr, value);
+}
+
 #define JUMP(addr)                                    \
    do {                                               \
      z80_reg_pc = (addr);                             \
@@ -134,11 +222,12 @@ void z80_reset()
    } while (0)
 
 
+// [AppleWin-TC] Page table fast path (see z80_UpdatePageTable()), else z80_RDMEM() & z80_WRMEM()
 #define LOAD(addr) \
-    (*_z80mem_read_tab_ptr[(addr) >> 8])((WORD)(addr))
+    z80_load((WORD)(addr))
 
 #define STORE(addr, value) \
-    (*_z80mem_write_tab_ptr[(addr) >> 8])((WORD)(addr), (BYTE)(value))
+    z80_store((WORD)(addr), (BYTE)(value))
 
 #define IN(addr) \
     (io_read_tab[(addr) >> 8])((WORD)(addr))
@@ -5535,6 +5624,8 @@ DWORD z80_mainloop(ULONG uTotalCycles, ULONG uExecutedCycles)
 	uExecutedCycles = (ULONG) ((double)uExecutedCycles * uZ80ClockMultiplier);
 	maincpu_clk = uExecutedCycles;	// Must be signed int, as cycles can go -ve
 
+	z80_BuildPageTable();			// [AppleWin-TC] g_nAppMode or the 6502 paging may have changed since the last call
+
     do {
 
 		// [AppleWin-TC] Z80 IRQs not supported
@@ -6357,43 +6448,18 @@ DWORD z80_mainloop(ULONG uTotalCycles, ULONG uExecutedCycles)
 /****************************************************************************/
 BYTE z80_RDMEM(WORD Addr)
 {
-	WORD addr;
-
-	switch (Addr / 0x1000)
-	{
-		case 0x0:
-		case 0x1:
-		case 0x2:
-		case 0x3:
-		case 0x4:
-		case 0x5:
-		case 0x6:
-		case 0x7:
-		case 0x8:
-		case 0x9:
-		case 0xA:
-			addr = (WORD)Addr + 0x1000;
-			return CpuRead( addr, ConvertZ80TStatesTo6502Cycles(maincpu_clk) );
-		break;
-
-		case 0xB:
-		case 0xC:
-		case 0xD:
-			addr = (WORD)Addr + 0x2000;
-			return CpuRead( addr, ConvertZ80TStatesTo6502Cycles(maincpu_clk) );
-		break;
-
-		case 0xE:
-			addr = (WORD)Addr - 0x2000;
-			return IORead[(addr>>4) & 0xFF]( regs.pc, addr, 0, 0, ConvertZ80TStatesTo6502Cycles(maincpu_clk) ); // Maps to 6502 I/O address range: $C000..CFFF
-		break;
-
-		case 0xF:
-			addr = (WORD)Addr - 0xF000;
-			return CpuRead( addr, ConvertZ80TStatesTo6502Cycles(maincpu_clk) );
-		break;
-	}
-	return 255;
+	// NB. Only called for the slow path (ie. not via the page table)
+	const WORD addr = z80_ConvertAddress(Addr);
+	const ULONG uExecutedCycles = ConvertZ80TStatesTo6502Cycles(maincpu_clk);
+	BYTE value;
+
+	if ((addr & 0xF000) == APPLE_IO_BEGIN)
+		value = IORead[(addr>>4) & 0xFF]( regs.pc, addr, 0, 0, uExecutedCycles ); // Maps to 6502 I/O address range: $C000..CFFF
+	else
+		value = CpuRead( addr, uExecutedCycles );
+
+	z80_UpdatePageTable();
+	return value;
 }
 
 /****************************************************************************/
@@ -6401,30 +6467,9 @@ BYTE z80_RDMEM(WORD Addr)
 /****************************************************************************/
 void z80_WRMEM(WORD Addr, BYTE Value)
 {
-	unsigned int laddr;
-	WORD addr;
-
-	laddr = Addr & 0x0FFF;
-	switch (Addr & 0xF000)
-	{
-		case 0x0000: addr = laddr+0x1000; break;
-		case 0x1000: addr = laddr+0x2000; break;
-		case 0x2000: addr = laddr+0x3000; break;
-		case 0x3000: addr = laddr+0x4000; break;
-		case 0x4000: addr = laddr+0x5000; break;
-		case 0x5000: addr = laddr+0x6000; break;
-		case 0x6000: addr = laddr+0x7000; break;
-		case 0x7000: addr = laddr+0x8000; break;
-		case 0x8000: addr = laddr+0x9000; break;
-		case 0x9000: addr = laddr+0xA000; break;
-		case 0xA000: addr = laddr+0xB000; break;
-		case 0xB000: addr = laddr+0xD000; break;
-		case 0xC000: addr = laddr+0xE000; break;
-		case 0xD000: addr = laddr+0xF000; break;
-		case 0xE000: addr = laddr+0xC000; break;
-		case 0xF000: addr = laddr+0x0000; break;
-	}
-	CpuWrite( addr, Value, ConvertZ80TStatesTo6502Cycles(maincpu_clk) );
+	// NB. Only called for the slow path (ie. not via the page table)
+	CpuWrite( z80_ConvertAddress(Addr), Value, ConvertZ80TStatesTo6502Cycles(maincpu_clk) );
+	z80_UpdatePageTable();
 }
 
 //===========================================================================
@@ -46,6 +46,8 @@ bool g_irqOnLastOpcodeCycle = false;
 
 static eCpuType g_ActiveCPU = CPU_65C02;
 
+static volatile UINT32 g_bmCpuAttention = 0;	// Never any interrupts or Z80
+
 eCpuType GetActiveCpu()
 {
 	return g_ActiveCPU;
@@ -5,6 +5,7 @@
 
 #include "../../source/Debugger/Debugger_Types.h"
 #include "../../source/Debugger/Debugger_Assembler.h"	// Pull in default args for _6502_GetTargets()
+#include "../../source/Debugger/Debugger_MemorySearch.h"
 
 // From FrameBase
 class FrameBase
@@ -709,6 +710,216 @@ int GH451_test()
 
 //-------------------------------------
 
+static void MemorySearch_Add(MemorySearchValues_t& values, MemorySearch_e type, BYTE value = 0)
+{
+	MemorySearch_t ms;
+	ms.m_nValue = value;
+	ms.m_iType = type;
+	ms.m_bFound = false;
+	values.push_back(ms);
+}
+
+// Find segment: match must start in [pBegin, pLastStart] and end before pBufferEnd
+int MemorySearch_test_segment()
+{
+	const BYTE buffer[8] = { 0x00, 0xA9, 0x01, 0x00, 0xA9, 0x02, 0xA9, 0x03 };
+
+	MemorySearchValues_t values;
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0xA9);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_1_WILD);
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile(values, pattern);
+	if (pattern.size() != 1 || pattern[0].iFirstExact != 0) return 1;
+
+	const BYTE* pEnd = &buffer[8];
+	if (_SearchMemoryFindSegment(&buffer[0], &buffer[7], pEnd, pattern[0]) != &buffer[1]) return 1;
+	if (_SearchMemoryFindSegment(&buffer[2], &buffer[7], pEnd, pattern[0]) != &buffer[4]) return 1;
+	if (_SearchMemoryFindSegment(&buffer[2], &buffer[3], pEnd, pattern[0]) != NULL) return 1;	// $A9 at [4] starts after pLastStart
+	if (_SearchMemoryFindSegment(&buffer[5], &buffer[7], pEnd, pattern[0]) != &buffer[6]) return 1;
+
+	// [7] would need the wildcard byte beyond pBufferEnd
+	const BYTE* pShortEnd = &buffer[7];
+	if (_SearchMemoryFindSegment(&buffer[5], &buffer[7], pShortEnd, pattern[0]) != NULL) return 1;
+
+	return 0;
+}
+
+// "??" splits the pattern into segments, and a match can span any number of bytes between them
+int MemorySearch_test_multi_segment()
+{
+	BYTE buffer[0x100];
+	memset(buffer, 0x00, sizeof(buffer));
+	buffer[0x10] = 0x20;	// JSR $FDED
+	buffer[0x11] = 0xED;
+	buffer[0x12] = 0xFD;
+	buffer[0x80] = 0x60;	// RTS
+
+	MemorySearchValues_t values;
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_N_WILD);	// leading "??" is dropped
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x20);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_N_WILD);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_N_WILD);	// repeated "??" is dropped
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x60);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_N_WILD);	// trailing "??" is dropped
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile(values, pattern);
+	if (pattern.size() != 2) return 1;
+	if (pattern[0].vMask.size() != 1 || pattern[1].vMask.size() != 1) return 1;
+
+	AddressPrefix_t addrPrefix;
+	MemorySearchResults_t results;
+	int nFound = _SearchMemoryBlock(pattern, buffer, 0x2000, sizeof(buffer), 0x0000, 0xFFFF, addrPrefix, results);
+	if (nFound != 1 || results.size() != 1) return 1;
+	if (results[0].m_nAddress != 0x2010) return 1;
+
+	// Second segment is before the first: no match
+	buffer[0x80] = 0x00;
+	buffer[0x08] = 0x60;
+	results.clear();
+	nFound = _SearchMemoryBlock(pattern, buffer, 0x2000, sizeof(buffer), 0x0000, 0xFFFF, addrPrefix, results);
+	if (nFound != 0 || !results.empty()) return 1;
+
+	return 0;
+}
+
+// A match only has to start in [nAddressStart, nAddressEnd], but it must fit in the block
+int MemorySearch_test_range()
+{
+	BYTE buffer[0x100];
+	memset(buffer, 0x00, sizeof(buffer));
+	buffer[0x40] = 0x4C; buffer[0x41] = 0x00; buffer[0x42] = 0x03;	// JMP $0300
+	buffer[0x41+0x10] = 0x4C; buffer[0x42+0x10] = 0x00; buffer[0x43+0x10] = 0x03;
+	buffer[0xFE] = 0x4C; buffer[0xFF] = 0x00;	// truncated by end of block
+
+	MemorySearchValues_t values;
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x4C);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x00);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x03);
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile(values, pattern);
+
+	AddressPrefix_t addrPrefix;
+	MemorySearchResults_t results;
+
+	// Match at $1040 runs past nAddressEnd=$1040
+	int nFound = _SearchMemoryBlock(pattern, buffer, 0x1000, sizeof(buffer), 0x1000, 0x1040, addrPrefix, results);
+	if (nFound != 1 || results[0].m_nAddress != 0x1040) return 1;
+
+	// Match at $1040 starts before nAddressStart
+	results.clear();
+	nFound = _SearchMemoryBlock(pattern, buffer, 0x1000, sizeof(buffer), 0x1041, 0x10FF, addrPrefix, results);
+	if (nFound != 1 || results[0].m_nAddress != 0x1051) return 1;
+
+	// Match at $10FE would run past the end of the block
+	results.clear();
+	nFound = _SearchMemoryBlock(pattern, buffer, 0x1000, sizeof(buffer), 0x1060, 0xFFFF, addrPrefix, results);
+	if (nFound != 0) return 1;
+
+	// Range doesn't overlap the block
+	results.clear();
+	nFound = _SearchMemoryBlock(pattern, buffer, 0x1000, sizeof(buffer), 0x2000, 0x2FFF, addrPrefix, results);
+	if (nFound != 0) return 1;
+
+	return 0;
+}
+
+// Nibble and single byte wildcards, including a segment with no exact byte
+int MemorySearch_test_wildcard()
+{
+	BYTE buffer[0x20];
+	memset(buffer, 0xFF, sizeof(buffer));
+	buffer[0x04] = 0x31; buffer[0x05] = 0x99; buffer[0x06] = 0xC7;	// match
+	buffer[0x10] = 0x32; buffer[0x11] = 0x99; buffer[0x12] = 0xC7;	// low nibble differs
+	buffer[0x18] = 0x01; buffer[0x19] = 0x00; buffer[0x1A] = 0xC0;	// match
+
+	MemorySearchValues_t values;
+	MemorySearch_Add(values, MEM_SEARCH_NIB_LOW_EXACT, 0x01);	// ?1
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_1_WILD);			// ?
+	MemorySearch_Add(values, MEM_SEARCH_NIB_HIGH_EXACT, 0xC0);	// C?
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile(values, pattern);
+	if (pattern.size() != 1 || pattern[0].iFirstExact != -1) return 1;
+
+	AddressPrefix_t addrPrefix;
+	MemorySearchResults_t results;
+	int nFound = _SearchMemoryBlock(pattern, buffer, 0x0800, sizeof(buffer), 0x0000, 0xFFFF, addrPrefix, results);
+	if (nFound != 2 || results.size() != 2) return 1;
+	if (results[0].m_nAddress != 0x0804 || results[1].m_nAddress != 0x0818) return 1;
+
+	// Exact byte after a wildcard: memchr() prefilter is offset into the segment
+	values.clear();
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_1_WILD);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x99);
+	_SearchMemoryCompile(values, pattern);
+	if (pattern.size() != 1 || pattern[0].iFirstExact != 1) return 1;
+
+	results.clear();
+	nFound = _SearchMemoryBlock(pattern, buffer, 0x0800, sizeof(buffer), 0x0000, 0xFFFF, addrPrefix, results);
+	if (nFound != 2 || results[0].m_nAddress != 0x0804 || results[1].m_nAddress != 0x0810) return 1;
+
+	return 0;
+}
+
+// Each bank is searched as its own block, and results are tagged with the bank's prefix
+int MemorySearch_test_bank()
+{
+	BYTE bank0[0x100], bank1[0x100];
+	memset(bank0, 0x00, sizeof(bank0));
+	memset(bank1, 0x00, sizeof(bank1));
+	bank0[0xFF] = 0xEA;		// pattern straddles the end of bank0 and start of bank1: not a match
+	bank1[0x00] = 0x60;
+	bank1[0x20] = 0xEA;
+	bank1[0x21] = 0x60;
+
+	MemorySearchValues_t values;
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0xEA);
+	MemorySearch_Add(values, MEM_SEARCH_BYTE_EXACT, 0x60);
+
+	MemorySearchPattern_t pattern;
+	_SearchMemoryCompile(values, pattern);
+
+	AddressPrefix_t addrPrefix0;
+	addrPrefix0.nBank = 0;
+	AddressPrefix_t addrPrefix1;
+	addrPrefix1.nBank = 1;
+
+	MemorySearchResults_t results;
+	int nFound = _SearchMemoryBlock(pattern, bank0, 0x4000, sizeof(bank0), 0x0000, 0xFFFF, addrPrefix0, results);
+	nFound += _SearchMemoryBlock(pattern, bank1, 0x4000, sizeof(bank1), 0x0000, 0xFFFF, addrPrefix1, results);
+	if (nFound != 1 || results.size() != 1) return 1;
+	if (results[0].m_nAddress != 0x4020 || results[0].m_addrPrefix.nBank != 1) return 1;
+
+	return 0;
+}
+
+// debugger command 's' and 'sall': bank-aware memory search engine
+int MemorySearch_test()
+{
+	int res;
+
+	res = MemorySearch_test_segment();
+	if (res) return res;
+
+	res = MemorySearch_test_multi_segment();
+	if (res) return res;
+
+	res = MemorySearch_test_range();
+	if (res) return res;
+
+	res = MemorySearch_test_wildcard();
+	if (res) return res;
+
+	res = MemorySearch_test_bank();
+
+	return res;
+}
+
+//-------------------------------------
+
 int main(int argc, char* argv[])
 {
 	int res = 1;
@@ -721,5 +932,8 @@ int main(int argc, char* argv[])
 	res = GH451_test();
 	if (res) return res;
 
+	res = MemorySearch_test();
+	if (res) return res;
+
 	return 0;
 }